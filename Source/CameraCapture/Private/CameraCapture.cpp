@@ -1,12 +1,35 @@
 // Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
 
 #include "CameraCapture.h"
+#include "CameraCaptureStats.h"
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 #include "ShaderCore.h"
 
 #define LOCTEXT_NAMESPACE "FCameraCaptureModule"
 
+DEFINE_STAT(STAT_CameraCapture_Kick);
+DEFINE_STAT(STAT_CameraCapture_BuildMetadata);
+DEFINE_STAT(STAT_CameraCapture_EnqueueReadback);
+DEFINE_STAT(STAT_CameraCapture_PollReadbacks);
+DEFINE_STAT(STAT_CameraCapture_Broadcast);
+DEFINE_STAT(STAT_CameraCapture_HarvestRgb);
+DEFINE_STAT(STAT_CameraCapture_HarvestDmv);
+DEFINE_STAT(STAT_CameraCapture_ExrPack);
+DEFINE_STAT(STAT_CameraCapture_ExrEnqueue);
+DEFINE_STAT(STAT_CameraCapture_JsonWrite);
+DEFINE_STAT(STAT_CameraCapture_FileIO);
+DEFINE_STAT(STAT_CameraCapture_PendingCaptures);
+DEFINE_STAT(STAT_CameraCapture_SerializationBacklog);
+DEFINE_STAT(STAT_CameraCapture_PooledRenderTargetMemory);
+DEFINE_STAT(STAT_CameraCapture_PooledPixelBufferMemory);
+DEFINE_STAT(STAT_CameraCapture_OutstandingPixelBufferMemory);
+DEFINE_STAT(STAT_CameraCapture_ReservedMemory);
+DEFINE_STAT(STAT_CameraCapture_QueuedForWriteMemory);
+DEFINE_STAT(STAT_CameraCapture_EncodingMemory);
+
+UE_TRACE_CHANNEL_DEFINE(CameraCaptureChannel);
+
 void FCameraCaptureModule::StartupModule()
 {
 	// Register the plugin's Shaders/ directory as a virtual shader include path.
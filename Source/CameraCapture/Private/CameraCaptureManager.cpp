@@ -3,10 +3,19 @@
 #include "IntrinsicSceneCaptureComponent2D.h"
 #include "Engine/World.h"
 #include "EngineUtils.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/SceneCaptureComponent.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectIterator.h"
 
 ACameraCaptureManager::ACameraCaptureManager()
 {
-	PrimaryActorTick.bCanEverTick = false;
+	// Only ticks while replaying a trajectory
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	// Make this actor visible in editor
 	bIsEditorOnlyActor = false;
@@ -38,7 +47,26 @@ void ACameraCaptureManager::BeginPlay()
 	// Configure subsystem
 	CachedSubsystem->SetOutputDirectory(OutputDirectory);
 	CachedSubsystem->SetCaptureRate(CaptureEveryNFrames);
+	CachedSubsystem->SetThrottleLimits(MaxInFlightFramesPerCamera, MaxSerializationBacklog);
+	CachedSubsystem->SetGpuGovernor(bEnableGpuGovernor, TargetFrameTimeMs);
+	CachedSubsystem->SetOfflineMode(bOfflineFixedStep, FixedTimeStepSeconds, MaxQueuedFrames, RandomSeed);
 	CachedSubsystem->SetCaptureChannels(bCaptureRGB, bCaptureDepth, bCaptureMotionVectors);
+	CachedSubsystem->SetResourceSetupBudget(ResourceSetupBudgetMs);
+	CachedSubsystem->SetRenderTargetPooling(bPoolRenderTargets);
+	CachedSubsystem->SetPixelBufferPooling(bPoolPixelBuffers, MaxPooledPixelBufferMB);
+	CachedSubsystem->SetMemoryBudget(MemoryBudgetMB, MemoryOverflowPolicy);
+	CachedSubsystem->SetReadbackTimeout(ReadbackTimeoutMs);
+	CachedSubsystem->SetWaitForReadbacksOnStop(bWaitForReadbacksOnStop);
+	CachedSubsystem->SetRenderThreadHarvest(bHarvestOnRenderThread);
+	CachedSubsystem->SetParallelHarvest(bParallelHarvest);
+	CachedSubsystem->SetBroadcastUnchangedFrames(bBroadcastUnchangedFrames);
+	CachedSubsystem->SetFrameSetAssembly(bAssembleFrameSets, FrameSetPolicy, FrameSetTimeoutMs, bBatchFrameSetSerialization);
+	if (bExportMetrics) // Otherwise leave any -CameraCaptureMetricsFile export running
+	{
+		CachedSubsystem->SetMetricsExport(true, MetricsFilePath, MetricsExportIntervalSeconds);
+	}
+	CachedSubsystem->SetTimelineRecording(bRecordTimeline, TimelineFilePath);
+	CachedSubsystem->SetPoseRecording(CaptureMode == ECaptureDriveMode::RecordPoses, GetTrajectoryFilePath());
 
 	// Auto-configure cameras if enabled
 	if (bAutoConfigureCamerasOnBeginPlay)
@@ -46,6 +74,11 @@ void ACameraCaptureManager::BeginPlay()
 		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureManager] Auto-configuring cameras..."));
 		RegisterCameras();
 		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureManager] Cameras registered: %d"), GetRegisteredCameraCount());
+
+		if (RegistrationMode == ECameraRegistrationMode::AllInLevel && bDiscoverCamerasAtRuntime)
+		{
+			StartCameraDiscovery();
+		}
 	}
 	else
 	{
@@ -54,8 +87,27 @@ void ACameraCaptureManager::BeginPlay()
 
 	bInitialized = true;
 
+	// Replay drives capture itself, one recorded frame per tick
+	if (CaptureMode == ECaptureDriveMode::ReplayTrajectory)
+	{
+		CachedSubsystem->SetSerializationEnabled(true);
+		if (bPrewarmBeforeCapture)
+		{
+			CachedSubsystem->PrewarmCapture();
+		}
+		StartReplay();
+	}
+	else if (CaptureMode == ECaptureDriveMode::PoseList)
+	{
+		CachedSubsystem->SetSerializationEnabled(true);
+		if (bPrewarmBeforeCapture)
+		{
+			CachedSubsystem->PrewarmCapture();
+		}
+		StartPoseList();
+	}
 	// Auto-start capture if configured
-	if (bAutoStartCaptureOnBeginPlay)
+	else if (bAutoStartCaptureOnBeginPlay)
 	{
 		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureManager] Auto-starting capture..."));
 
@@ -77,8 +129,11 @@ void ACameraCaptureManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	{
 		StopCapture();
 	}
+	StopReplay();
+	bRunningPoseList = false;
 
 	// Unregister cameras
+	StopCameraDiscovery();
 	UnregisterAllCameras();
 
 	CachedSubsystem = nullptr;
@@ -110,15 +165,92 @@ void ACameraCaptureManager::PostEditChangeProperty(FPropertyChangedEvent& Proper
 		{
 			CachedSubsystem->SetCaptureRate(CaptureEveryNFrames);
 		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, MaxInFlightFramesPerCamera) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, MaxSerializationBacklog))
+		{
+			CachedSubsystem->SetThrottleLimits(MaxInFlightFramesPerCamera, MaxSerializationBacklog);
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bEnableGpuGovernor) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, TargetFrameTimeMs))
+		{
+			CachedSubsystem->SetGpuGovernor(bEnableGpuGovernor, TargetFrameTimeMs);
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bOfflineFixedStep) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, FixedTimeStepSeconds) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, MaxQueuedFrames) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, RandomSeed))
+		{
+			CachedSubsystem->SetOfflineMode(bOfflineFixedStep, FixedTimeStepSeconds, MaxQueuedFrames, RandomSeed);
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, CaptureMode) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, TrajectoryFile))
+		{
+			CachedSubsystem->SetPoseRecording(CaptureMode == ECaptureDriveMode::RecordPoses, GetTrajectoryFilePath());
+		}
 		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bCaptureRGB) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bCaptureDepth) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bCaptureMotionVectors))
 		{
 			CachedSubsystem->SetCaptureChannels(bCaptureRGB, bCaptureDepth, bCaptureMotionVectors);
 		}
-		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, RegistrationMode) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, CamerasToCapture))
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, ResourceSetupBudgetMs))
+		{
+			CachedSubsystem->SetResourceSetupBudget(ResourceSetupBudgetMs);
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bPoolRenderTargets))
+		{
+			CachedSubsystem->SetRenderTargetPooling(bPoolRenderTargets);
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bPoolPixelBuffers) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, MaxPooledPixelBufferMB))
+		{
+			CachedSubsystem->SetPixelBufferPooling(bPoolPixelBuffers, MaxPooledPixelBufferMB);
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, MemoryBudgetMB) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, MemoryOverflowPolicy))
+		{
+			CachedSubsystem->SetMemoryBudget(MemoryBudgetMB, MemoryOverflowPolicy);
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, ReadbackTimeoutMs))
+		{
+			CachedSubsystem->SetReadbackTimeout(ReadbackTimeoutMs);
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bWaitForReadbacksOnStop))
+		{
+			CachedSubsystem->SetWaitForReadbacksOnStop(bWaitForReadbacksOnStop);
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bHarvestOnRenderThread))
+		{
+			CachedSubsystem->SetRenderThreadHarvest(bHarvestOnRenderThread);
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bParallelHarvest))
+		{
+			CachedSubsystem->SetParallelHarvest(bParallelHarvest);
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bBroadcastUnchangedFrames))
+		{
+			CachedSubsystem->SetBroadcastUnchangedFrames(bBroadcastUnchangedFrames);
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bAssembleFrameSets) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, FrameSetPolicy) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, FrameSetTimeoutMs) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bBatchFrameSetSerialization))
+		{
+			CachedSubsystem->SetFrameSetAssembly(bAssembleFrameSets, FrameSetPolicy, FrameSetTimeoutMs, bBatchFrameSetSerialization);
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bExportMetrics) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, MetricsFilePath) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, MetricsExportIntervalSeconds))
+		{
+			if (bExportMetrics)
+			{
+				CachedSubsystem->SetMetricsExport(true, MetricsFilePath, MetricsExportIntervalSeconds);
+			}
+			else
+			{
+				CachedSubsystem->RestoreCommandLineMetricsExport();
+			}
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bRecordTimeline) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, TimelineFilePath))
+		{
+			CachedSubsystem->SetTimelineRecording(bRecordTimeline, TimelineFilePath);
+		}
+		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, RegistrationMode) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, CamerasToCapture) || PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bDiscoverCamerasAtRuntime))
 		{
 			// Re-register cameras when mode or list changes
+			StopCameraDiscovery();
 			UnregisterAllCameras();
 			RegisterCameras();
+			if (RegistrationMode == ECameraRegistrationMode::AllInLevel && bDiscoverCamerasAtRuntime)
+			{
+				StartCameraDiscovery();
+			}
+			UpdateTickEnabled();
 		}
 		else if (PropertyName == GET_MEMBER_NAME_CHECKED(ACameraCaptureManager, bAutoStartSerializationOnBeginPlay))
 		{
@@ -138,6 +270,11 @@ void ACameraCaptureManager::StartCapture()
 	UCameraCaptureSubsystem* Subsystem = GetCaptureSubsystem();
 	if (Subsystem)
 	{
+		// Pose-only recording renders nothing, so there is nothing to warm up
+		if (bPrewarmBeforeCapture && CaptureMode != ECaptureDriveMode::RecordPoses)
+		{
+			Subsystem->PrewarmCapture();
+		}
 		Subsystem->StartCapture();
 		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureManager] Started capture"));
 	}
@@ -201,6 +338,413 @@ bool ACameraCaptureManager::IsSerializationEnabled() const
 	return Subsystem ? Subsystem->IsSerializationEnabled() : false;
 }
 
+// ============================================================================
+// Trajectory Replay
+// ============================================================================
+
+bool ACameraCaptureManager::StartReplay()
+{
+	UCameraCaptureSubsystem* Subsystem = GetCaptureSubsystem();
+	UWorld*					 World = GetWorld();
+	if (!Subsystem || !World)
+	{
+		return false;
+	}
+
+	const FString FilePath = GetTrajectoryFilePath();
+	if (!ReplayTrajectory.LoadFromFile(FilePath))
+	{
+		return false;
+	}
+
+	// Cameras must already be registered (same level, same unique IDs as the recording)
+	ReplayCameras.Reset();
+	for (const FString& CameraID : ReplayTrajectory.CameraIDs)
+	{
+		UIntrinsicSceneCaptureComponent2D* Camera = Subsystem->FindCameraByID(CameraID);
+		if (!Camera)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureManager] Replay: camera %s is not registered, its frames will be skipped"), *CameraID);
+		}
+		ReplayCameras.Add(Camera);
+	}
+
+	// Actors and skeletal meshes are matched by path with the PIE prefix stripped on both sides
+	TMap<FString, AActor*>					ActorsByPath;
+	TMap<FString, USkeletalMeshComponent*> SkeletalMeshesByPath;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		ActorsByPath.Add(UWorld::RemovePIEPrefix(It->GetPathName()), *It);
+		It->ForEachComponent<USkeletalMeshComponent>(false, [&SkeletalMeshesByPath](USkeletalMeshComponent* Mesh) {
+			SkeletalMeshesByPath.Add(UWorld::RemovePIEPrefix(Mesh->GetPathName()), Mesh);
+		});
+	}
+
+	ReplayActors.Reset();
+	for (const FString& ActorPath : ReplayTrajectory.ActorPaths)
+	{
+		AActor* Actor = ActorsByPath.FindRef(ActorPath);
+		if (!Actor)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureManager] Replay: actor %s not found, its poses will be ignored"), *ActorPath);
+		}
+		ReplayActors.Add(Actor);
+		FreezeReplayedActor(Actor);
+	}
+
+	ReplaySkeletalMeshes.Reset();
+	for (const FString& ComponentPath : ReplayTrajectory.SkeletalMeshPaths)
+	{
+		USkeletalMeshComponent* Mesh = SkeletalMeshesByPath.FindRef(ComponentPath);
+		if (!Mesh)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureManager] Replay: skeletal mesh %s not found, its bone poses will be ignored"), *ComponentPath);
+		}
+		ReplaySkeletalMeshes.Add(Mesh);
+		FreezeReplayedActor(Mesh ? Mesh->GetOwner() : nullptr);
+	}
+
+	// Time-range shards replay a contiguous block of frames
+	Subsystem->GetShardRange(ReplayTrajectory.Frames.Num(), ReplayFrameIndex, ReplayEndIndex);
+
+	// Actor poses are deltas, so bring the scene to the state before the block,
+	// and render the preceding frame so motion vectors match a single-process run
+	for (int32 FrameIndex = 0; FrameIndex < ReplayFrameIndex; ++FrameIndex)
+	{
+		TArray<UIntrinsicSceneCaptureComponent2D*> FrameCameras;
+		ApplyReplayFrame(ReplayTrajectory.Frames[FrameIndex], FrameCameras);
+		if (FrameIndex == ReplayFrameIndex - 1)
+		{
+			Subsystem->PrimeCaptureHistory(FrameCameras);
+		}
+	}
+
+	bReplaying = true;
+	UpdateTickEnabled();
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureManager] Replaying frames %d-%d of %d from %s"),
+		ReplayFrameIndex, ReplayEndIndex - 1, ReplayTrajectory.Frames.Num(), *FilePath);
+	return true;
+}
+
+void ACameraCaptureManager::StopReplay()
+{
+	if (!bReplaying)
+	{
+		return;
+	}
+
+	bReplaying = false;
+	UpdateTickEnabled();
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureManager] Replay stopped after %d of %d frames"), ReplayFrameIndex, ReplayTrajectory.Frames.Num());
+
+	UnfreezeReplayedActors();
+
+	ReplayTrajectory = FCaptureTrajectory();
+	ReplayCameras.Reset();
+	ReplayActors.Reset();
+	ReplaySkeletalMeshes.Reset();
+}
+
+void ACameraCaptureManager::FreezeReplayedActor(AActor* Actor)
+{
+	if (!Actor || Actor == this || FrozenReplayActors.Contains(Actor))
+	{
+		return;
+	}
+	FrozenReplayActors.Add(Actor);
+
+	// Recorded poses are the only thing that may move a replayed actor: its tick, its
+	// components' ticks (movement, animation) and physics would otherwise fight them
+	if (Actor->IsActorTickEnabled())
+	{
+		Actor->SetActorTickEnabled(false);
+		FrozenTickActors.Add(Actor);
+	}
+
+	Actor->ForEachComponent<UActorComponent>(false, [this](UActorComponent* Component) {
+		// Capture components are driven by the subsystem, not by their own tick
+		if (Component->IsA<USceneCaptureComponent>())
+		{
+			return;
+		}
+
+		if (Component->IsComponentTickEnabled())
+		{
+			Component->SetComponentTickEnabled(false);
+			FrozenTickComponents.Add(Component);
+		}
+
+		UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Component);
+		if (Primitive && Primitive->IsSimulatingPhysics())
+		{
+			Primitive->SetSimulatePhysics(false);
+			FrozenPhysicsComponents.Add(Primitive);
+		}
+	});
+
+	// AI drives pawns through its controller (behavior trees, path following)
+	if (APawn* Pawn = Cast<APawn>(Actor))
+	{
+		if (!Pawn->IsPlayerControlled())
+		{
+			FreezeReplayedActor(Pawn->GetController());
+		}
+	}
+}
+
+void ACameraCaptureManager::UnfreezeReplayedActors()
+{
+	for (const TWeakObjectPtr<AActor>& Actor : FrozenTickActors)
+	{
+		if (Actor.IsValid())
+		{
+			Actor->SetActorTickEnabled(true);
+		}
+	}
+
+	for (const TWeakObjectPtr<UActorComponent>& Component : FrozenTickComponents)
+	{
+		if (Component.IsValid())
+		{
+			Component->SetComponentTickEnabled(true);
+		}
+	}
+
+	for (const TWeakObjectPtr<UPrimitiveComponent>& Primitive : FrozenPhysicsComponents)
+	{
+		if (Primitive.IsValid())
+		{
+			Primitive->SetSimulatePhysics(true);
+		}
+	}
+
+	FrozenReplayActors.Reset();
+	FrozenTickActors.Reset();
+	FrozenTickComponents.Reset();
+	FrozenPhysicsComponents.Reset();
+}
+
+void ACameraCaptureManager::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	ProcessPendingRegistrations();
+
+	if (bReplaying)
+	{
+		ReplayNextFrame();
+	}
+	else if (bRunningPoseList)
+	{
+		CaptureNextPoses();
+	}
+}
+
+void ACameraCaptureManager::ReplayNextFrame()
+{
+	UCameraCaptureSubsystem* Subsystem = GetCaptureSubsystem();
+	if (!Subsystem)
+	{
+		StopReplay();
+		return;
+	}
+
+	if (ReplayFrameIndex >= ReplayEndIndex)
+	{
+		if (Subsystem->IsShardConfigured())
+		{
+			Subsystem->WriteShardManifest();
+		}
+		StopReplay();
+		return;
+	}
+
+	const FCaptureTrajectoryFrame& Frame = ReplayTrajectory.Frames[ReplayFrameIndex++];
+
+	TArray<UIntrinsicSceneCaptureComponent2D*> FrameCameras;
+	ApplyReplayFrame(Frame, FrameCameras);
+
+	// Same frame numbers / timestamps as the live run, through the normal readback + serializers
+	Subsystem->CaptureFrameAt(FrameCameras, Frame.FrameNumber, Frame.Timestamp);
+}
+
+void ACameraCaptureManager::ApplyReplayFrame(const FCaptureTrajectoryFrame& Frame, TArray<UIntrinsicSceneCaptureComponent2D*>& OutCameras)
+{
+	// Actor poses are deltas: actors not listed keep the pose of their last record
+	for (const FCaptureTrajectoryPose& Pose : Frame.ActorPoses)
+	{
+		if (AActor* Actor = ReplayActors.IsValidIndex(Pose.Index) ? ReplayActors[Pose.Index].Get() : nullptr)
+		{
+			Actor->SetActorTransform(Pose.Transform, false, nullptr, ETeleportType::TeleportPhysics);
+		}
+	}
+
+	// Bone poses replace the animation the frozen meshes no longer evaluate
+	for (const FCaptureTrajectorySkeletalPose& Pose : Frame.SkeletalPoses)
+	{
+		USkeletalMeshComponent* Mesh = ReplaySkeletalMeshes.IsValidIndex(Pose.Index) ? ReplaySkeletalMeshes[Pose.Index].Get() : nullptr;
+		if (!Mesh)
+		{
+			continue;
+		}
+
+		TArray<FTransform>& BoneTransforms = Mesh->GetEditableComponentSpaceTransforms();
+		if (BoneTransforms.Num() != Pose.BoneTransforms.Num())
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("[CameraCaptureManager] Replay: %s has %d bones, recorded pose has %d"),
+				*Mesh->GetName(), BoneTransforms.Num(), Pose.BoneTransforms.Num());
+			continue;
+		}
+
+		BoneTransforms = Pose.BoneTransforms;
+		Mesh->ApplyEditedComponentSpaceTransforms();
+	}
+
+	// Camera poses are applied last so they win over any attachment to a replayed actor
+	for (const FCaptureTrajectoryPose& Pose : Frame.CameraPoses)
+	{
+		if (UIntrinsicSceneCaptureComponent2D* Camera = ReplayCameras.IsValidIndex(Pose.Index) ? ReplayCameras[Pose.Index].Get() : nullptr)
+		{
+			Camera->SetWorldTransform(Pose.Transform, false, nullptr, ETeleportType::TeleportPhysics);
+			OutCameras.Add(Camera);
+		}
+	}
+}
+
+// ============================================================================
+// Pose List
+// ============================================================================
+
+bool ACameraCaptureManager::StartPoseList()
+{
+	UCameraCaptureSubsystem* Subsystem = GetCaptureSubsystem();
+	if (!Subsystem)
+	{
+		return false;
+	}
+
+	const FString FilePath = FPaths::IsRelative(PoseListFile) ? FPaths::ProjectDir() / PoseListFile : PoseListFile;
+	if (!PoseList.LoadFromFile(FilePath))
+	{
+		return false;
+	}
+
+	// Time-range shards capture a contiguous block of poses; the pose before the
+	// block is rendered (not captured) so the first capture has the same history
+	Subsystem->GetShardRange(PoseList.Poses.Num(), PoseListIndex, PoseListEndIndex);
+	PoseListBeginIndex = PoseListIndex;
+	TArray<UIntrinsicSceneCaptureComponent2D*> PrimeCameras;
+	if (PoseListIndex > 0 && ApplyPose(PoseListIndex - 1, PrimeCameras))
+	{
+		Subsystem->PrimeCaptureHistory(PrimeCameras);
+	}
+
+	PoseListStartTime = FPlatformTime::Seconds();
+	bRunningPoseList = true;
+	UpdateTickEnabled();
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureManager] Capturing poses %d-%d of %d from %s (%d per tick, %d max queued)"),
+		PoseListIndex, PoseListEndIndex - 1, PoseList.Poses.Num(), *FilePath, PosesPerTick, MaxQueuedFrames);
+	return true;
+}
+
+void ACameraCaptureManager::CaptureNextPoses()
+{
+	UCameraCaptureSubsystem* Subsystem = GetCaptureSubsystem();
+	if (!Subsystem)
+	{
+		bRunningPoseList = false;
+		UpdateTickEnabled();
+		return;
+	}
+
+	// Pose K+1 is kicked while pose K is still being read back and encoded; the
+	// queue bound only blocks when the readback/serializer pipeline is full
+	for (int32 Kicked = 0; Kicked < FMath::Max(1, PosesPerTick) && PoseListIndex < PoseListEndIndex; ++Kicked)
+	{
+		const int32					 PoseIndex = PoseListIndex++;
+		const FCapturePoseListEntry& Pose = PoseList.Poses[PoseIndex];
+
+		TArray<UIntrinsicSceneCaptureComponent2D*> PoseCameras;
+		if (!ApplyPose(PoseIndex, PoseCameras))
+		{
+			continue;
+		}
+
+		Subsystem->WaitForQueueCapacity(MaxQueuedFrames);
+
+		const double Timestamp = Pose.Timestamp >= 0.0 ? Pose.Timestamp : PoseIndex * FixedTimeStepSeconds;
+		Subsystem->CaptureFrameAt(PoseCameras, PoseIndex, Timestamp);
+	}
+
+	if (PoseListIndex >= PoseListEndIndex)
+	{
+		FinishPoseList();
+	}
+}
+
+bool ACameraCaptureManager::ApplyPose(int32 PoseIndex, TArray<UIntrinsicSceneCaptureComponent2D*>& OutCameras)
+{
+	UCameraCaptureSubsystem*	 Subsystem = GetCaptureSubsystem();
+	const FCapturePoseListEntry& Pose = PoseList.Poses[PoseIndex];
+
+	if (Pose.CameraID.IsEmpty())
+	{
+		if (!PoseListRig)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureManager] Pose %d names no camera and no Pose List Rig is set, skipping"), PoseIndex);
+			return false;
+		}
+		PoseListRig->SetActorTransform(Pose.Transform, false, nullptr, ETeleportType::TeleportPhysics);
+		OutCameras = Subsystem->GetRegisteredCameras();
+	}
+	else if (UIntrinsicSceneCaptureComponent2D* Camera = Subsystem->FindCameraByID(Pose.CameraID))
+	{
+		Camera->SetWorldTransform(Pose.Transform, false, nullptr, ETeleportType::TeleportPhysics);
+		OutCameras.Add(Camera);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureManager] Pose %d: camera %s is not registered, skipping"), PoseIndex, *Pose.CameraID);
+		return false;
+	}
+
+	if (Pose.bHasIntrinsics)
+	{
+		for (UIntrinsicSceneCaptureComponent2D* Camera : OutCameras)
+		{
+			Subsystem->SetCameraIntrinsics(Camera, Pose.Intrinsics);
+		}
+	}
+
+	return true;
+}
+
+void ACameraCaptureManager::FinishPoseList()
+{
+	bRunningPoseList = false;
+	UpdateTickEnabled();
+
+	// Drain the pipeline so "finished" means every capture is on disk
+	if (UCameraCaptureSubsystem* Subsystem = GetCaptureSubsystem())
+	{
+		Subsystem->WaitForQueueCapacity(1);
+		if (Subsystem->IsShardConfigured())
+		{
+			Subsystem->WriteShardManifest();
+		}
+	}
+
+	const double Elapsed = FPlatformTime::Seconds() - PoseListStartTime;
+	const int32	 PoseCount = PoseListEndIndex - PoseListBeginIndex;
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureManager] Pose list finished: %d poses in %.2fs (%.1f poses/s)"),
+		PoseCount, Elapsed, Elapsed > 0.0 ? PoseCount / Elapsed : 0.0);
+
+	PoseList = FCapturePoseList();
+}
+
 // ============================================================================
 // Camera Registration
 // ============================================================================
@@ -276,47 +820,180 @@ TArray<UIntrinsicSceneCaptureComponent2D*> ACameraCaptureManager::FindAllCameras
 		return FoundCameras;
 	}
 
-	int32 TotalActorsChecked = 0;
-	int32 TotalCameraComponentsFound = 0;
-
-	// Iterate all actors in world
-	for (TActorIterator<AActor> It(World); It; ++It)
+	// Iterate camera components only (not every actor in the world)
+	for (TObjectIterator<UIntrinsicSceneCaptureComponent2D> It; It; ++It)
 	{
-		AActor* Actor = *It;
-		if (!Actor)
+		UIntrinsicSceneCaptureComponent2D* Camera = *It;
+		if (!ShouldDiscoverCamera(Camera) || !Camera->IsRegistered())
 		{
 			continue;
 		}
 
-		TotalActorsChecked++;
+		FoundCameras.Add(Camera);
+
+		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureManager] Found camera: %s on actor: %s"),
+			*Camera->GetName(), Camera->GetOwner() ? *Camera->GetOwner()->GetName() : TEXT("None"));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureManager] Search complete: %d camera components found"), FoundCameras.Num());
+
+	return FoundCameras;
+}
+
+// ============================================================================
+// Runtime Discovery
+// ============================================================================
+
+void ACameraCaptureManager::StartCameraDiscovery()
+{
+	if (CameraRegisteredHandle.IsValid())
+	{
+		return;
+	}
+
+	// Spawned/destroyed actors and streamed levels all register/unregister their components
+	CameraRegisteredHandle = UIntrinsicSceneCaptureComponent2D::OnCameraRegistered.AddUObject(this, &ACameraCaptureManager::OnCameraComponentRegistered);
+	CameraUnregisteredHandle = UIntrinsicSceneCaptureComponent2D::OnCameraUnregistered.AddUObject(this, &ACameraCaptureManager::OnCameraComponentUnregistered);
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureManager] Runtime camera discovery enabled (%d registrations per tick)"), MaxCameraRegistrationsPerTick);
+}
+
+void ACameraCaptureManager::StopCameraDiscovery()
+{
+	UIntrinsicSceneCaptureComponent2D::OnCameraRegistered.Remove(CameraRegisteredHandle);
+	UIntrinsicSceneCaptureComponent2D::OnCameraUnregistered.Remove(CameraUnregisteredHandle);
+	CameraRegisteredHandle.Reset();
+	CameraUnregisteredHandle.Reset();
+
+	PendingRegistrations.Reset();
+	PendingRegistrationSet.Reset();
+	PendingUnregistrations.Reset();
+}
+
+bool ACameraCaptureManager::ShouldDiscoverCamera(const UIntrinsicSceneCaptureComponent2D* Camera) const
+{
+	return IsValid(Camera) && !Camera->bIsCaptureHelper && !Camera->IsTemplate() && Camera->GetWorld() == GetWorld();
+}
+
+void ACameraCaptureManager::OnCameraComponentRegistered(UIntrinsicSceneCaptureComponent2D* Camera)
+{
+	if (!ShouldDiscoverCamera(Camera))
+	{
+		return;
+	}
+
+	// Re-registered (unregistered and registered again in one call): keep its registration
+	if (PendingUnregistrations.Remove(Camera) > 0)
+	{
+		return;
+	}
+
+	bool bAlreadyPending = false;
+	PendingRegistrationSet.Add(Camera, &bAlreadyPending);
+	if (!bAlreadyPending)
+	{
+		PendingRegistrations.Add(Camera);
+		UpdateTickEnabled();
+	}
+}
+
+void ACameraCaptureManager::OnCameraComponentUnregistered(UIntrinsicSceneCaptureComponent2D* Camera)
+{
+	if (!ShouldDiscoverCamera(Camera))
+	{
+		return;
+	}
+
+	// Not registered yet: just cancel the pending registration
+	if (PendingRegistrationSet.Remove(Camera) > 0)
+	{
+		return;
+	}
+
+	UCameraCaptureSubsystem* Subsystem = GetCaptureSubsystem();
+	if (Subsystem && Subsystem->GetCameraHandle(Camera).IsValid())
+	{
+		PendingUnregistrations.Add(Camera);
+		UpdateTickEnabled();
+	}
+}
+
+void ACameraCaptureManager::ProcessPendingRegistrations()
+{
+	if (PendingRegistrations.Num() == 0 && PendingUnregistrations.Num() == 0)
+	{
+		return;
+	}
 
-		// Find all IntrinsicSceneCaptureComponent2D components on this actor
-		TArray<UIntrinsicSceneCaptureComponent2D*> CameraComponents;
-		Actor->GetComponents<UIntrinsicSceneCaptureComponent2D>(CameraComponents);
+	UCameraCaptureSubsystem* Subsystem = GetCaptureSubsystem();
+	if (!Subsystem)
+	{
+		return;
+	}
 
-		for (UIntrinsicSceneCaptureComponent2D* Camera : CameraComponents)
+	// Destroyed cameras are also removed by the subsystem's kick loop
+	for (const TWeakObjectPtr<UIntrinsicSceneCaptureComponent2D>& WeakCamera : PendingUnregistrations)
+	{
+		UIntrinsicSceneCaptureComponent2D* Camera = WeakCamera.Get();
+		if (Camera && !Camera->IsRegistered())
 		{
-			if (Camera)
-			{
-				TotalCameraComponentsFound++;
-				FoundCameras.Add(Camera);
+			Subsystem->UnregisterCamera(Camera);
+		}
+	}
+	PendingUnregistrations.Reset();
 
-				UE_LOG(LogTemp, Log, TEXT("[CameraCaptureManager] Found camera: %s on actor: %s"),
-					*Camera->GetName(), *Actor->GetName());
-			}
+	int32 Processed = 0;
+	int32 Registered = 0;
+	while (Processed < PendingRegistrations.Num() && Registered < MaxCameraRegistrationsPerTick)
+	{
+		TWeakObjectPtr<UIntrinsicSceneCaptureComponent2D> WeakCamera = PendingRegistrations[Processed++];
+
+		// Skip cancelled entries (unregistered again before their turn)
+		if (PendingRegistrationSet.Remove(WeakCamera) == 0)
+		{
+			continue;
+		}
+
+		UIntrinsicSceneCaptureComponent2D* Camera = WeakCamera.Get();
+		if (Camera && Camera->IsRegistered())
+		{
+			Subsystem->RegisterCamera(Camera);
+			Registered++;
 		}
 	}
+	PendingRegistrations.RemoveAt(0, Processed, false);
 
-	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureManager] Search complete: %d actors checked, %d camera components found"),
-		TotalActorsChecked, TotalCameraComponentsFound);
+	if (Registered > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureManager] Registered %d discovered camera(s), %d pending"),
+			Registered, PendingRegistrationSet.Num());
+	}
 
-	return FoundCameras;
+	if (PendingRegistrations.Num() == 0)
+	{
+		UpdateTickEnabled();
+	}
+}
+
+void ACameraCaptureManager::UpdateTickEnabled()
+{
+	SetActorTickEnabled(bReplaying || bRunningPoseList || PendingRegistrations.Num() > 0 || PendingUnregistrations.Num() > 0);
 }
 
 // ============================================================================
 // Helpers
 // ============================================================================
 
+FString ACameraCaptureManager::GetTrajectoryFilePath() const
+{
+	if (TrajectoryFile.IsEmpty())
+	{
+		return OutputDirectory / TEXT("trajectory.cctraj");
+	}
+
+	return FPaths::IsRelative(TrajectoryFile) ? FPaths::ProjectDir() / TrajectoryFile : TrajectoryFile;
+}
+
 UCameraCaptureSubsystem* ACameraCaptureManager::GetCaptureSubsystem() const
 {
 	if (CachedSubsystem)
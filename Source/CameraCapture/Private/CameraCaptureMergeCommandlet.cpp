@@ -0,0 +1,40 @@
+#include "CameraCaptureMergeCommandlet.h"
+#include "CameraCaptureSubsystem.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+UCameraCaptureMergeCommandlet::UCameraCaptureMergeCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UCameraCaptureMergeCommandlet::Main(const FString& Params)
+{
+	FString OutputDirectory = FPaths::ProjectSavedDir() / TEXT("CameraCaptures");
+	FParse::Value(*Params, TEXT("OutputDir="), OutputDirectory);
+
+	UE_LOG(LogTemp, Display, TEXT("[CameraCaptureMerge] Merging shard manifests in %s"), *OutputDirectory);
+
+	if (!UCameraCaptureSubsystem::MergeShardManifests(OutputDirectory))
+	{
+		return 1;
+	}
+
+	// Optional reproducibility check against another run of the same session
+	FString CompareDirectory;
+	if (!FParse::Value(*Params, TEXT("CompareDir="), CompareDirectory))
+	{
+		return 0;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[CameraCaptureMerge] Comparing %s with %s"), *OutputDirectory, *CompareDirectory);
+
+	if (!UCameraCaptureSubsystem::MergeShardManifests(CompareDirectory))
+	{
+		return 1;
+	}
+	return UCameraCaptureSubsystem::CompareSessionOutputs(OutputDirectory, CompareDirectory) ? 0 : 2;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "CaptureTimeline.h"
+
+// ============================================================================
+// Stats (stat CameraCapture)
+// ============================================================================
+
+DECLARE_STATS_GROUP(TEXT("CameraCapture"), STATGROUP_CameraCapture, STATCAT_Advanced);
+
+// Game thread
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Kick"), STAT_CameraCapture_Kick, STATGROUP_CameraCapture, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Metadata"), STAT_CameraCapture_BuildMetadata, STATGROUP_CameraCapture, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enqueue Readback"), STAT_CameraCapture_EnqueueReadback, STATGROUP_CameraCapture, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Poll Readbacks"), STAT_CameraCapture_PollReadbacks, STATGROUP_CameraCapture, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Broadcast"), STAT_CameraCapture_Broadcast, STATGROUP_CameraCapture, );
+
+// Harvest (render-thread watcher tasks or game thread)
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Harvest RGB"), STAT_CameraCapture_HarvestRgb, STATGROUP_CameraCapture, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Harvest DMV"), STAT_CameraCapture_HarvestDmv, STATGROUP_CameraCapture, );
+
+// Serializer threads
+DECLARE_CYCLE_STAT_EXTERN(TEXT("EXR Pack"), STAT_CameraCapture_ExrPack, STATGROUP_CameraCapture, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("EXR Interleave + Enqueue"), STAT_CameraCapture_ExrEnqueue, STATGROUP_CameraCapture, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("JSON Write"), STAT_CameraCapture_JsonWrite, STATGROUP_CameraCapture, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("File I/O"), STAT_CameraCapture_FileIO, STATGROUP_CameraCapture, );
+
+// Counters
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Captures"), STAT_CameraCapture_PendingCaptures, STATGROUP_CameraCapture, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Serialization Backlog"), STAT_CameraCapture_SerializationBacklog, STATGROUP_CameraCapture, );
+
+// Memory
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Pooled Render Targets"), STAT_CameraCapture_PooledRenderTargetMemory, STATGROUP_CameraCapture, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Pooled Pixel Buffers"), STAT_CameraCapture_PooledPixelBufferMemory, STATGROUP_CameraCapture, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Outstanding Pixel Buffers"), STAT_CameraCapture_OutstandingPixelBufferMemory, STATGROUP_CameraCapture, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Reserved Capture Memory"), STAT_CameraCapture_ReservedMemory, STATGROUP_CameraCapture, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Frames Queued For Write"), STAT_CameraCapture_QueuedForWriteMemory, STATGROUP_CameraCapture, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("EXR Encode Memory"), STAT_CameraCapture_EncodingMemory, STATGROUP_CameraCapture, );
+
+// ============================================================================
+// Insights trace channel (-trace=cpu,bookmark,CameraCapture)
+// ============================================================================
+
+UE_TRACE_CHANNEL_EXTERN(CameraCaptureChannel);
+
+/**
+ * CPU timing span on CameraCaptureChannel named after its stage, with a bookmark
+ * "<Stage> <CameraID> #<FrameNumber>" at its start so a frame can be followed from
+ * kick to file by searching for its number. The span's event type is registered
+ * once per call site (SpecId); names are never built per span.
+ * Also recorded as a span of the Chrome trace timeline while that is recording.
+ * Costs two branches when both are off.
+ */
+class FCameraCaptureTraceScope
+{
+public:
+	FCameraCaptureTraceScope(const TCHAR* Stage, uint32& SpecId, FName CameraID, int64 FrameNumber)
+	{
+#if CPUPROFILERTRACE_ENABLED
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(CameraCaptureChannel))
+		{
+			if (SpecId == 0)
+			{
+				SpecId = FCpuProfilerTrace::OutputEventType(Stage);
+			}
+			bActive = true;
+			FCpuProfilerTrace::OutputBeginEvent(SpecId);
+
+			TStringBuilder<128> CameraName;
+			CameraID.AppendString(CameraName);
+			TRACE_BOOKMARK(TEXT("%s %s #%lld"), Stage, *CameraName, FrameNumber);
+		}
+#endif
+		if (FCaptureTimeline::IsRecording())
+		{
+			TimelineStage = Stage;
+			TimelineCameraID = CameraID;
+			TimelineFrameNumber = FrameNumber;
+			TimelineBeginSeconds = FPlatformTime::Seconds();
+		}
+	}
+
+	~FCameraCaptureTraceScope()
+	{
+#if CPUPROFILERTRACE_ENABLED
+		if (bActive)
+		{
+			FCpuProfilerTrace::OutputEndEvent();
+		}
+#endif
+		if (TimelineStage)
+		{
+			FCaptureTimeline::Record(TimelineStage, TimelineCameraID, TimelineFrameNumber, TimelineBeginSeconds, FPlatformTime::Seconds());
+		}
+	}
+
+private:
+	bool bActive = false;
+
+	// Set while the timeline is recording
+	const TCHAR* TimelineStage = nullptr;
+	FName		 TimelineCameraID;
+	int64		 TimelineFrameNumber = 0;
+	double		 TimelineBeginSeconds = 0.0;
+};
+
+/** Cycle counter plus a camera/frame-tagged trace span for one pipeline stage */
+#define CAMERA_CAPTURE_SCOPE(Stat, Stage, CameraID, FrameNumber)              \
+	SCOPE_CYCLE_COUNTER(Stat);                                                \
+	static uint32 PREPROCESSOR_JOIN(CameraCaptureTraceSpecId_, __LINE__) = 0; \
+	FCameraCaptureTraceScope PREPROCESSOR_JOIN(CameraCaptureTraceScope_, __LINE__)(TEXT(Stage), PREPROCESSOR_JOIN(CameraCaptureTraceSpecId_, __LINE__), CameraID, FrameNumber)
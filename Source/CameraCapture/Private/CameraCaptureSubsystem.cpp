@@ -1,8 +1,13 @@
 #include "CameraCaptureSubsystem.h"
+#include "CameraCaptureStats.h"
+#include "CaptureMetricsExporter.h"
+#include "CaptureTimeline.h"
 #include "IntrinsicSceneCaptureComponent2D.h"
 #include "Utilities.h"
 #include "RHIGPUReadback.h"
 #include "RenderingThread.h"
+#include "RenderCore.h"
+#include "RHI.h"
 #include "Engine/World.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "GameFramework/Actor.h"
@@ -11,7 +16,32 @@
 #include "Misc/FileHelper.h"
 #include "HAL/PlatformFileManager.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "ImageUtils.h"
+#include "ImageWriteQueue.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "EngineUtils.h"
+#include "ConvexVolume.h"
+#include "SceneView.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/ScopeExit.h"
+#include "Engine/Canvas.h"
+#include "Components/LightComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Engine/Font.h"
+#include "SceneInterface.h"
+#include "Debug/DebugDrawService.h"
+
+#if WITH_EDITOR
+	#include "ShaderCompiler.h"
+#endif
 
 // ============================================================================
 // FCameraIdentifier Implementation
@@ -53,10 +83,34 @@ FString FCameraIdentifier::GetFullPath(const FString& BaseDir) const
 	return FPaths::Combine(BaseDir, ActorName, ComponentName);
 }
 
+// ============================================================================
+// FCaptureData Implementation
+// ============================================================================
+
+const FCaptureCameraInfo& FCaptureData::GetCameraInfo() const
+{
+	static const FCaptureCameraInfo EmptyInfo;
+	return CameraInfo.IsValid() ? *CameraInfo : EmptyInfo;
+}
+
+const FCaptureData* FCaptureFrameSet::FindFrame(const FString& UniqueID) const
+{
+	for (const TSharedRef<const FCaptureData>& Data : Frames)
+	{
+		if (Data->GetCameraInfo().CameraID.UniqueID == UniqueID)
+		{
+			return &Data.Get();
+		}
+	}
+	return nullptr;
+}
+
 // ============================================================================
 // UCameraCaptureSubsystem Implementation
 // ============================================================================
 
+TWeakObjectPtr<UCameraCaptureSubsystem> UCameraCaptureSubsystem::CommandLineMetricsOwner;
+
 UCameraCaptureSubsystem::UCameraCaptureSubsystem()
 {
 	// Default output directory
@@ -81,6 +135,46 @@ void UCameraCaptureSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Loaded M_DmvCapture material successfully from plugin"));
 	}
 
+	// Multi-process capture: -CameraCaptureShard=<Index> -CameraCaptureShardCount=<Count>
+	int32 CommandLineShardIndex = 0;
+	int32 CommandLineShardCount = 0;
+	if (FParse::Value(FCommandLine::Get(), TEXT("CameraCaptureShardCount="), CommandLineShardCount))
+	{
+		FParse::Value(FCommandLine::Get(), TEXT("CameraCaptureShard="), CommandLineShardIndex);
+
+		FString ModeString;
+		FParse::Value(FCommandLine::Get(), TEXT("CameraCaptureShardMode="), ModeString);
+		const ECaptureShardMode Mode = ModeString.Equals(TEXT("TimeRange"), ESearchCase::IgnoreCase) ? ECaptureShardMode::TimeRange : ECaptureShardMode::Cameras;
+
+		SetShard(CommandLineShardIndex, CommandLineShardCount, Mode);
+	}
+
+	// Fleet telemetry: -CameraCaptureMetricsFile=<Path> [-CameraCaptureMetricsInterval=<Seconds>]
+	// One file per process, so only the first game (or PIE) world exports it; the editor
+	// world and later worlds would otherwise race on the same temporary file.
+	const UWorld* World = GetWorld();
+	if (World && World->IsGameWorld() && !CommandLineMetricsOwner.IsValid()
+		&& FParse::Value(FCommandLine::Get(), TEXT("CameraCaptureMetricsFile="), CommandLineMetricsFile))
+	{
+		FParse::Value(FCommandLine::Get(), TEXT("CameraCaptureMetricsInterval="), CommandLineMetricsInterval);
+		CommandLineMetricsOwner = this;
+		RestoreCommandLineMetricsExport();
+	}
+
+	// Kick records hold their camera strongly; drop it once it unregisters
+	CameraUnregisteredHandle = UIntrinsicSceneCaptureComponent2D::OnCameraUnregistered.AddUObject(this, &UCameraCaptureSubsystem::OnCameraComponentUnregistered);
+
+	PixelBufferPool = MakeShared<FCaptureBufferPool, ESPMode::ThreadSafe>();
+	StatisticsResetTime = FPlatformTime::Seconds();
+
+	// Readback completion is detected at the end of each rendered frame
+	ReadbackWatcher = MakeShared<FReadbackWatcher, ESPMode::ThreadSafe>();
+	ENQUEUE_RENDER_COMMAND(CameraCaptureWatchReadbacks)
+	(
+		[Watcher = ReadbackWatcher.ToSharedRef()](FRHICommandListImmediate& RHICmdList) {
+			Watcher->EndFrameHandle = FCoreDelegates::OnEndFrameRT.AddSP(Watcher, &FReadbackWatcher::PollReadyReadbacks);
+		});
+
 	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Initialized"));
 }
 
@@ -91,16 +185,71 @@ void UCameraCaptureSubsystem::Deinitialize()
 	{
 		StopCapture();
 	}
+	RestoreEngineTiming();
+
+	// Leave the final counters behind for the last scrape
+	SetMetricsExport(false);
+	if (CommandLineMetricsOwner.Get() == this)
+	{
+		CommandLineMetricsOwner.Reset();
+	}
+
+	UIntrinsicSceneCaptureComponent2D::OnCameraUnregistered.Remove(CameraUnregisteredHandle);
+	CameraUnregisteredHandle.Reset();
+	KickList.Empty();
+
+	if (TimelineWrite.IsValid())
+	{
+		TimelineWrite.Wait();
+	}
 
 	// Drop any pending readbacks
-	PendingCaptures.Empty();
+	PendingQueues.Empty();
+	PendingCaptureCount = 0;
+	PendingFrameSets.Empty();
+
+	if (ReadbackWatcher.IsValid())
+	{
+		ENQUEUE_RENDER_COMMAND(CameraCaptureUnwatchReadbacks)
+		(
+			[Watcher = ReadbackWatcher.ToSharedRef()](FRHICommandListImmediate& RHICmdList) {
+				FCoreDelegates::OnEndFrameRT.Remove(Watcher->EndFrameHandle);
+				Watcher->InFlight.Empty();
+			});
+		ReadbackWatcher.Reset();
+	}
+
+	// Frames still held by listeners keep the pool alive until they are released
+	if (PixelBufferPool.IsValid())
+	{
+		PixelBufferPool->Empty();
+		PixelBufferPool.Reset();
+	}
+	// Queries go back to the pool on the render thread, which keeps the pool alive until then
+	TArray<TSharedRef<FCaptureGpuTimer, ESPMode::ThreadSafe>> TimersToRelease;
+	for (const FOutstandingGpuTimer& Entry : OutstandingGpuTimers)
+	{
+		TimersToRelease.Add(Entry.Timer);
+	}
+	ReleaseGpuTimerQueries(MoveTemp(TimersToRelease));
+	OutstandingGpuTimers.Empty();
+	GpuTimerQueryPool.SafeRelease();
 
 	// Clear all registrations
-	RegisteredCameras.Empty();
-	CameraIDMap.Empty();
-	UsedActorNames.Empty();
+	CameraRegistry.Empty();
+	KickList.Empty();
+	bKickListDirty = true;
+	CameraIndices.Empty();
+	UniqueIDIndices.Empty();
+	ActorNameRefCounts.Empty();
+	ActorNameSuffixes.Empty();
+	PendingResourceSetups.Empty();
+	PendingResourceSetupCount = 0;
 	DmvRenderTargets.Empty();
 	DmvCameras.Empty();
+	ReleaseRenderTargetPool();
+	StopTrackingSceneActors();
+	SetDebugHudVisible(false);
 
 	Super::Deinitialize();
 
@@ -114,6 +263,37 @@ void UCameraCaptureSubsystem::Tick(float DeltaTime)
 	// Always harvest completed readbacks (even between kick frames)
 	HarvestReadyReadbacks();
 
+	// Finalize frame sets whose missing views are not coming
+	if (PendingFrameSets.Num() > 0)
+	{
+		FlushFrameSets(false);
+	}
+
+	// Fold finished GPU timestamps into per-camera stats, then let the governor react
+	ResolveGpuTimers();
+	UpdateGpuGovernor();
+
+	// Create resources for newly registered cameras a few at a time
+	if (PendingResourceSetups.Num() > 0)
+	{
+		ProcessPendingResourceSetups(ResourceSetupBudgetMs / 1000.0);
+	}
+
+	// Release pooled targets nobody has borrowed recently (e.g. sizes left behind by intrinsics changes)
+	if (FreeRenderTargets.Num() > 0)
+	{
+		TrimRenderTargetPool(PooledTargetIdleKicks);
+	}
+
+	UpdatePipelineStats();
+
+	// Exported while idle too (IsTickable keeps us ticking while exporting), so a scrape can
+	// tell a stalled pipeline from a dead process
+	if (MetricsExporter.IsValid() && FPlatformTime::Seconds() >= NextMetricsExportTime)
+	{
+		ExportMetrics();
+	}
+
 	// Safety check - only tick if initialized and capturing
 	if (!IsInitialized() || !bIsCapturing)
 	{
@@ -122,22 +302,47 @@ void UCameraCaptureSubsystem::Tick(float DeltaTime)
 
 	CurrentFrameCounter++;
 
-	// Check if we should capture this frame
-	if (CurrentFrameCounter % CaptureEveryNFrames == 0)
+	// Offline mode applies backpressure instead of dropping or throttling
+	if (bOfflineMode && !WaitForOfflineQueueCapacity())
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Offline capture stopped: the pipeline made no progress for %.0fs (%d frames queued)"),
+			PipelineWaitTimeoutSeconds, GetQueuedFrameCount());
+		StopCapture();
+		return;
+	}
+
+	// Each camera decides whether it is due this frame (per-camera rate / every-N)
+	KickAllCaptures();
+}
+
+void UCameraCaptureSubsystem::UpdatePipelineStats()
+{
+#if STATS
+	SET_DWORD_STAT(STAT_CameraCapture_PendingCaptures, PendingCaptureCount);
+	SET_DWORD_STAT(STAT_CameraCapture_SerializationBacklog, SerializationBacklog->GetValue());
+	SET_MEMORY_STAT(STAT_CameraCapture_PooledRenderTargetMemory, PooledRenderTargetBytes);
+	SET_MEMORY_STAT(STAT_CameraCapture_ReservedMemory, MemoryTracker->GetReservedBytes());
+	SET_MEMORY_STAT(STAT_CameraCapture_QueuedForWriteMemory, MemoryTracker->GetStageBytes(ECaptureMemoryStage::QueuedForWrite));
+	SET_MEMORY_STAT(STAT_CameraCapture_EncodingMemory, MemoryTracker->GetStageBytes(ECaptureMemoryStage::Encoding));
+
+	if (PixelBufferPool.IsValid())
 	{
-		KickAllCaptures();
+		const FCaptureBufferPool::FStats PoolStats = PixelBufferPool->GetStats();
+		SET_MEMORY_STAT(STAT_CameraCapture_PooledPixelBufferMemory, PoolStats.PooledBytes);
+		SET_MEMORY_STAT(STAT_CameraCapture_OutstandingPixelBufferMemory, PoolStats.OutstandingBytes);
 	}
+#endif
 }
 
 TStatId UCameraCaptureSubsystem::GetStatId() const
 {
-	RETURN_QUICK_DECLARE_CYCLE_STAT(UCameraCaptureSubsystem, STATGROUP_Tickables);
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCameraCaptureSubsystem, STATGROUP_CameraCapture);
 }
 
 bool UCameraCaptureSubsystem::IsTickable() const
 {
-	// Tick if we're capturing OR if there are pending readbacks to harvest
-	return IsInitialized() && (bIsCapturing || PendingCaptures.Num() > 0) && !IsTemplate();
+	// Tick if we're capturing OR if there are pending readbacks to harvest OR metrics to export
+	return IsInitialized() && (bIsCapturing || PendingCaptureCount > 0 || PendingFrameSets.Num() > 0 || OutstandingGpuTimers.Num() > 0 || PendingResourceSetups.Num() > 0 || MetricsExporter.IsValid()) && !IsTemplate();
 }
 
 void UCameraCaptureSubsystem::OnWorldBeginPlay(UWorld& InWorld)
@@ -151,43 +356,54 @@ void UCameraCaptureSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 // Camera Registration
 // ============================================================================
 
-void UCameraCaptureSubsystem::RegisterCamera(UIntrinsicSceneCaptureComponent2D* Camera)
+FCameraHandle UCameraCaptureSubsystem::RegisterCamera(UIntrinsicSceneCaptureComponent2D* Camera)
 {
 	if (!Camera)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Attempted to register null camera"));
-		return;
+		return FCameraHandle();
 	}
 
 	if (!IsInitialized())
 	{
 		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Cannot register camera - subsystem not initialized"));
-		return;
+		return FCameraHandle();
 	}
 
 	// Check if already registered
-	if (RegisteredCameras.Contains(Camera))
+	if (const int32* ExistingIndex = CameraIndices.Find(FObjectKey(Camera)))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Camera already registered: %s"), *Camera->GetName());
-		return;
+		return FCameraHandle{ *ExistingIndex, CameraRegistry[*ExistingIndex].Serial };
 	}
 
 	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Registering camera: %s"), *Camera->GetName());
 
 	// Generate unique identifier
-	FCameraIdentifier CameraID = GenerateCameraID(Camera);
-
-	// Add to registry
-	RegisteredCameras.Add(Camera);
-	CameraIDMap.Add(Camera, CameraID);
-
-	// Create DMV camera if depth/motion capture is enabled
-	if ((bCaptureDepth || bCaptureMotionVectors) && DmvCaptureMaterialBase)
-	{
-		SetupDmvCamera(Camera);
-	}
+	FString			  DisambiguatedFrom;
+	FCameraIdentifier CameraID = GenerateCameraID(Camera, DisambiguatedFrom);
+
+	// Add to registry (reuses a freed slot if there is one)
+	FRegisteredCamera Entry;
+	Entry.Camera = Camera;
+	Entry.CameraKey = FObjectKey(Camera);
+	Entry.Identifier = CameraID;
+	Entry.TraceName = FName(*CameraID.UniqueID);
+	Entry.DisambiguatedFrom = MoveTemp(DisambiguatedFrom);
+	Entry.Serial = NextCameraSerial++;
+
+	const int32			Index = CameraRegistry.Add(MoveTemp(Entry));
+	const FCameraHandle Handle{ Index, CameraRegistry[Index].Serial };
+	CameraIndices.Add(CameraRegistry[Index].CameraKey, Handle.Index);
+	UniqueIDIndices.Add(CameraID.UniqueID, Handle.Index);
+	ActorNameRefCounts.FindOrAdd(CameraID.ActorName)++;
+	bKickListDirty = true;
+
+	// Render target and DMV camera creation is amortized over the next ticks
+	QueueResourceSetup(Handle);
 
 	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Registered camera: %s"), *CameraID.ToString());
+	return Handle;
 }
 
 void UCameraCaptureSubsystem::SetupDmvCamera(UIntrinsicSceneCaptureComponent2D* RgbCamera)
@@ -258,6 +474,7 @@ void UCameraCaptureSubsystem::SetupDmvCamera(UIntrinsicSceneCaptureComponent2D*
 	}
 
 	// Configure DMV camera capture settings
+	DmvCamera->bIsCaptureHelper = true; // Not a camera to discover/register
 	DmvCamera->bCaptureEveryFrame = false;
 	DmvCamera->bCaptureOnMovement = false;
 	DmvCamera->bAlwaysPersistRenderingState = true;
@@ -284,23 +501,19 @@ void UCameraCaptureSubsystem::SetupDmvCamera(UIntrinsicSceneCaptureComponent2D*
 		return;
 	}
 
-	// Create render target for DMV — RGBA32f for depth float precision
-	// Uses depth intrinsics dimensions (may differ from RGB if separate depth intrinsics are set)
-	UTextureRenderTarget2D* DmvRT = NewObject<UTextureRenderTarget2D>(this);
-	DmvRT->RenderTargetFormat = RTF_RGBA32f;
-	DmvRT->InitAutoFormat(Width, Height);
-	DmvRT->UpdateResourceImmediate(true);
-	DmvCamera->TextureTarget = DmvRT;
+	// The template copied the RGB camera's target; the DMV camera needs its own
+	DmvCamera->TextureTarget = nullptr;
+	EnsureDmvRenderTarget(RgbCamera, DmvCamera);
 
 	// Register component so it gets ticked and rendered
 	DmvCamera->RegisterComponent();
 
 	// Store references
 	DmvCameras.Add(RgbCamera, DmvCamera);
-	DmvRenderTargets.Add(RgbCamera, DmvRT);
+	RefreshKickRecord(RgbCamera);
 
-	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Created DMV camera '%s' with render target (%dx%d), intrinsics=%s"),
-		*DmvName, Width, Height, DmvCamera->bUseCustomIntrinsics ? TEXT("custom") : TEXT("default"));
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Created DMV camera '%s' with %s render target (%dx%d), intrinsics=%s"),
+		*DmvName, bPoolRenderTargets ? TEXT("pooled") : TEXT("dedicated"), Width, Height, DmvCamera->bUseCustomIntrinsics ? TEXT("custom") : TEXT("default"));
 }
 
 void UCameraCaptureSubsystem::UnregisterCamera(UIntrinsicSceneCaptureComponent2D* Camera)
@@ -310,65 +523,218 @@ void UCameraCaptureSubsystem::UnregisterCamera(UIntrinsicSceneCaptureComponent2D
 		return;
 	}
 
-	// Remove from registry
-	int32 RemovedCount = RegisteredCameras.Remove(Camera);
+	if (const int32* Index = CameraIndices.Find(FObjectKey(Camera)))
+	{
+		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Unregistered camera: %s"), *CameraRegistry[*Index].Identifier.ToString());
+		RemoveRegisteredCamera(*Index);
+	}
+}
 
-	if (RemovedCount > 0)
+void UCameraCaptureSubsystem::UnregisterCamera(FCameraHandle Handle)
+{
+	if (FRegisteredCamera* Entry = FindRegisteredCamera(Handle))
 	{
-		FCameraIdentifier* CameraID = CameraIDMap.Find(Camera);
-		if (CameraID)
-		{
-			// Remove actor name from used set if this was the last camera from that actor
-			bool bActorStillUsed = false;
-			for (const auto& Pair : CameraIDMap)
-			{
-				if (Pair.Value.ActorName == CameraID->ActorName && Pair.Key != Camera)
-				{
-					bActorStillUsed = true;
-					break;
-				}
-			}
+		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Unregistered camera: %s"), *Entry->Identifier.ToString());
+		RemoveRegisteredCamera(Handle.Index);
+	}
+}
 
-			if (!bActorStillUsed)
-			{
-				UsedActorNames.Remove(CameraID->ActorName);
-			}
+void UCameraCaptureSubsystem::RemoveRegisteredCamera(int32 Index)
+{
+	FRegisteredCamera& Entry = CameraRegistry[Index];
 
-			UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Unregistered camera: %s"), *CameraID->ToString());
+	if (!Entry.bResourcesReady)
+	{
+		PendingResourceSetupCount--;
+	}
+
+	// Release the actor name once no camera of that actor remains registered
+	if (int32* RefCount = ActorNameRefCounts.Find(Entry.Identifier.ActorName))
+	{
+		if (--(*RefCount) <= 0)
+		{
+			ActorNameRefCounts.Remove(Entry.Identifier.ActorName);
 		}
+	}
 
-		// Clean up DMV camera if it exists
-		TWeakObjectPtr<USceneCaptureComponent2D>* DmvCameraPtr = DmvCameras.Find(Camera);
-		if (DmvCameraPtr && DmvCameraPtr->IsValid())
+	// Forget a base name's suffix counter once none of its disambiguated forms is in use
+	if (!Entry.DisambiguatedFrom.IsEmpty())
+	{
+		if (FActorNameSuffixes* Suffixes = ActorNameSuffixes.Find(Entry.DisambiguatedFrom))
 		{
-			USceneCaptureComponent2D* DmvCamera = DmvCameraPtr->Get();
-			if (DmvCamera)
+			if (--Suffixes->NumInUse <= 0)
 			{
-				DmvCamera->DestroyComponent();
+				ActorNameSuffixes.Remove(Entry.DisambiguatedFrom);
 			}
 		}
-		DmvCameras.Remove(Camera);
-		DmvRenderTargets.Remove(Camera);
+	}
+
+	UniqueIDIndices.Remove(Entry.Identifier.UniqueID);
+	CameraIndices.Remove(Entry.CameraKey);
+
+	// Clean up DMV camera if it exists
+	TWeakObjectPtr<USceneCaptureComponent2D>* DmvCameraPtr = DmvCameras.Find(Entry.Camera);
+	if (DmvCameraPtr && DmvCameraPtr->IsValid())
+	{
+		USceneCaptureComponent2D* DmvCamera = DmvCameraPtr->Get();
+		if (DmvCamera)
+		{
+			DmvCamera->DestroyComponent();
+		}
+	}
+	DmvCameras.Remove(Entry.Camera);
+	DmvRenderTargets.Remove(Entry.Camera);
+
+	// Frames already kicked are still harvested; the queue is freed once it drains
+	if (Entry.PendingQueueIndex != INDEX_NONE)
+	{
+		PendingQueues[Entry.PendingQueueIndex].bOrphaned = true;
+	}
+
+	CameraRegistry.RemoveAt(Index);
+	bKickListDirty = true;
+}
+
+UCameraCaptureSubsystem::FRegisteredCamera* UCameraCaptureSubsystem::FindRegisteredCamera(const UIntrinsicSceneCaptureComponent2D* Camera)
+{
+	const int32* Index = CameraIndices.Find(FObjectKey(Camera));
+	return Index ? &CameraRegistry[*Index] : nullptr;
+}
+
+const UCameraCaptureSubsystem::FRegisteredCamera* UCameraCaptureSubsystem::FindRegisteredCamera(const UIntrinsicSceneCaptureComponent2D* Camera) const
+{
+	const int32* Index = CameraIndices.Find(FObjectKey(Camera));
+	return Index ? &CameraRegistry[*Index] : nullptr;
+}
+
+UCameraCaptureSubsystem::FRegisteredCamera* UCameraCaptureSubsystem::FindRegisteredCamera(FCameraHandle Handle)
+{
+	return const_cast<FRegisteredCamera*>(static_cast<const UCameraCaptureSubsystem*>(this)->FindRegisteredCamera(Handle));
+}
 
-		CameraIDMap.Remove(Camera);
+const UCameraCaptureSubsystem::FRegisteredCamera* UCameraCaptureSubsystem::FindRegisteredCamera(FCameraHandle Handle) const
+{
+	// A stale handle's slot is either free or reused by a registration with a newer serial
+	if (!Handle.IsValid() || !CameraRegistry.IsValidIndex(Handle.Index))
+	{
+		return nullptr;
 	}
+	const FRegisteredCamera& Entry = CameraRegistry[Handle.Index];
+	return Entry.Serial == Handle.Serial ? &Entry : nullptr;
+}
+
+FCameraHandle UCameraCaptureSubsystem::GetCameraHandle(const UIntrinsicSceneCaptureComponent2D* Camera) const
+{
+	const int32* Index = CameraIndices.Find(FObjectKey(Camera));
+	return Index ? FCameraHandle{ *Index, CameraRegistry[*Index].Serial } : FCameraHandle();
+}
+
+UIntrinsicSceneCaptureComponent2D* UCameraCaptureSubsystem::GetCamera(FCameraHandle Handle) const
+{
+	const FRegisteredCamera* Entry = FindRegisteredCamera(Handle);
+	return Entry ? Entry->Camera.Get() : nullptr;
+}
+
+const FCameraIdentifier* UCameraCaptureSubsystem::GetCameraIdentifier(FCameraHandle Handle) const
+{
+	const FRegisteredCamera* Entry = FindRegisteredCamera(Handle);
+	return Entry ? &Entry->Identifier : nullptr;
 }
 
 TArray<UIntrinsicSceneCaptureComponent2D*> UCameraCaptureSubsystem::GetRegisteredCameras() const
 {
 	TArray<UIntrinsicSceneCaptureComponent2D*> ValidCameras;
+	ValidCameras.Reserve(CameraRegistry.Num());
 
-	for (const TWeakObjectPtr<UIntrinsicSceneCaptureComponent2D>& WeakCamera : RegisteredCameras)
+	for (const FRegisteredCamera& Entry : CameraRegistry)
 	{
-		if (WeakCamera.IsValid())
+		if (UIntrinsicSceneCaptureComponent2D* Camera = Entry.Camera.Get())
 		{
-			ValidCameras.Add(WeakCamera.Get());
+			ValidCameras.Add(Camera);
 		}
 	}
 
 	return ValidCameras;
 }
 
+void UCameraCaptureSubsystem::SetCameraIntrinsics(UIntrinsicSceneCaptureComponent2D* Camera, const FCameraIntrinsics& Intrinsics)
+{
+	if (!Camera || Intrinsics.ImageWidth < 1 || Intrinsics.ImageHeight < 1)
+	{
+		return;
+	}
+
+	// Inline intrinsics with an explicit projection; the maintain-Y-axis path mutates
+	// FOVAngle on every application and is not meant to be re-applied per pose
+	Camera->bUseCustomIntrinsics = true;
+	Camera->bUseIntrinsicsAsset = false;
+	Camera->InlineIntrinsics = Intrinsics;
+	Camera->InlineIntrinsics.bMaintainYAxis = false;
+	Camera->ApplyIntrinsics();
+
+	// Pooled cameras have no bound target; their next capture borrows one of the new size
+	UTextureRenderTarget2D* RgbRT = Camera->TextureTarget;
+	if (RgbRT && (RgbRT->SizeX != Intrinsics.ImageWidth || RgbRT->SizeY != Intrinsics.ImageHeight))
+	{
+		RgbRT->ResizeTarget(Intrinsics.ImageWidth, Intrinsics.ImageHeight);
+	}
+
+	// The DMV copy follows the RGB camera unless it has its own depth intrinsics
+	TWeakObjectPtr<USceneCaptureComponent2D>* DmvCameraPtr = Camera->HasSeparateDepthIntrinsics() ? nullptr : DmvCameras.Find(Camera);
+	if (UIntrinsicSceneCaptureComponent2D* DmvCamera = DmvCameraPtr ? Cast<UIntrinsicSceneCaptureComponent2D>(DmvCameraPtr->Get()) : nullptr)
+	{
+		DmvCamera->bUseCustomIntrinsics = true;
+		DmvCamera->bUseIntrinsicsAsset = false;
+		DmvCamera->InlineIntrinsics = Camera->InlineIntrinsics;
+		DmvCamera->ApplyIntrinsics();
+
+		UTextureRenderTarget2D* DmvRT = DmvCamera->TextureTarget;
+		if (DmvRT && (DmvRT->SizeX != Intrinsics.ImageWidth || DmvRT->SizeY != Intrinsics.ImageHeight))
+		{
+			DmvRT->ResizeTarget(Intrinsics.ImageWidth, Intrinsics.ImageHeight);
+		}
+	}
+
+	// Pick up the new render target sizes
+	RefreshKickRecord(Camera);
+}
+
+void UCameraCaptureSubsystem::NotifyCameraTargetChanged(UIntrinsicSceneCaptureComponent2D* Camera)
+{
+	FRegisteredCamera* Entry = Camera ? FindRegisteredCamera(Camera) : nullptr;
+	if (!Entry)
+	{
+		return;
+	}
+
+	// A target cleared by its owner gets a subsystem one again
+	EnsureCameraRenderTarget(*Entry, Camera);
+	RefreshKickRecord(Camera);
+}
+
+UIntrinsicSceneCaptureComponent2D* UCameraCaptureSubsystem::FindCameraByID(const FString& UniqueID) const
+{
+	const int32* Index = UniqueIDIndices.Find(UniqueID);
+	return Index ? CameraRegistry[*Index].Camera.Get() : nullptr;
+}
+
+void UCameraCaptureSubsystem::SetCameraCaptureRate(UIntrinsicSceneCaptureComponent2D* Camera, float RateHz)
+{
+	FRegisteredCamera* Entry = FindRegisteredCamera(Camera);
+	if (!Entry)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] SetCameraCaptureRate: camera not registered"));
+		return;
+	}
+
+	Camera->CaptureRateHz = FMath::Max(0.0f, RateHz);
+
+	// Restart the rate schedule so a lower rate does not wait out the old period
+	Entry->Schedule.NextCaptureTime = 0.0;
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] %s capture rate set to %.2f Hz"), *Entry->Identifier.ToString(), Camera->CaptureRateHz);
+}
+
 // ============================================================================
 // Capture Control
 // ============================================================================
@@ -381,7 +747,7 @@ void UCameraCaptureSubsystem::StartCapture()
 		return;
 	}
 
-	if (RegisteredCameras.Num() == 0)
+	if (CameraRegistry.Num() == 0)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] No cameras registered, cannot start capture"));
 		return;
@@ -389,11 +755,51 @@ void UCameraCaptureSubsystem::StartCapture()
 
 	bIsCapturing = true;
 	CurrentFrameCounter = 0;
-	TotalFramesCaptured = 0;
+	ResetStatistics();
 	FrameIdCounter = 0;
 	CaptureStartTime = FPlatformTime::Seconds();
 
-	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Started capture with %d cameras"), RegisteredCameras.Num());
+	if (bTimelineRecording)
+	{
+		BeginTimelineRecording();
+	}
+
+	if (bOfflineMode)
+	{
+		// Fixed step + seeded RNG so repeated runs produce the same frames
+		ApplyOfflineTiming();
+		FMath::RandInit(OfflineRandomSeed);
+		FMath::SRandInit(OfflineRandomSeed);
+	}
+
+	UWorld* World = GetWorld();
+	SimulationStartTime = World ? World->GetTimeSeconds() : 0.0;
+
+	if (ShardCount > 1 && ShardMode == ECaptureShardMode::TimeRange)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Time-range sharding only applies to trajectory replay and pose lists; live capture records every frame"));
+	}
+
+	// Restart every camera's schedule so rate-based cameras capture immediately
+	for (FRegisteredCamera& Entry : CameraRegistry)
+	{
+		Entry.Schedule = FCameraScheduleState();
+	}
+
+	if (bPoseRecording)
+	{
+		const FString FilePath = TrajectoryFilePath.IsEmpty() ? OutputDirectory / TEXT("trajectory.cctraj") : TrajectoryFilePath;
+
+		TrajectoryWriter = MakeUnique<FCaptureTrajectoryWriter>();
+		if (!TrajectoryWriter->Open(FilePath))
+		{
+			TrajectoryWriter.Reset();
+		}
+		LastRecordedActorTransforms.Reset();
+		LastRecordedBoneTransforms.Reset();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Started capture with %d cameras"), CameraRegistry.Num());
 	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Output directory: %s"), *OutputDirectory);
 }
 
@@ -406,18 +812,90 @@ void UCameraCaptureSubsystem::StopCapture()
 
 	bIsCapturing = false;
 
-	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Stopped capture. Total frames: %lld"), TotalFramesCaptured);
+	// Harvest the readbacks of the last kicked frames instead of leaving them to the timeout
+	if (bWaitForReadbacksOnStop)
+	{
+		DrainPendingReadbacks();
+	}
+
+	RestoreEngineTiming();
+
+	if (bShardConfigured)
+	{
+		WriteShardManifest();
+	}
+
+	if (TrajectoryWriter)
+	{
+		TrajectoryWriter->Close();
+		TrajectoryWriter.Reset();
+		LastRecordedActorTransforms.Reset();
+		LastRecordedBoneTransforms.Reset();
+	}
+
+	if (bTimelineRecording)
+	{
+		FinishTimelineRecording();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Stopped capture. Total frames: %lld, dropped: %lld"), TotalFramesCaptured, TotalFramesDropped);
 }
 
 void UCameraCaptureSubsystem::CaptureFrame()
 {
-	if (RegisteredCameras.Num() == 0)
+	if (CameraRegistry.Num() == 0)
 	{
 		UE_LOG(LogTemp, Verbose, TEXT("[CameraCaptureSubsystem] No cameras registered"));
 		return;
 	}
 
-	KickAllCaptures();
+	// Manual single-frame capture ignores per-camera schedules and throttling
+	KickAllCaptures(true);
+}
+
+void UCameraCaptureSubsystem::CaptureFrameAt(const TArray<UIntrinsicSceneCaptureComponent2D*>& Cameras, int64 FrameNumber, double Timestamp)
+{
+	if (Cameras.Num() == 0)
+	{
+		return;
+	}
+
+	if (bOfflineMode && !WaitForOfflineQueueCapacity())
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Frame %lld not captured: the pipeline made no progress for %.0fs (%d frames queued)"),
+			FrameNumber, PipelineWaitTimeoutSeconds, GetQueuedFrameCount());
+		return;
+	}
+
+	FExternalFrame& Frame = ExternalFrame.Emplace();
+	Frame.FrameNumber = FrameNumber;
+	Frame.Timestamp = Timestamp;
+	Frame.Cameras.Append(Cameras);
+
+	KickAllCaptures(true);
+
+	ExternalFrame.Reset();
+}
+
+void UCameraCaptureSubsystem::PrimeCaptureHistory(const TArray<UIntrinsicSceneCaptureComponent2D*>& Cameras)
+{
+	for (UIntrinsicSceneCaptureComponent2D* Camera : Cameras)
+	{
+		if (!Camera || !IsCameraInShard(Camera))
+		{
+			continue;
+		}
+
+		FRegisteredCamera* Entry = FindRegisteredCamera(Camera);
+		if (!Entry)
+		{
+			continue;
+		}
+
+		SetupCameraResources(*Entry);
+		EnsureCameraRenderTarget(*Entry, Camera);
+		RenderWithoutReadback(*Entry, Camera);
+	}
 }
 
 void UCameraCaptureSubsystem::SetCaptureRate(int32 InCaptureEveryNFrames)
@@ -427,587 +905,3969 @@ void UCameraCaptureSubsystem::SetCaptureRate(int32 InCaptureEveryNFrames)
 	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Set capture rate: every %d frame(s)"), CaptureEveryNFrames);
 }
 
-void UCameraCaptureSubsystem::SetOutputDirectory(const FString& Directory)
+void UCameraCaptureSubsystem::SetThrottleLimits(int32 InMaxInFlightFramesPerCamera, int32 InMaxSerializationBacklog)
 {
-	OutputDirectory = Directory;
+	MaxInFlightFramesPerCamera = FMath::Max(1, InMaxInFlightFramesPerCamera);
+	MaxSerializationBacklog = FMath::Max(1, InMaxSerializationBacklog);
 
-	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Set output directory: %s"), *OutputDirectory);
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Set throttle limits: %d in-flight frame(s) per camera, serialization backlog %d"),
+		MaxInFlightFramesPerCamera, MaxSerializationBacklog);
 }
 
-void UCameraCaptureSubsystem::SetCaptureChannels(bool bRGB, bool bDepth, bool bMotionVectors)
+void UCameraCaptureSubsystem::SetRenderThreadHarvest(bool bEnabled)
 {
-	bCaptureRGB = bRGB;
-	bCaptureDepth = bDepth;
-	bCaptureMotionVectors = bMotionVectors;
+	bRenderThreadHarvest = bEnabled;
 
-	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Set capture channels: RGB=%d, Depth=%d, Motion=%d"),
-		bRGB, bDepth, bMotionVectors);
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Readback completion %s"),
+		bEnabled ? TEXT("detected on the render thread") : TEXT("polled on the game thread"));
 }
 
-void UCameraCaptureSubsystem::SetDmvMaterial(UMaterial* Material)
+void UCameraCaptureSubsystem::SetParallelHarvest(bool bEnabled)
 {
-	if (!Material)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] SetDmvMaterial called with null material"));
-		return;
-	}
+	bParallelHarvest = bEnabled;
 
-	DmvCaptureMaterialBase = Material;
-	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Set DMV material: %s"), *Material->GetName());
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Parallel harvest %s"), bEnabled ? TEXT("enabled") : TEXT("disabled"));
+}
 
-	// If we already have registered cameras, set up their DMV cameras now
-	for (const TWeakObjectPtr<UIntrinsicSceneCaptureComponent2D>& WeakCamera : RegisteredCameras)
-	{
-		if (WeakCamera.IsValid())
-		{
-			UIntrinsicSceneCaptureComponent2D* Camera = WeakCamera.Get();
+void UCameraCaptureSubsystem::SetBroadcastUnchangedFrames(bool bEnabled)
+{
+	bBroadcastUnchangedFrames = bEnabled;
 
-			// Only set up if not already set up
-			if (!DmvCameras.Contains(Camera))
-			{
-				SetupDmvCamera(Camera);
-			}
-		}
-	}
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Unchanged records %s"),
+		bEnabled ? TEXT("broadcast to OnFrameCaptured") : TEXT("only written, not broadcast"));
 }
 
-void UCameraCaptureSubsystem::SetSerializationEnabled(bool bEnabled)
+void UCameraCaptureSubsystem::SetReadbackTimeout(float TimeoutMs)
 {
-	bSerializationEnabled = bEnabled;
+	ReadbackTimeoutMs = FMath::Max(1.0f, TimeoutMs);
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Set readback timeout: %.1fms"), ReadbackTimeoutMs);
+}
+
+void UCameraCaptureSubsystem::SetWaitForReadbacksOnStop(bool bEnabled)
+{
+	bWaitForReadbacksOnStop = bEnabled;
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Wait for readbacks on stop %s"), bEnabled ? TEXT("enabled") : TEXT("disabled"));
+}
+
+void UCameraCaptureSubsystem::SetGpuGovernor(bool bEnabled, float TargetFrameTimeMs)
+{
+	bGpuGovernorEnabled = bEnabled;
+	GovernorTargetFrameTimeMs = FMath::Max(1.0f, TargetFrameTimeMs);
+
+	// Disabling the governor restores every camera to its configured rate
+	if (!bGpuGovernorEnabled)
+	{
+		for (FRegisteredCamera& Entry : CameraRegistry)
+		{
+			Entry.Schedule.GovernorRateScale = 1.0f;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] GPU governor %s (target %.2fms)"),
+		bGpuGovernorEnabled ? TEXT("enabled") : TEXT("disabled"), GovernorTargetFrameTimeMs);
+}
+
+void UCameraCaptureSubsystem::SetOfflineMode(bool bEnabled, float FixedDeltaSeconds, int32 MaxQueuedFrames, int32 RandomSeed)
+{
+	bOfflineMode = bEnabled;
+	OfflineFixedDeltaSeconds = FMath::Max(KINDA_SMALL_NUMBER, FixedDeltaSeconds);
+	OfflineMaxQueuedFrames = FMath::Max(1, MaxQueuedFrames);
+	OfflineRandomSeed = RandomSeed;
+
+	// Apply/restore immediately if a capture is already running
+	if (bIsCapturing)
+	{
+		if (bOfflineMode)
+		{
+			ApplyOfflineTiming();
+		}
+		else
+		{
+			RestoreEngineTiming();
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Offline mode %s (step %.4fs, max %d queued frames, seed %d)"),
+		bOfflineMode ? TEXT("enabled") : TEXT("disabled"), OfflineFixedDeltaSeconds, OfflineMaxQueuedFrames, OfflineRandomSeed);
+}
+
+void UCameraCaptureSubsystem::SetPoseRecording(bool bEnabled, const FString& InTrajectoryFilePath)
+{
+	if (bIsCapturing && bEnabled != bPoseRecording)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Pose recording change takes effect at the next StartCapture"));
+	}
+
+	bPoseRecording = bEnabled;
+	TrajectoryFilePath = InTrajectoryFilePath;
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Pose recording %s%s%s"),
+		bPoseRecording ? TEXT("enabled") : TEXT("disabled"),
+		TrajectoryFilePath.IsEmpty() ? TEXT("") : TEXT(": "), *TrajectoryFilePath);
+}
+
+void UCameraCaptureSubsystem::SetOutputDirectory(const FString& Directory)
+{
+	OutputDirectory = Directory;
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Set output directory: %s"), *OutputDirectory);
+}
+
+void UCameraCaptureSubsystem::SetCaptureChannels(bool bRGB, bool bDepth, bool bMotionVectors)
+{
+	bCaptureRGB = bRGB;
+	bCaptureDepth = bDepth;
+	bCaptureMotionVectors = bMotionVectors;
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Set capture channels: RGB=%d, Depth=%d, Motion=%d"),
+		bRGB, bDepth, bMotionVectors);
+}
+
+void UCameraCaptureSubsystem::SetDmvMaterial(UMaterial* Material)
+{
+	if (!Material)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] SetDmvMaterial called with null material"));
+		return;
+	}
+
+	DmvCaptureMaterialBase = Material;
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Set DMV material: %s"), *Material->GetName());
+
+	// Registered cameras that are already set up get their DMV cameras through the setup queue
+	for (auto It = CameraRegistry.CreateIterator(); It; ++It)
+	{
+		FRegisteredCamera& Entry = *It;
+		if (Entry.bResourcesReady && Entry.Camera.IsValid() && !DmvCameras.Contains(Entry.Camera))
+		{
+			Entry.bResourcesReady = false;
+			QueueResourceSetup(FCameraHandle{ It.GetIndex(), Entry.Serial });
+		}
+	}
+}
+
+void UCameraCaptureSubsystem::SetFrameSetAssembly(bool bEnabled, ECaptureFrameSetPolicy Policy, float TimeoutMs, bool bBatchSerialization)
+{
+	// Sets in progress were assembled (and batched) under the old settings
+	FlushFrameSets(true);
+
+	bAssembleFrameSets = bEnabled;
+	FrameSetPolicy = Policy;
+	FrameSetTimeoutMs = FMath::Max(1.0f, TimeoutMs);
+	bBatchFrameSetSerialization = bBatchSerialization;
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Frame set assembly %s (%s, timeout %.1fms, batched serialization %s)"),
+		bEnabled ? TEXT("enabled") : TEXT("disabled"),
+		Policy == ECaptureFrameSetPolicy::RequireComplete ? TEXT("require complete") : TEXT("emit partial"),
+		FrameSetTimeoutMs, bBatchSerialization ? TEXT("on") : TEXT("off"));
+}
+
+void UCameraCaptureSubsystem::SetSerializationEnabled(bool bEnabled)
+{
+	bSerializationEnabled = bEnabled;
 	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Serialization %s"), bEnabled ? TEXT("enabled") : TEXT("disabled"));
 }
 
-FCaptureStatistics UCameraCaptureSubsystem::GetStatistics() const
+FCaptureStatistics UCameraCaptureSubsystem::GetStatistics() const
+{
+	return BuildStatistics(true);
+}
+
+FCaptureStatistics UCameraCaptureSubsystem::BuildStatistics(bool bLatencyPercentiles) const
+{
+	FCaptureStatistics Stats;
+	Stats.SessionSeconds = static_cast<float>(FPlatformTime::Seconds() - StatisticsResetTime);
+	Stats.TotalFramesCaptured = TotalFramesCaptured;
+	Stats.TotalFramesDropped = TotalFramesDropped;
+	Stats.AverageReadbackLatencyMs = AverageReadbackLatencyMs;
+	Stats.AverageEmitDelayMs = AverageEmitDelayMs;
+	Stats.AverageHarvestWallMs = ReadbackWatcher.IsValid() ? ReadbackWatcher->AverageHarvestWallMs.load(std::memory_order_relaxed) : 0.0f;
+	Stats.RegisteredCameraCount = CameraRegistry.Num();
+	Stats.AverageCaptureTimeMs = AverageCaptureTimeMs;
+	Stats.LastCaptureTimeMs = LastCaptureDurationMs;
+	Stats.PendingReadbackCount = PendingCaptureCount;
+	Stats.SerializationBacklog = SerializationBacklog->GetValue();
+	Stats.ThrottledPriorityClasses = ThrottledPriorityClasses;
+	Stats.FrameSetsCompleted = FrameSetsCompleted;
+	Stats.FrameSetsIncomplete = FrameSetsIncomplete;
+	Stats.GovernorFrameTimeMs = bGpuGovernorEnabled ? GovernorFrameTimeMs : 0.0f;
+	Stats.PooledRenderTargetBytes = PooledRenderTargetBytes;
+	Stats.PeakPooledRenderTargetBytes = PeakPooledRenderTargetBytes;
+	Stats.MaxPendingReadbackCount = MaxPendingCaptureCount;
+	Stats.MaxSerializationBacklog = PeakSerializationBacklog;
+
+	if (bLatencyPercentiles)
+	{
+		Stats.KickToReady = MakePercentiles(SessionCounters->KickToReady);
+		Stats.ReadyToHarvest = MakePercentiles(SessionCounters->ReadyToHarvest);
+		Stats.HarvestToWritten = MakePercentiles(SessionCounters->HarvestToWritten);
+	}
+	Stats.TotalFramesWritten = SessionCounters->FramesWritten.load(std::memory_order_relaxed);
+	Stats.TotalFramesWriteFailed = SessionCounters->WriteFailures.load(std::memory_order_relaxed);
+	Stats.TotalBytesWritten = SessionCounters->BytesWritten.load(std::memory_order_relaxed);
+	if (Stats.SessionSeconds > 0.0f)
+	{
+		Stats.WriteFramesPerSecond = Stats.TotalFramesWritten / Stats.SessionSeconds;
+		Stats.WriteMegabytesPerSecond = Stats.TotalBytesWritten / (1024.0f * 1024.0f) / Stats.SessionSeconds;
+	}
+
+	if (PixelBufferPool.IsValid())
+	{
+		const FCaptureBufferPool::FStats PoolStats = PixelBufferPool->GetStats();
+		Stats.PooledPixelBufferBytes = PoolStats.PooledBytes;
+		Stats.PeakPooledPixelBufferBytes = PoolStats.PeakPooledBytes;
+		Stats.OutstandingPixelBufferBytes = PoolStats.OutstandingBytes;
+		Stats.PixelBufferPoolHits = PoolStats.Hits;
+		Stats.PixelBufferPoolMisses = PoolStats.Misses;
+	}
+
+	Stats.MemoryBudgetBytes = MemoryTracker->GetBudgetBytes();
+	Stats.ReservedMemoryBytes = MemoryTracker->GetReservedBytes();
+	Stats.PeakReservedMemoryBytes = MemoryTracker->GetPeakReservedBytes();
+	Stats.ReadbackMemoryBytes = MemoryTracker->GetStageBytes(ECaptureMemoryStage::Readback);
+	Stats.AwaitingEmitMemoryBytes = MemoryTracker->GetStageBytes(ECaptureMemoryStage::AwaitingEmit);
+	Stats.FrameMemoryBytes = MemoryTracker->GetStageBytes(ECaptureMemoryStage::Frames);
+	Stats.QueuedForWriteMemoryBytes = MemoryTracker->GetStageBytes(ECaptureMemoryStage::QueuedForWrite);
+	Stats.EncodingMemoryBytes = MemoryTracker->GetStageBytes(ECaptureMemoryStage::Encoding);
+	Stats.MemoryBudgetOverruns = MemoryTracker->GetBudgetOverruns();
+
+	Stats.PerCamera.Reserve(CameraRegistry.Num());
+	for (const FRegisteredCamera& Entry : CameraRegistry)
+	{
+		const UIntrinsicSceneCaptureComponent2D* Camera = Entry.Camera.Get();
+		const FCameraScheduleState*				 State = &Entry.Schedule;
+		if (!Camera)
+		{
+			continue;
+		}
+
+		FCameraCaptureStatistics& CameraStats = Stats.PerCamera.AddDefaulted_GetRef();
+		CameraStats.CameraID = Entry.Identifier.UniqueID;
+		CameraStats.Priority = Camera->CapturePriority;
+		CameraStats.TargetRateHz = FMath::Max(0.0f, Camera->CaptureRateHz);
+		CameraStats.CaptureEveryNFrames = Camera->CaptureRateHz > 0.0f ? 0 : (Camera->CaptureEveryNFrames > 0 ? Camera->CaptureEveryNFrames : CaptureEveryNFrames);
+		CameraStats.AchievedRateHz = State->AchievedRateHz;
+		CameraStats.FramesKicked = State->FramesKicked;
+		CameraStats.FramesThrottled = State->FramesThrottled;
+		CameraStats.FramesOverBudget = State->FramesOverBudget;
+		CameraStats.FramesUnchanged = State->FramesUnchanged;
+		CameraStats.LastGpuTimeMs = State->LastGpuTimeMs;
+		CameraStats.AverageGpuTimeMs = State->AverageGpuTimeMs;
+		CameraStats.GpuTimersUnresolved = State->GpuTimersUnresolved;
+		CameraStats.GovernorRateScale = State->GovernorRateScale;
+		CameraStats.FramesHarvested = State->FramesHarvested;
+		CameraStats.FramesDropped = State->FramesDropped;
+		CameraStats.FramesLate = State->FramesLate;
+		CameraStats.LastReadbackLatencyMs = State->LastReadbackLatencyMs;
+		CameraStats.AverageReadbackLatencyMs = State->AverageReadbackLatencyMs;
+		CameraStats.MaxReadbackLatencyMs = State->MaxReadbackLatencyMs;
+		if (bLatencyPercentiles)
+		{
+			CameraStats.KickToReady = MakePercentiles(Entry.Counters->KickToReady);
+			CameraStats.ReadyToHarvest = MakePercentiles(Entry.Counters->ReadyToHarvest);
+			CameraStats.HarvestToWritten = MakePercentiles(Entry.Counters->HarvestToWritten);
+		}
+		CameraStats.QueueDepth = Entry.PendingQueueIndex != INDEX_NONE ? PendingQueues[Entry.PendingQueueIndex].Captures.Num() : 0;
+		CameraStats.MaxQueueDepth = State->MaxQueueDepth;
+		CameraStats.FramesWritten = Entry.Counters->FramesWritten.load(std::memory_order_relaxed);
+		CameraStats.BytesWritten = Entry.Counters->BytesWritten.load(std::memory_order_relaxed);
+		CameraStats.FramesWriteFailed = Entry.Counters->WriteFailures.load(std::memory_order_relaxed);
+
+		Stats.GpuCaptureMsPerSecond += State->AverageGpuTimeMs * State->AchievedRateHz;
+		Stats.AchievedCaptureRateHz += State->AchievedRateHz;
+		Stats.TotalFramesThrottled += State->FramesThrottled;
+		Stats.TotalGpuTimersUnresolved += State->GpuTimersUnresolved;
+		Stats.TotalFramesOverBudget += State->FramesOverBudget;
+
+		// What one RGB (+ DMV) target per camera costs, for comparison with the pool
+		if (bCaptureRGB)
+		{
+			const FCameraIntrinsics Intrinsics = Camera->GetActiveIntrinsics();
+			Stats.DedicatedRenderTargetBytes += GetRenderTargetBytes(Intrinsics.ImageWidth, Intrinsics.ImageHeight, Entry.RgbFormat);
+		}
+		if ((bCaptureDepth || bCaptureMotionVectors) && DmvCameras.Contains(Entry.Camera))
+		{
+			const FCameraIntrinsics DepthIntrinsics = Camera->GetActiveDepthIntrinsics();
+			Stats.DedicatedRenderTargetBytes += GetRenderTargetBytes(DepthIntrinsics.ImageWidth, DepthIntrinsics.ImageHeight, RTF_RGBA32f);
+		}
+	}
+
+	return Stats;
+}
+
+void UCameraCaptureSubsystem::ResetStatistics()
+{
+	TotalFramesCaptured = 0;
+	TotalFramesDropped = 0;
+	AverageReadbackLatencyMs = 0.0f;
+	AverageEmitDelayMs = 0.0f;
+	if (ReadbackWatcher.IsValid())
+	{
+		ReadbackWatcher->AverageHarvestWallMs.store(0.0f, std::memory_order_relaxed);
+	}
+	FrameSetsCompleted = 0;
+	FrameSetsIncomplete = 0;
+	MaxPendingCaptureCount = PendingCaptureCount;
+	PeakSerializationBacklog = SerializationBacklog->GetValue();
+	StatisticsResetTime = FPlatformTime::Seconds();
+
+	SessionCounters->Reset();
+	MemoryTracker->ResetPeaks();
+
+	for (FRegisteredCamera& Entry : CameraRegistry)
+	{
+		FCameraScheduleState& State = Entry.Schedule;
+		State.FramesKicked = 0;
+		State.FramesThrottled = 0;
+		State.GpuTimersUnresolved = 0;
+		State.FramesOverBudget = 0;
+		State.FramesUnchanged = 0;
+		State.FramesHarvested = 0;
+		State.FramesDropped = 0;
+		State.FramesLate = 0;
+		State.LastReadbackLatencyMs = 0.0f;
+		State.AverageReadbackLatencyMs = 0.0f;
+		State.MaxReadbackLatencyMs = 0.0f;
+		State.MaxQueueDepth = 0;
+
+		Entry.Counters->Reset();
+	}
+}
+
+void UCameraCaptureSubsystem::PrintStatistics(const FCaptureStatistics& Stats, FOutputDevice& Ar, bool bDetailed)
+{
+	Ar.Logf(TEXT("CameraCapture: %d cameras, %.1fs session, %.1f Hz achieved"),
+		Stats.RegisteredCameraCount, Stats.SessionSeconds, Stats.AchievedCaptureRateHz);
+	Ar.Logf(TEXT("  Frames: %lld captured, %lld written, %lld dropped, %lld throttled, %lld write failures"),
+		Stats.TotalFramesCaptured, Stats.TotalFramesWritten, Stats.TotalFramesDropped, Stats.TotalFramesThrottled, Stats.TotalFramesWriteFailed);
+	Ar.Logf(TEXT("  Queues: %d readbacks in flight (max %d), %d frames in writer backlog (max %d)"),
+		Stats.PendingReadbackCount, Stats.MaxPendingReadbackCount, Stats.SerializationBacklog, Stats.MaxSerializationBacklog);
+	Ar.Logf(TEXT("  Memory: %.1f MB reserved of %s (peak %.1f MB), %lld over budget, %lld overruns"),
+		Stats.ReservedMemoryBytes / (1024.0 * 1024.0),
+		Stats.MemoryBudgetBytes > 0 ? *FString::Printf(TEXT("%.1f MB"), Stats.MemoryBudgetBytes / (1024.0 * 1024.0)) : TEXT("unlimited"),
+		Stats.PeakReservedMemoryBytes / (1024.0 * 1024.0), Stats.TotalFramesOverBudget, Stats.MemoryBudgetOverruns);
+	Ar.Logf(TEXT("  Memory by stage MB: readback %.1f, awaiting emit %.1f, frames %.1f (%.1f queued for write), encoding %.1f"),
+		Stats.ReadbackMemoryBytes / (1024.0 * 1024.0), Stats.AwaitingEmitMemoryBytes / (1024.0 * 1024.0), Stats.FrameMemoryBytes / (1024.0 * 1024.0),
+		Stats.QueuedForWriteMemoryBytes / (1024.0 * 1024.0), Stats.EncodingMemoryBytes / (1024.0 * 1024.0));
+	Ar.Logf(TEXT("  Cost: %.2f ms CPU per kick, %.1f GPU ms/s, writer %.1f fps / %.1f MB/s"),
+		Stats.AverageCaptureTimeMs, Stats.GpuCaptureMsPerSecond, Stats.WriteFramesPerSecond, Stats.WriteMegabytesPerSecond);
+	Ar.Logf(TEXT("  Latency p50/p95/p99 ms: kick->ready %.1f/%.1f/%.1f, ready->harvest %.1f/%.1f/%.1f, harvest->written %.1f/%.1f/%.1f"),
+		Stats.KickToReady.P50Ms, Stats.KickToReady.P95Ms, Stats.KickToReady.P99Ms,
+		Stats.ReadyToHarvest.P50Ms, Stats.ReadyToHarvest.P95Ms, Stats.ReadyToHarvest.P99Ms,
+		Stats.HarvestToWritten.P50Ms, Stats.HarvestToWritten.P95Ms, Stats.HarvestToWritten.P99Ms);
+
+	for (const FCameraCaptureStatistics& Camera : Stats.PerCamera)
+	{
+		if (!bDetailed)
+		{
+			Ar.Logf(TEXT("  %-40s %6.1f/%6.1f Hz  in flight %2d  dropped %lld  GPU %.2f ms"),
+				*Camera.CameraID, Camera.AchievedRateHz, Camera.TargetRateHz, Camera.QueueDepth, Camera.FramesDropped, Camera.AverageGpuTimeMs);
+			continue;
+		}
+
+		Ar.Logf(TEXT("  %s (priority %d)"), *Camera.CameraID, static_cast<int32>(Camera.Priority));
+		Ar.Logf(TEXT("    Rate: %.2f Hz achieved, target %.2f Hz / every %d frames, governor x%.2f"),
+			Camera.AchievedRateHz, Camera.TargetRateHz, Camera.CaptureEveryNFrames, Camera.GovernorRateScale);
+		Ar.Logf(TEXT("    Frames: %lld kicked, %lld harvested, %lld written, %lld unchanged, %lld throttled, %lld over budget, %lld dropped, %lld late, %lld write failures"),
+			Camera.FramesKicked, Camera.FramesHarvested, Camera.FramesWritten, Camera.FramesUnchanged, Camera.FramesThrottled,
+			Camera.FramesOverBudget, Camera.FramesDropped, Camera.FramesLate, Camera.FramesWriteFailed);
+		Ar.Logf(TEXT("    Queue: %d in flight (max %d), %.1f MB written"),
+			Camera.QueueDepth, Camera.MaxQueueDepth, Camera.BytesWritten / (1024.0 * 1024.0));
+		Ar.Logf(TEXT("    GPU: %.2f ms last, %.2f ms average"), Camera.LastGpuTimeMs, Camera.AverageGpuTimeMs);
+		Ar.Logf(TEXT("    Latency p50/p95/p99/max ms: kick->ready %.1f/%.1f/%.1f/%.1f, ready->harvest %.1f/%.1f/%.1f/%.1f, harvest->written %.1f/%.1f/%.1f/%.1f"),
+			Camera.KickToReady.P50Ms, Camera.KickToReady.P95Ms, Camera.KickToReady.P99Ms, Camera.KickToReady.MaxMs,
+			Camera.ReadyToHarvest.P50Ms, Camera.ReadyToHarvest.P95Ms, Camera.ReadyToHarvest.P99Ms, Camera.ReadyToHarvest.MaxMs,
+			Camera.HarvestToWritten.P50Ms, Camera.HarvestToWritten.P95Ms, Camera.HarvestToWritten.P99Ms, Camera.HarvestToWritten.MaxMs);
+	}
+}
+
+void UCameraCaptureSubsystem::SetMetricsExport(bool bEnabled, const FString& FilePath, float IntervalSeconds)
+{
+	bMetricsExportFromCommandLine = false;
+	if (MetricsExporter.IsValid())
+	{
+		// Let the last file reflect the final counters before the writer goes away
+		MetricsExporter->Wait();
+		ExportMetrics();
+		MetricsExporter->Wait();
+		MetricsExporter.Reset();
+	}
+
+	if (!bEnabled)
+	{
+		return;
+	}
+
+	const FString Path = FilePath.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("Metrics") / TEXT("camera_capture.prom") : FPaths::ConvertRelativePathToFull(FilePath);
+	MetricsExporter = MakeShared<FCaptureMetricsExporter, ESPMode::ThreadSafe>(Path);
+	MetricsExportIntervalSeconds = FMath::Max(IntervalSeconds, 0.1f);
+	NextMetricsExportTime = 0.0;
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Exporting metrics to %s every %.1fs"), *Path, MetricsExportIntervalSeconds);
+}
+
+void UCameraCaptureSubsystem::RestoreCommandLineMetricsExport()
+{
+	if (bMetricsExportFromCommandLine)
+	{
+		return;
+	}
+
+	SetMetricsExport(!CommandLineMetricsFile.IsEmpty(), CommandLineMetricsFile, CommandLineMetricsInterval);
+	bMetricsExportFromCommandLine = !CommandLineMetricsFile.IsEmpty();
+}
+
+void UCameraCaptureSubsystem::ExportMetrics()
+{
+	if (!MetricsExporter.IsValid())
+	{
+		return;
+	}
+
+	NextMetricsExportTime = FPlatformTime::Seconds() + MetricsExportIntervalSeconds;
+
+	// Only the scalars are gathered here; the worker reads the histograms directly
+	FCaptureMetricsExporter::FSnapshot Snapshot;
+	Snapshot.Stats = BuildStatistics(false);
+	Snapshot.SessionCounters = SessionCounters;
+	Snapshot.CameraCounters.Reserve(Snapshot.Stats.PerCamera.Num());
+	for (const FCameraCaptureStatistics& Camera : Snapshot.Stats.PerCamera)
+	{
+		TSharedPtr<FCapturePipelineCounters, ESPMode::ThreadSafe> Counters;
+		if (const int32* Index = UniqueIDIndices.Find(Camera.CameraID))
+		{
+			Counters = CameraRegistry[*Index].Counters;
+		}
+		Snapshot.CameraCounters.Add(Counters);
+	}
+
+	MetricsExporter->ExportAsync(MoveTemp(Snapshot));
+}
+
+void UCameraCaptureSubsystem::SetTimelineRecording(bool bEnabled, const FString& FilePath)
+{
+	TimelineFilePath = FilePath;
+	if (bEnabled == bTimelineRecording)
+	{
+		return;
+	}
+
+	bTimelineRecording = bEnabled;
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Timeline recording %s"), bEnabled ? TEXT("enabled") : TEXT("disabled"));
+
+	// Takes effect immediately on a running capture; the trace then covers only part of it
+	if (bIsCapturing)
+	{
+		if (bEnabled)
+		{
+			BeginTimelineRecording();
+		}
+		else
+		{
+			FinishTimelineRecording();
+		}
+	}
+}
+
+void UCameraCaptureSubsystem::BeginTimelineRecording()
+{
+	if (TimelineWrite.IsValid())
+	{
+		TimelineWrite.Wait();
+	}
+	FCaptureTimeline::Start();
+}
+
+void UCameraCaptureSubsystem::FinishTimelineRecording()
+{
+	const FString FilePath = TimelineFilePath.IsEmpty() ? GetAbsoluteOutputDirectory() / TEXT("capture_timeline.json") : TimelineFilePath;
+
+	// Frames already handed to the writer still record their write spans (after their last
+	// file, which may be on the ImageWriteQueue); let them land first
+	TimelineWrite = Async(EAsyncExecution::Thread, [TimelineWrites = PendingTimelineWrites, FilePath]() {
+		WaitUntil([&TimelineWrites]() { return TimelineWrites->GetValue() == 0; }, TimelineDrainTimeoutSeconds);
+		FCaptureTimeline::StopAndWrite(FilePath);
+	});
+}
+
+FCaptureLatencyPercentiles UCameraCaptureSubsystem::MakePercentiles(const FCaptureLatencyHistogram& Histogram)
+{
+	FCaptureLatencyPercentiles Percentiles;
+	Percentiles.Count = Histogram.GetCount();
+	Percentiles.MeanMs = static_cast<float>(Histogram.GetMeanMs());
+	Percentiles.P50Ms = static_cast<float>(Histogram.GetPercentileMs(50.0));
+	Percentiles.P95Ms = static_cast<float>(Histogram.GetPercentileMs(95.0));
+	Percentiles.P99Ms = static_cast<float>(Histogram.GetPercentileMs(99.0));
+	Percentiles.MaxMs = static_cast<float>(Histogram.GetMaxMs());
+	return Percentiles;
+}
+
+// ============================================================================
+// Legacy wrapper
+// ============================================================================
+
+void UCameraCaptureSubsystem::ExecuteSynchronizedCapture()
+{
+	KickAllCaptures();
+}
+
+// ============================================================================
+// Phase 1: Kick all scene captures + enqueue async GPU readbacks
+// ============================================================================
+
+void UCameraCaptureSubsystem::KickAllCaptures(bool bForceAll)
+{
+	double StartTime = FPlatformTime::Seconds();
+	int32  KickedCount = 0;
+
+	const double Now = GetCaptureTime();
+
+	// Decide once per kick how many priority classes are throttled by current pressure
+	ThrottledPriorityClasses = bForceAll ? 0 : ComputeThrottledPriorityClasses();
+
+	// Movable actor snapshots are gathered lazily by the first change-driven camera
+	bMovableActorSnapshotsValid = false;
+
+	// Advance the render target pool's idle clock
+	RenderTargetPoolKicks++;
+
+	// Pose-only recording replaces rendering with appending transforms to the trajectory
+	const bool bRecordPoses = TrajectoryWriter.IsValid() && !ExternalFrame.IsSet();
+	if (bRecordPoses)
+	{
+		TrajectoryWriter->BeginFrame(FrameIdCounter, Now);
+	}
+
+	if (bKickListDirty)
+	{
+		RebuildKickList();
+	}
+
+	// Offline and explicit captures can't be skipped for memory, so they wait for it like Block.
+	// Waiting emits frames, whose listeners may change the registry.
+	const bool bMustCapture = bForceAll || bOfflineMode;
+	if (!bRecordPoses && (bMustCapture || MemoryOverflowPolicy == ECaptureMemoryOverflowPolicy::Block))
+	{
+		WaitForCaptureMemory();
+		if (bKickListDirty)
+		{
+			RebuildKickList();
+		}
+	}
+
+	// Frame number BuildCaptureMetadata assigns this kick (for trace spans)
+	const int64 KickFrameNumber = ExternalFrame.IsSet() ? ExternalFrame->FrameNumber : FrameIdCounter;
+
+	for (FCaptureKickRecord& Record : KickList)
+	{
+		UIntrinsicSceneCaptureComponent2D* Camera = Record.Camera;
+		FRegisteredCamera&				   Entry = CameraRegistry[Record.RegistryIndex];
+
+		// Cameras outside game worlds don't announce unregistering; the next rebuild drops them
+		if (!IsValid(Camera))
+		{
+			bKickListDirty = true;
+			continue;
+		}
+
+		FCameraScheduleState& Schedule = Entry.Schedule;
+
+		// Set when change-driven capture compared this camera's view; committed once it is kicked
+		TOptional<FViewSignature> ViewSignature;
+
+		if ((ExternalFrame.IsSet() && !ExternalFrame->Cameras.Contains(Camera)) || !IsCameraInShard(Camera))
+		{
+			continue;
+		}
+
+		// Live capture waits for the setup queue; explicit and offline captures can't skip a camera
+		if (!Entry.bResourcesReady && !bRecordPoses)
+		{
+			if (!bForceAll && !bOfflineMode)
+			{
+				continue;
+			}
+			SetupCameraResources(Entry);
+		}
+
+		// Update the achieved-rate window (also lets idle cameras decay to 0 Hz)
+		if (Now - Schedule.RateWindowStart >= RateWindowSeconds)
+		{
+			Schedule.AchievedRateHz = static_cast<float>(Schedule.RateWindowKicks / (Now - Schedule.RateWindowStart));
+			Schedule.RateWindowKicks = 0;
+			Schedule.RateWindowStart = Now;
+		}
+
+		if (!bForceAll)
+		{
+			// Offline mode captures every camera on every step; schedules only pace live capture
+			if (!bOfflineMode && !IsCameraDue(Camera, Schedule, Now))
+			{
+				continue;
+			}
+
+			// Critical cameras are never throttled; the others drop out lowest class first
+			if (Camera->CapturePriority != ECameraCapturePriority::Critical
+				&& static_cast<int32>(Camera->CapturePriority) < ThrottledPriorityClasses)
+			{
+				Schedule.FramesThrottled++;
+				continue;
+			}
+
+			// Change-driven capture: emit a metadata-only record instead of re-rendering
+			if (Camera->bSkipUnchangedFrames && !bRecordPoses && ShouldSkipUnchanged(Camera, Schedule, ViewSignature.Emplace()))
+			{
+				FPendingCameraCapture Unchanged;
+				Unchanged.Metadata = BuildCaptureMetadata(Camera);
+				Unchanged.Camera = FCameraHandle{ Record.RegistryIndex, Entry.Serial };
+				Unchanged.KickTime = FPlatformTime::Seconds();
+				Unchanged.Metadata.bUnchanged = true;
+				Unchanged.Metadata.ReferenceFrameNumber = Schedule.LastCapturedFrameNumber;
+
+				// No readbacks — harvested (in order) on the next poll
+				EnqueuePendingCapture(Entry, MoveTemp(Unchanged));
+				KickedCount++;
+
+				Schedule.FramesUnchanged++;
+				Schedule.ConsecutiveSkippedFrames++;
+				Schedule.RateWindowKicks++;
+				continue;
+			}
+		}
+
+		if (bRecordPoses)
+		{
+			TrajectoryWriter->AddCameraPose(Entry.Identifier.UniqueID, Camera->GetComponentTransform());
+			KickedCount++;
+			TotalFramesCaptured++;
+
+			Schedule.FramesKicked++;
+			Schedule.RateWindowKicks++;
+			Schedule.LastCapturedFrameNumber = FrameIdCounter;
+			continue;
+		}
+
+		// Admit the capture against the memory budget before anything is allocated for it
+		int64								   PlaneBytes = 0;
+		FCaptureMemoryTracker::FReservationPtr Reservation = ReserveCaptureMemory(EstimateCaptureBytes(Record, PlaneBytes), bMustCapture);
+		if (!Reservation)
+		{
+			Schedule.FramesOverBudget++;
+			continue;
+		}
+
+		CAMERA_CAPTURE_SCOPE(STAT_CameraCapture_Kick, "Kick", Entry.TraceName, KickFrameNumber);
+
+		// Build metadata snapshot (cheap — no pixel data)
+		FPendingCameraCapture Pending;
+		Pending.Metadata = BuildCaptureMetadata(Camera);
+		Pending.Camera = FCameraHandle{ Record.RegistryIndex, Entry.Serial };
+
+		// Bracket this camera's GPU work (both captures + staging copies) with timestamps
+		TSharedPtr<FCaptureGpuTimer, ESPMode::ThreadSafe> GpuTimer = BeginGpuTimer();
+
+		TSharedRef<FReadbackCompletion, ESPMode::ThreadSafe> Completion = MakeShared<FReadbackCompletion, ESPMode::ThreadSafe>();
+		Completion->BufferPool = PixelBufferPool;
+		Completion->CameraID = Entry.TraceName;
+		Completion->FrameNumber = Pending.Metadata.FrameNumber;
+		Completion->MemoryReservation = MoveTemp(Reservation);
+		Completion->ReadbackBytes = PlaneBytes;
+		MemoryTracker->AddStageBytes(ECaptureMemoryStage::Readback, PlaneBytes);
+
+		// --- Kick RGB capture + enqueue async readback ---
+		// Pooled targets go back to the pool once the copy is enqueued
+		if (bCaptureRGB)
+		{
+			UTextureRenderTarget2D* RgbTarget = Record.bPooledRgb
+				? BindPooledTarget(Camera, Record.RgbWidth, Record.RgbHeight, Record.RgbFormat)
+				: Record.RgbTarget;
+
+			if (RgbTarget)
+			{
+				Camera->CaptureScene();
+
+				Completion->RgbReadback.Width = Record.RgbWidth;
+				Completion->RgbReadback.Height = Record.RgbHeight;
+				Completion->RgbReadback.bIsFloat = Record.bRgbIsFloat;
+				Pending.Metadata.Width = Record.RgbWidth;
+				Pending.Metadata.Height = Record.RgbHeight;
+
+				EnqueueAsyncReadback(RgbTarget, Completion->RgbReadback.Readback);
+				Completion->bHasRgb = true;
+			}
+
+			if (Record.bPooledRgb)
+			{
+				UnbindPooledTarget(Camera);
+			}
+		}
+
+		// --- Kick DMV capture + enqueue async readback ---
+		USceneCaptureComponent2D* DmvCamera = Record.DmvCamera;
+		if ((bCaptureDepth || bCaptureMotionVectors) && DmvCamera)
+		{
+			UTextureRenderTarget2D* DmvTarget = bPoolRenderTargets
+				? BindPooledTarget(DmvCamera, Record.DmvWidth, Record.DmvHeight, RTF_RGBA32f)
+				: Record.DmvTarget;
+
+			DmvCamera->CaptureScene();
+
+			if (DmvTarget)
+			{
+				Completion->DmvReadback.Width = Record.DmvWidth;
+				Completion->DmvReadback.Height = Record.DmvHeight;
+				Completion->DmvReadback.bIsFloat = true; // DMV is always RGBA32f
+
+				EnqueueAsyncReadback(DmvTarget, Completion->DmvReadback.Readback);
+				Completion->bHasDmv = true;
+			}
+
+			if (bPoolRenderTargets)
+			{
+				UnbindPooledTarget(DmvCamera);
+			}
+		}
+
+		EndGpuTimer(GpuTimer);
+		Pending.KickTime = FPlatformTime::Seconds();
+
+		// If neither RGB nor DMV was kicked, skip enqueueing this capture
+		// (should be rare since RGB is usually enabled, but just in case)
+		if (!Completion->bHasRgb && !Completion->bHasDmv)
+		{
+			continue;
+		}
+
+		Pending.Readback = Completion;
+		if (bRenderThreadHarvest && ReadbackWatcher.IsValid())
+		{
+			WatchReadback(Completion);
+		}
+
+		// Only enqueue a pending capture if at least one channel was actually
+		// kicked
+		const int64 KickedFrameNumber = EnqueuePendingCapture(Entry, MoveTemp(Pending)).Metadata.FrameNumber;
+		KickedCount++;
+
+		Schedule.FramesKicked++;
+		Schedule.RateWindowKicks++;
+		Schedule.LastCapturedFrameNumber = KickedFrameNumber;
+
+		// Only a capture that was actually kicked becomes the reference for unchanged records
+		if (ViewSignature.IsSet())
+		{
+			CommitViewSignature(Schedule, *ViewSignature);
+		}
+
+		if (GpuTimer.IsValid())
+		{
+			OutstandingGpuTimers.Add({ FCameraHandle{ Record.RegistryIndex, Entry.Serial }, GpuTimer.ToSharedRef() });
+		}
+	}
+
+	for (int64 DroppedFrameNumber : FrameSetViewsDroppedOverBudget)
+	{
+		ResolveFrameSetView(DroppedFrameNumber, nullptr);
+	}
+	FrameSetViewsDroppedOverBudget.Reset();
+
+	if (bRecordPoses)
+	{
+		if (KickedCount > 0)
+		{
+			RecordMovingActorPoses();
+		}
+		TrajectoryWriter->EndFrame();
+	}
+
+	// Frame numbers identify kicks that actually captured something
+	if (KickedCount == 0)
+	{
+		return;
+	}
+
+	// Replayed frames keep their recorded numbers; later live frames continue after them
+	FrameIdCounter = ExternalFrame.IsSet() ? FMath::Max(FrameIdCounter, ExternalFrame->FrameNumber + 1) : FrameIdCounter + 1;
+
+	double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	LastCaptureDurationMs = static_cast<float>(ElapsedMs);
+
+	// Running average
+	if (AverageCaptureTimeMs == 0.0f)
+	{
+		AverageCaptureTimeMs = LastCaptureDurationMs;
+	}
+	else
+	{
+		AverageCaptureTimeMs = AverageCaptureTimeMs * 0.9f + LastCaptureDurationMs * 0.1f;
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("[CameraCaptureSubsystem] Kicked %d cameras in %.2fms (frame %lld, pending: %d)"),
+		KickedCount, ElapsedMs, FrameIdCounter, PendingCaptureCount);
+}
+
+bool UCameraCaptureSubsystem::IsCameraDue(const UIntrinsicSceneCaptureComponent2D* Camera, FCameraScheduleState& State, double Now) const
+{
+	if (Camera->CaptureRateHz > 0.0f)
+	{
+		if (Now < State.NextCaptureTime)
+		{
+			return false;
+		}
+
+		// Advance by one period; resync if we fell more than a period behind so a
+		// stalled camera does not burst to catch up
+		const double Period = 1.0 / (Camera->CaptureRateHz * State.GovernorRateScale);
+		State.NextCaptureTime += Period;
+		if (State.NextCaptureTime < Now)
+		{
+			State.NextCaptureTime = Now + Period;
+		}
+		return true;
+	}
+
+	const int32 ConfiguredEveryN = Camera->CaptureEveryNFrames > 0 ? Camera->CaptureEveryNFrames : CaptureEveryNFrames;
+	const int32 EveryN = FMath::Max(1, FMath::CeilToInt(ConfiguredEveryN / State.GovernorRateScale));
+	return CurrentFrameCounter % EveryN == 0;
+}
+
+int32 UCameraCaptureSubsystem::ComputeThrottledPriorityClasses() const
+{
+	// Offline mode waits for capacity instead; throttling would break reproducibility
+	if (bOfflineMode)
+	{
+		return 0;
+	}
+
+	// Pressure is the worse of GPU readback backlog and serializer backlog,
+	// normalised so 1.0 means "at the configured limit"
+	const float GpuPressure = static_cast<float>(PendingCaptureCount) / static_cast<float>(FMath::Max(1, CameraRegistry.Num() * MaxInFlightFramesPerCamera));
+	const float SerializationPressure = static_cast<float>(SerializationBacklog->GetValue()) / static_cast<float>(MaxSerializationBacklog);
+	const float Pressure = FMath::Max(GpuPressure, SerializationPressure);
+
+	if (Pressure >= 2.0f)
+	{
+		return 3; // Low, Normal and High
+	}
+	if (Pressure >= 1.5f)
+	{
+		return 2; // Low and Normal
+	}
+	if (Pressure >= 1.0f)
+	{
+		return 1; // Low only
+	}
+	return 0;
+}
+
+// ============================================================================
+// GPU Timing + Governor
+// ============================================================================
+
+TSharedPtr<UCameraCaptureSubsystem::FCaptureGpuTimer, ESPMode::ThreadSafe> UCameraCaptureSubsystem::BeginGpuTimer()
+{
+	if (!GSupportsTimestampRenderQueries)
+	{
+		return nullptr;
+	}
+
+	// Two timestamps per camera per kick: reuse queries instead of creating them every time
+	if (!GpuTimerQueryPool.IsValid())
+	{
+		GpuTimerQueryPool = RHICreateRenderQueryPool(RQT_AbsoluteTime);
+	}
+
+	TSharedPtr<FCaptureGpuTimer, ESPMode::ThreadSafe> Timer = MakeShared<FCaptureGpuTimer, ESPMode::ThreadSafe>();
+	Timer->QueryPool = GpuTimerQueryPool;
+
+	ENQUEUE_RENDER_COMMAND(CameraCaptureBeginGpuTimer)
+	(
+		[Timer](FRHICommandListImmediate& RHICmdList) {
+			Timer->BeginQuery = Timer->QueryPool->AllocateQuery();
+			RHICmdList.EndRenderQuery(Timer->BeginQuery.GetQuery());
+		});
+
+	return Timer;
+}
+
+void UCameraCaptureSubsystem::EndGpuTimer(const TSharedPtr<FCaptureGpuTimer, ESPMode::ThreadSafe>& Timer)
+{
+	if (!Timer.IsValid())
+	{
+		return;
+	}
+
+	ENQUEUE_RENDER_COMMAND(CameraCaptureEndGpuTimer)
+	(
+		[Timer](FRHICommandListImmediate& RHICmdList) {
+			Timer->EndQuery = Timer->QueryPool->AllocateQuery();
+			RHICmdList.EndRenderQuery(Timer->EndQuery.GetQuery());
+		});
+}
+
+void UCameraCaptureSubsystem::ResolveGpuTimers()
+{
+	if (OutstandingGpuTimers.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<TSharedRef<FCaptureGpuTimer, ESPMode::ThreadSafe>> TimersToResolve;
+	TArray<TSharedRef<FCaptureGpuTimer, ESPMode::ThreadSafe>> TimersToRelease;
+
+	for (int32 i = OutstandingGpuTimers.Num() - 1; i >= 0; --i)
+	{
+		FOutstandingGpuTimer& Entry = OutstandingGpuTimers[i];
+
+		const float GpuTimeMs = Entry.Timer->GpuTimeMs.load();
+		if (GpuTimeMs >= 0.0f)
+		{
+			if (FRegisteredCamera* Registered = FindRegisteredCamera(Entry.Camera))
+			{
+				FCameraScheduleState& State = Registered->Schedule;
+				State.LastGpuTimeMs = GpuTimeMs;
+				State.AverageGpuTimeMs = State.AverageGpuTimeMs == 0.0f ? GpuTimeMs : State.AverageGpuTimeMs * 0.9f + GpuTimeMs * 0.1f;
+			}
+			OutstandingGpuTimers.RemoveAtSwap(i);
+			continue;
+		}
+
+		if (++Entry.FramesWaiting > MaxGpuTimerWaitFrames)
+		{
+			// The camera's GPU time only averages resolved timers; count the gaps so they show
+			FRegisteredCamera* Registered = FindRegisteredCamera(Entry.Camera);
+			if (Registered)
+			{
+				Registered->Schedule.GpuTimersUnresolved++;
+			}
+			if (!bLoggedUnresolvedGpuTimer)
+			{
+				bLoggedUnresolvedGpuTimer = true;
+				UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] GPU timer for %s not resolved after %d ticks, discarding (further discards are counted in GpuTimersUnresolved)"),
+					Registered ? *Registered->Identifier.UniqueID : TEXT("unregistered camera"), MaxGpuTimerWaitFrames);
+			}
+
+			TimersToRelease.Add(Entry.Timer);
+			OutstandingGpuTimers.RemoveAtSwap(i);
+			continue;
+		}
+
+		// Only one resolve request per timer in flight at a time
+		if (!Entry.Timer->bResolveQueued.exchange(true))
+		{
+			TimersToResolve.Add(Entry.Timer);
+		}
+	}
+
+	ReleaseGpuTimerQueries(MoveTemp(TimersToRelease));
+
+	if (TimersToResolve.Num() == 0)
+	{
+		return;
+	}
+
+	ENQUEUE_RENDER_COMMAND(CameraCaptureResolveGpuTimers)
+	(
+		[Timers = MoveTemp(TimersToResolve)](FRHICommandListImmediate& RHICmdList) {
+			for (const TSharedRef<FCaptureGpuTimer, ESPMode::ThreadSafe>& Timer : Timers)
+			{
+				// Non-blocking: timestamps are in microseconds once available
+				uint64 BeginMicroseconds = 0;
+				uint64 EndMicroseconds = 0;
+				if (Timer->BeginQuery.IsValid() && Timer->EndQuery.IsValid()
+					&& RHIGetRenderQueryResult(Timer->BeginQuery.GetQuery(), BeginMicroseconds, false)
+					&& RHIGetRenderQueryResult(Timer->EndQuery.GetQuery(), EndMicroseconds, false))
+				{
+					const uint64 ElapsedMicroseconds = EndMicroseconds > BeginMicroseconds ? EndMicroseconds - BeginMicroseconds : 0;
+					Timer->GpuTimeMs = static_cast<float>(ElapsedMicroseconds) / 1000.0f;
+
+					// Read: the queries can serve the next kick
+					Timer->BeginQuery.ReleaseQuery();
+					Timer->EndQuery.ReleaseQuery();
+				}
+				else
+				{
+					// Not ready yet — allow the game thread to ask again next tick
+					Timer->bResolveQueued = false;
+				}
+			}
+		});
+}
+
+void UCameraCaptureSubsystem::ReleaseGpuTimerQueries(TArray<TSharedRef<FCaptureGpuTimer, ESPMode::ThreadSafe>>&& Timers)
+{
+	if (Timers.Num() == 0)
+	{
+		return;
+	}
+
+	// The pool is not thread-safe; it is only touched on the render thread
+	ENQUEUE_RENDER_COMMAND(CameraCaptureReleaseGpuTimers)
+	(
+		[Timers = MoveTemp(Timers)](FRHICommandListImmediate& RHICmdList) {
+			for (const TSharedRef<FCaptureGpuTimer, ESPMode::ThreadSafe>& Timer : Timers)
+			{
+				Timer->BeginQuery.ReleaseQuery();
+				Timer->EndQuery.ReleaseQuery();
+			}
+		});
+}
+
+void UCameraCaptureSubsystem::UpdateGpuGovernor()
+{
+	if (!bGpuGovernorEnabled || !bIsCapturing || bOfflineMode)
+	{
+		return;
+	}
+
+	const double Now = GetCaptureTime();
+	if (Now - LastGovernorUpdateTime < GovernorIntervalSeconds)
+	{
+		return;
+	}
+	LastGovernorUpdateTime = Now;
+
+	// The frame is bound by the slowest of GPU, render thread and game thread
+	const float GpuFrameMs = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+	const float RenderThreadMs = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+	const float GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	GovernorFrameTimeMs = FMath::Max3(GpuFrameMs, RenderThreadMs, GameThreadMs);
+
+	const bool bOverBudget = GovernorFrameTimeMs > GovernorTargetFrameTimeMs;
+	const bool bHasHeadroom = GovernorFrameTimeMs < GovernorTargetFrameTimeMs * GovernorHeadroomFraction;
+	if (!bOverBudget && !bHasHeadroom)
+	{
+		return;
+	}
+
+	// Over budget: slow down the cheapest-to-lose camera (lowest priority, then most GPU time).
+	// Headroom: restore the most important throttled camera first (highest priority, then least GPU time).
+	UIntrinsicSceneCaptureComponent2D* BestCamera = nullptr;
+	FCameraScheduleState*			   BestState = nullptr;
+
+	for (FRegisteredCamera& Entry : CameraRegistry)
+	{
+		UIntrinsicSceneCaptureComponent2D* Camera = Entry.Camera.Get();
+		FCameraScheduleState&			   State = Entry.Schedule;
+		if (!Camera || Camera->CapturePriority == ECameraCapturePriority::Critical)
+		{
+			continue;
+		}
+
+		if (bOverBudget ? State.GovernorRateScale <= MinGovernorRateScale : State.GovernorRateScale >= 1.0f)
+		{
+			continue;
+		}
+
+		if (!BestCamera)
+		{
+			BestCamera = Camera;
+			BestState = &State;
+			continue;
+		}
+
+		const int32 Priority = static_cast<int32>(Camera->CapturePriority);
+		const int32 BestPriority = static_cast<int32>(BestCamera->CapturePriority);
+		const bool	bBetter = bOverBudget
+			 ? (Priority < BestPriority || (Priority == BestPriority && State.AverageGpuTimeMs > BestState->AverageGpuTimeMs))
+			 : (Priority > BestPriority || (Priority == BestPriority && State.AverageGpuTimeMs < BestState->AverageGpuTimeMs));
+		if (bBetter)
+		{
+			BestCamera = Camera;
+			BestState = &State;
+		}
+	}
+
+	if (!BestState)
+	{
+		return;
+	}
+
+	BestState->GovernorRateScale = bOverBudget
+		? FMath::Max(MinGovernorRateScale, BestState->GovernorRateScale * 0.5f)
+		: FMath::Min(1.0f, BestState->GovernorRateScale * 2.0f);
+
+	UE_LOG(LogTemp, Verbose, TEXT("[CameraCaptureSubsystem] Governor: frame %.2fms (target %.2fms), %s rate scale -> %.3f"),
+		GovernorFrameTimeMs, GovernorTargetFrameTimeMs, *BestCamera->GetName(), BestState->GovernorRateScale);
+}
+
+// ============================================================================
+// Pose Recording
+// ============================================================================
+
+void UCameraCaptureSubsystem::RecordMovingActorPoses()
+{
+	if (!TrajectoryWriter)
+	{
+		return;
+	}
+
+	// The actor set change-driven capture keeps current (see IsTrackedSceneActor) already
+	// holds every movable actor and every skeletal mesh, so nothing is rescanned per frame.
+	// Only poses that changed since their last record are written; replay accumulates the deltas.
+	StartTrackingSceneActors();
+
+	for (auto It = TrackedSceneActors.CreateIterator(); It; ++It)
+	{
+		AActor* Actor = It->Get();
+		if (!Actor)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (Actor->IsRootComponentMovable())
+		{
+			const FTransform Transform = Actor->GetActorTransform();
+			const FTransform* LastTransform = LastRecordedActorTransforms.Find(Actor);
+			if (!LastTransform || !LastTransform->Equals(Transform, 0.0))
+			{
+				LastRecordedActorTransforms.Add(Actor, Transform);
+
+				// Strip the PIE prefix so the trajectory can be replayed in another session
+				TrajectoryWriter->AddActorPose(UWorld::RemovePIEPrefix(Actor->GetPathName()), Transform);
+			}
+		}
+
+		Actor->ForEachComponent<USkeletalMeshComponent>(false, [this](USkeletalMeshComponent* Mesh) {
+			const TArray<FTransform>& BoneTransforms = Mesh->GetComponentSpaceTransforms();
+			if (BoneTransforms.Num() == 0)
+			{
+				return;
+			}
+
+			TArray<FTransform>& LastBoneTransforms = LastRecordedBoneTransforms.FindOrAdd(Mesh);
+			bool bChanged = LastBoneTransforms.Num() != BoneTransforms.Num();
+			for (int32 BoneIndex = 0; !bChanged && BoneIndex < BoneTransforms.Num(); ++BoneIndex)
+			{
+				bChanged = !LastBoneTransforms[BoneIndex].Equals(BoneTransforms[BoneIndex], 0.0);
+			}
+
+			if (bChanged)
+			{
+				LastBoneTransforms = BoneTransforms;
+				TrajectoryWriter->AddSkeletalPose(UWorld::RemovePIEPrefix(Mesh->GetPathName()), BoneTransforms);
+			}
+		});
+	}
+}
+
+// ============================================================================
+// Change-Driven Capture
+// ============================================================================
+
+bool UCameraCaptureSubsystem::ShouldSkipUnchanged(const UIntrinsicSceneCaptureComponent2D* Camera, const FCameraScheduleState& State, FViewSignature& OutSignature)
+{
+	if (!bMovableActorSnapshotsValid)
+	{
+		GatherMovableActorSnapshots();
+	}
+
+	OutSignature.Transform = Camera->GetComponentTransform();
+	OutSignature.ProjectionHash = Camera->GetProjectionHash();
+	OutSignature.SceneSignature = ComputeSceneSignature(Camera);
+
+	const bool bWithinSkipLimit = Camera->MaxConsecutiveSkippedFrames <= 0 || State.ConsecutiveSkippedFrames < Camera->MaxConsecutiveSkippedFrames;
+
+	return State.bHasChangeSignature
+		&& State.LastCapturedFrameNumber >= 0
+		&& bWithinSkipLimit
+		&& OutSignature.ProjectionHash == State.LastProjectionHash
+		&& OutSignature.SceneSignature == State.LastSceneSignature
+		&& OutSignature.Transform.Equals(State.LastCapturedTransform, KINDA_SMALL_NUMBER);
+}
+
+void UCameraCaptureSubsystem::CommitViewSignature(FCameraScheduleState& State, const FViewSignature& Signature)
+{
+	State.bHasChangeSignature = true;
+	State.LastCapturedTransform = Signature.Transform;
+	State.LastProjectionHash = Signature.ProjectionHash;
+	State.LastSceneSignature = Signature.SceneSignature;
+	State.ConsecutiveSkippedFrames = 0;
+}
+
+void UCameraCaptureSubsystem::GatherMovableActorSnapshots()
+{
+	bMovableActorSnapshotsValid = true;
+	MovableActorSnapshots.Reset();
+	LightingSignature = 0;
+	SceneSnapshotSerial++;
+
+	// Only actors that can change between captures are tracked (see IsTrackedSceneActor);
+	// static geometry is ignored. Gathered once per kick and only when at least one due
+	// camera has bSkipUnchangedFrames enabled.
+	StartTrackingSceneActors();
+
+	for (auto It = TrackedSceneActors.CreateIterator(); It; ++It)
+	{
+		AActor* Actor = It->Get();
+		if (!Actor)
+		{
+			// Gone without a destroy notification (e.g. its level was streamed out)
+			It.RemoveCurrent();
+			continue;
+		}
+
+		FVector BoundsOrigin;
+		FVector BoundsExtent;
+		Actor->GetActorBounds(false, BoundsOrigin, BoundsExtent);
+
+		// Bounds are included so animated meshes whose root does not move still register as changes
+		const FVector Location = Actor->GetActorLocation();
+		const FQuat	  Rotation = Actor->GetActorQuat();
+		const bool	  bHidden = Actor->IsHidden();
+
+		uint32 Hash = GetTypeHash(Actor->GetUniqueID());
+		Hash = FCrc::MemCrc32(&Location, sizeof(Location), Hash);
+		Hash = FCrc::MemCrc32(&Rotation, sizeof(Rotation), Hash);
+		Hash = FCrc::MemCrc32(&BoundsOrigin, sizeof(BoundsOrigin), Hash);
+		Hash = FCrc::MemCrc32(&BoundsExtent, sizeof(BoundsExtent), Hash);
+		Hash = FCrc::MemCrc32(&bHidden, sizeof(bHidden), Hash);
+
+		// Swapped materials change the image; dynamic instances can change their parameters
+		// at any time, and running effects and animated meshes change without moving their bounds
+		bool bAnimating = false;
+		Actor->ForEachComponent<UPrimitiveComponent>(false, [&Hash, &bAnimating](UPrimitiveComponent* Primitive) {
+			for (int32 MaterialIndex = 0; MaterialIndex < Primitive->GetNumMaterials(); ++MaterialIndex)
+			{
+				const UMaterialInterface* Material = Primitive->GetMaterial(MaterialIndex);
+				Hash = HashCombine(Hash, GetTypeHash(Material));
+				bAnimating |= Material && Material->IsA<UMaterialInstanceDynamic>();
+			}
+
+			if (const UFXSystemComponent* Effect = Cast<UFXSystemComponent>(Primitive))
+			{
+				bAnimating |= Effect->IsActive();
+			}
+			else if (const USkeletalMeshComponent* SkeletalMesh = Cast<USkeletalMeshComponent>(Primitive))
+			{
+				bAnimating |= SkeletalMesh->IsVisible() && (SkeletalMesh->GetAnimInstance() || SkeletalMesh->IsPlaying());
+			}
+		});
+		if (bAnimating)
+		{
+			Hash = HashCombine(Hash, SceneSnapshotSerial);
+		}
+
+		// A light changes what every camera sees, wherever its bounds are
+		Actor->ForEachComponent<ULightComponent>(false, [this](ULightComponent* Light) {
+			const bool	  bVisible = Light->IsVisible();
+			const float	  Intensity = Light->Intensity;
+			const FColor  Color = Light->LightColor;
+			const FVector LightLocation = Light->GetComponentLocation();
+			const FQuat	  LightRotation = Light->GetComponentQuat();
+			LightingSignature = FCrc::MemCrc32(&bVisible, sizeof(bVisible), LightingSignature);
+			LightingSignature = FCrc::MemCrc32(&Intensity, sizeof(Intensity), LightingSignature);
+			LightingSignature = FCrc::MemCrc32(&Color, sizeof(Color), LightingSignature);
+			LightingSignature = FCrc::MemCrc32(&LightLocation, sizeof(LightLocation), LightingSignature);
+			LightingSignature = FCrc::MemCrc32(&LightRotation, sizeof(LightRotation), LightingSignature);
+		});
+
+		FMovableActorSnapshot& Snapshot = MovableActorSnapshots.AddDefaulted_GetRef();
+		Snapshot.BoundsOrigin = BoundsOrigin;
+		Snapshot.BoundsExtent = BoundsExtent;
+		Snapshot.Hash = Hash;
+	}
+}
+
+uint32 UCameraCaptureSubsystem::ComputeSceneSignature(const UIntrinsicSceneCaptureComponent2D* Camera) const
+{
+	// View matrix: UE camera space (X forward, Y right, Z up) to view space (X right, Y up, Z forward)
+	const FTransform& Transform = Camera->GetComponentTransform();
+	const FMatrix	  ViewMatrix = FTranslationMatrix(-Transform.GetLocation())
+		* FInverseRotationMatrix(Transform.Rotator())
+		* FMatrix(FPlane(0, 0, 1, 0), FPlane(1, 0, 0, 0), FPlane(0, 1, 0, 0), FPlane(0, 0, 0, 1));
+
+	FMatrix ProjectionMatrix;
+	if (Camera->bUseCustomProjectionMatrix)
+	{
+		ProjectionMatrix = Camera->CustomProjectionMatrix;
+	}
+	else
+	{
+		float AspectRatio = 1.777f; // Default 16:9
+		if (Camera->TextureTarget && Camera->TextureTarget->SizeY > 0)
+		{
+			AspectRatio = static_cast<float>(Camera->TextureTarget->SizeX) / static_cast<float>(Camera->TextureTarget->SizeY);
+		}
+		else
+		{
+			// Pooled cameras only have a target while they are being captured
+			const FCameraIntrinsics Intrinsics = Camera->GetActiveIntrinsics();
+			if (Intrinsics.ImageHeight > 0)
+			{
+				AspectRatio = static_cast<float>(Intrinsics.ImageWidth) / static_cast<float>(Intrinsics.ImageHeight);
+			}
+		}
+		const float HalfFOVRad = FMath::DegreesToRadians(Camera->FOVAngle * 0.5f);
+		ProjectionMatrix = FReversedZPerspectiveMatrix(HalfFOVRad, AspectRatio, 1.0f, GNearClippingPlane);
+	}
+
+	FConvexVolume Frustum;
+	GetViewFrustumBounds(Frustum, ViewMatrix * ProjectionMatrix, false);
+
+	uint32 Signature = LightingSignature;
+	for (const FMovableActorSnapshot& Snapshot : MovableActorSnapshots)
+	{
+		if (Frustum.IntersectBox(Snapshot.BoundsOrigin, Snapshot.BoundsExtent))
+		{
+			Signature = HashCombine(Signature, Snapshot.Hash);
+		}
+	}
+	return Signature;
+}
+
+// ============================================================================
+// Scene Actor Tracking
+// ============================================================================
+
+void UCameraCaptureSubsystem::StartTrackingSceneActors()
+{
+	UWorld* World = GetWorld();
+	if (bTrackingSceneActors || !World)
+	{
+		return;
+	}
+	bTrackingSceneActors = true;
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (IsTrackedSceneActor(*It))
+		{
+			TrackedSceneActors.Add(*It);
+		}
+	}
+
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UCameraCaptureSubsystem::OnSceneActorSpawned));
+	ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &UCameraCaptureSubsystem::OnSceneActorDestroyed));
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Tracking %d scene actors (found in %.2fms)"),
+		TrackedSceneActors.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void UCameraCaptureSubsystem::StopTrackingSceneActors()
+{
+	if (!bTrackingSceneActors)
+	{
+		return;
+	}
+	bTrackingSceneActors = false;
+
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyedHandler(ActorDestroyedHandle);
+	}
+	ActorSpawnedHandle.Reset();
+	ActorDestroyedHandle.Reset();
+	TrackedSceneActors.Empty();
+}
+
+bool UCameraCaptureSubsystem::IsTrackedSceneActor(const AActor* Actor)
+{
+	if (!Actor)
+	{
+		return false;
+	}
+
+	if (Actor->IsRootComponentMovable())
+	{
+		return true;
+	}
+
+	// Static actors still change the image through their lights, effects and animation
+	bool bCanChange = false;
+	Actor->ForEachComponent<USceneComponent>(false, [&bCanChange](const USceneComponent* Component) {
+		const ULightComponent* Light = Cast<ULightComponent>(Component);
+		bCanChange |= (Light && Light->Mobility != EComponentMobility::Static)
+			|| Component->IsA<UFXSystemComponent>()
+			|| Component->IsA<USkeletalMeshComponent>();
+	});
+	return bCanChange;
+}
+
+void UCameraCaptureSubsystem::OnSceneActorSpawned(AActor* Actor)
+{
+	if (IsTrackedSceneActor(Actor))
+	{
+		TrackedSceneActors.Add(Actor);
+	}
+}
+
+void UCameraCaptureSubsystem::OnSceneActorDestroyed(AActor* Actor)
+{
+	TrackedSceneActors.Remove(Actor);
+}
+
+void UCameraCaptureSubsystem::EnqueueAsyncReadback(UTextureRenderTarget2D* RenderTarget, TUniquePtr<FRHIGPUTextureReadback>& OutReadback)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CameraCapture_EnqueueReadback);
+
+	if (!RenderTarget)
+	{
+		return;
+	}
+
+	FTextureRenderTargetResource* RTResource = RenderTarget->GameThread_GetRenderTargetResource();
+	if (!RTResource)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] No render target resource for async readback"));
+		return;
+	}
+
+	OutReadback = MakeUnique<FRHIGPUTextureReadback>(TEXT("CamCaptureReadback"));
+
+	FRHIGPUTextureReadback*		  ReadbackPtr = OutReadback.Get();
+	FTextureRenderTargetResource* ResourcePtr = RTResource;
+
+	ENQUEUE_RENDER_COMMAND(CameraCaptureEnqueueReadback)
+	(
+		[ReadbackPtr, ResourcePtr](FRHICommandListImmediate& RHICmdList) {
+			FRHITexture* Texture = ResourcePtr->GetRenderTargetTexture();
+			if (Texture)
+			{
+				ReadbackPtr->EnqueueCopy(RHICmdList, Texture);
+			}
+		});
+}
+
+// ============================================================================
+// Readback Completion
+// ============================================================================
+
+bool UCameraCaptureSubsystem::FReadbackCompletion::IsReady() const
+{
+	const bool bRgbReady = !bHasRgb || !RgbReadback.Readback || RgbReadback.Readback->IsReady();
+	const bool bDmvReady = !bHasDmv || !DmvReadback.Readback || DmvReadback.Readback->IsReady();
+	return bRgbReady && bDmvReady;
+}
+
+void UCameraCaptureSubsystem::FReadbackCompletion::Map()
+{
+	check(IsInRenderingThread());
+
+	auto MapReadback = [](FPendingReadback& Pending, const TCHAR* Channel) {
+		int32 BufferHeight = 0;
+		Pending.MappedData = Pending.Readback->Lock(Pending.MappedRowPitch, &BufferHeight);
+		if (!Pending.MappedData)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Failed to lock %s readback"), Channel);
+			Pending.Readback->Unlock();
+		}
+	};
+
+	if (bHasRgb && RgbReadback.Readback)
+	{
+		MapReadback(RgbReadback, TEXT("RGB"));
+	}
+	if (bHasDmv && DmvReadback.Readback)
+	{
+		MapReadback(DmvReadback, TEXT("DMV"));
+	}
+}
+
+void UCameraCaptureSubsystem::FReadbackCompletion::Unmap()
+{
+	check(IsInRenderingThread());
+
+	for (FPendingReadback* Pending : { &RgbReadback, &DmvReadback })
+	{
+		if (Pending->MappedData)
+		{
+			Pending->Readback->Unlock();
+			Pending->MappedData = nullptr;
+		}
+	}
+}
+
+void UCameraCaptureSubsystem::FReadbackCompletion::Harvest()
+{
+	// Copy pixel data out of the mapped staging buffers (memcpy / format conversion, no stall)
+	// Planes from the pool already have the capacity, so the harvest does not allocate
+	if (bHasRgb)
+	{
+		CAMERA_CAPTURE_SCOPE(STAT_CameraCapture_HarvestRgb, "Harvest RGB", CameraID, FrameNumber);
+
+		if (BufferPool)
+		{
+			BufferPool->Acquire(ImageData, RgbReadback.Width * RgbReadback.Height);
+		}
+		HarvestRgbReadback(RgbReadback, ImageData);
+	}
+
+	if (bHasDmv)
+	{
+		CAMERA_CAPTURE_SCOPE(STAT_CameraCapture_HarvestDmv, "Harvest DMV", CameraID, FrameNumber);
+
+		if (BufferPool)
+		{
+			BufferPool->Acquire(DepthData, DmvReadback.Width * DmvReadback.Height);
+			BufferPool->Acquire(MotionVectorData, DmvReadback.Width * DmvReadback.Height);
+		}
+		HarvestDmvReadback(DmvReadback, DepthData, MotionVectorData);
+	}
+
+	// The planes exist now; count what they hold rather than what was estimated at kick
+	if (MemoryReservation)
+	{
+		FCaptureMemoryTracker& Tracker = MemoryReservation->GetTracker();
+		AwaitingEmitBytes = ImageData.GetAllocatedSize() + DepthData.GetAllocatedSize() + MotionVectorData.GetAllocatedSize();
+		Tracker.AddStageBytes(ECaptureMemoryStage::AwaitingEmit, AwaitingEmitBytes);
+		Tracker.AddStageBytes(ECaptureMemoryStage::Readback, -ReadbackBytes);
+		ReadbackBytes = 0;
+	}
+
+	HarvestTime = FPlatformTime::Seconds();
+	bHarvested.store(true, std::memory_order_release);
+}
+
+UCameraCaptureSubsystem::FReadbackCompletion::~FReadbackCompletion()
+{
+	if (MemoryReservation)
+	{
+		FCaptureMemoryTracker& Tracker = MemoryReservation->GetTracker();
+		Tracker.AddStageBytes(ECaptureMemoryStage::Readback, -ReadbackBytes);
+		Tracker.AddStageBytes(ECaptureMemoryStage::AwaitingEmit, -AwaitingEmitBytes);
+	}
+
+	// Emitted frames took their planes along; anything left was harvested for nobody
+	if (BufferPool)
+	{
+		BufferPool->Release(ImageData, DepthData, MotionVectorData);
+	}
+}
+
+void UCameraCaptureSubsystem::FReadbackWatcher::PollReadyReadbacks()
+{
+	check(IsInRenderingThread());
+
+	TArray<TSharedRef<FReadbackCompletion, ESPMode::ThreadSafe>> Claimed;
+
+	for (int32 i = InFlight.Num() - 1; i >= 0; --i)
+	{
+		TSharedRef<FReadbackCompletion, ESPMode::ThreadSafe>& Completion = InFlight[i];
+
+		// Claimed by the game thread (blocking harvest or drop) or still in flight
+		if (!Completion->bClaimed.load() && !Completion->IsReady())
+		{
+			continue;
+		}
+
+		if (!Completion->bClaimed.exchange(true))
+		{
+			Completion->ReadyTime = FPlatformTime::Seconds();
+			Claimed.Add(Completion);
+		}
+		InFlight.RemoveAtSwap(i);
+	}
+
+	if (Claimed.Num() > 0)
+	{
+		MapAndHarvest(MoveTemp(Claimed), true);
+	}
+}
+
+void UCameraCaptureSubsystem::FReadbackWatcher::MapAndHarvest(TArray<TSharedRef<FReadbackCompletion, ESPMode::ThreadSafe>>&& Claimed, bool bParallel)
+{
+	check(IsInRenderingThread());
+
+	// Staging buffers are locked and unlocked here; the workers only copy
+	for (const TSharedRef<FReadbackCompletion, ESPMode::ThreadSafe>& Completion : Claimed)
+	{
+		Completion->Map();
+	}
+
+	AsyncTask(ENamedThreads::AnyHiPriThreadNormalTask, [Watcher = AsShared(), Claimed = MoveTemp(Claimed), bParallel]() mutable {
+		const double StartTime = FPlatformTime::Seconds();
+
+		// Each capture owns its staging buffers and output arrays, so the copies are independent
+		ParallelFor(
+			Claimed.Num(),
+			[&Claimed](int32 Index) {
+				Claimed[Index]->Harvest();
+			},
+			bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+		const float HarvestWallMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		const float AverageWallMs = Watcher->AverageHarvestWallMs.load(std::memory_order_relaxed);
+		Watcher->AverageHarvestWallMs.store(AverageWallMs == 0.0f ? HarvestWallMs : AverageWallMs * 0.9f + HarvestWallMs * 0.1f, std::memory_order_relaxed);
+
+		// The references keep the readbacks alive until they are unmapped
+		ENQUEUE_RENDER_COMMAND(CameraCaptureUnmapReadbacks)
+		(
+			[Claimed = MoveTemp(Claimed)](FRHICommandListImmediate& RHICmdList) {
+				for (const TSharedRef<FReadbackCompletion, ESPMode::ThreadSafe>& Completion : Claimed)
+				{
+					Completion->Unmap();
+				}
+			});
+	});
+}
+
+void UCameraCaptureSubsystem::WatchReadback(const TSharedRef<FReadbackCompletion, ESPMode::ThreadSafe>& Completion)
+{
+	Completion->bWatched = true;
+
+	// Runs after the copies enqueued for this capture
+	ENQUEUE_RENDER_COMMAND(CameraCaptureWatchReadback)
+	(
+		[Watcher = ReadbackWatcher.ToSharedRef(), Completion](FRHICommandListImmediate& RHICmdList) {
+			Watcher->InFlight.Add(Completion);
+		});
+}
+
+// ============================================================================
+// Phase 2: Poll pending readbacks + harvest completed ones
+// ============================================================================
+
+void UCameraCaptureSubsystem::HarvestReadyReadbacks()
+{
+	if (PendingCaptureCount == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CameraCapture_PollReadbacks);
+
+	// Copy pixels of everything that is ready first, then emit per queue in order
+	HarvestClaimableReadbacks();
+
+	const double Now = FPlatformTime::Seconds();
+
+	// Indexed rather than iterated: listeners may add queues (and grow the array) meanwhile
+	for (int32 QueueIndex = 0; QueueIndex < PendingQueues.GetMaxIndex(); ++QueueIndex)
+	{
+		if (!PendingQueues.IsAllocated(QueueIndex))
+		{
+			continue;
+		}
+
+		HarvestPendingQueue(QueueIndex, Now);
+
+		const FPendingCaptureQueue& Queue = PendingQueues[QueueIndex];
+		if (Queue.bOrphaned && Queue.Captures.IsEmpty())
+		{
+			PendingQueues.RemoveAt(QueueIndex);
+		}
+	}
+}
+
+TSharedRef<const FCaptureData> UCameraCaptureSubsystem::MakeSharedCaptureData(FCaptureData&& Data, const TSharedPtr<FCaptureBufferPool, ESPMode::ThreadSafe>& Pool)
+{
+	const int64 PlaneBytes = GetPixelPlaneBytes(Data);
+	if (Data.MemoryReservation)
+	{
+		Data.MemoryReservation->GetTracker().AddStageBytes(ECaptureMemoryStage::Frames, PlaneBytes);
+	}
+
+	// Runs wherever the last reference dies (usually a serializer thread). The reservation
+	// goes with the frame unless an encode copy still holds it.
+	return MakeShareable(new FCaptureData(MoveTemp(Data)), [Pool, PlaneBytes](FCaptureData* Released) {
+		if (Released->MemoryReservation)
+		{
+			Released->MemoryReservation->GetTracker().AddStageBytes(ECaptureMemoryStage::Frames, -PlaneBytes);
+		}
+		if (Pool)
+		{
+			Pool->Release(*Released);
+		}
+		delete Released;
+	});
+}
+
+int64 UCameraCaptureSubsystem::GetPixelPlaneBytes(const FCaptureData& Data)
+{
+	return Data.ImageData.GetAllocatedSize() + Data.DepthData.GetAllocatedSize() + Data.MotionVectorData.GetAllocatedSize();
+}
+
+void UCameraCaptureSubsystem::HarvestClaimableReadbacks()
+{
+	TArray<TSharedRef<FReadbackCompletion, ESPMode::ThreadSafe>> Claimed;
+
+	// Only each queue's leading run can be emitted this pass, so the scan stops at the
+	// first capture that is not ready rather than polling every readback in flight
+	for (FPendingCaptureQueue& Queue : PendingQueues)
+	{
+		for (FPendingCameraCapture& Pending : Queue.Captures)
+		{
+			FReadbackCompletion* Completion = Pending.Readback.Get();
+
+			// Unchanged records and captures already being harvested don't end the run
+			if (!Completion || Completion->bClaimed.load())
+			{
+				continue;
+			}
+
+			// Watched readbacks are harvested by the render-thread watcher unless we are blocking
+			if ((Completion->bWatched && !bBlockingOnReadbacks) || !Completion->IsReady())
+			{
+				break;
+			}
+
+			if (!Completion->bClaimed.exchange(true))
+			{
+				Completion->ReadyTime = FPlatformTime::Seconds();
+				Claimed.Add(Pending.Readback.ToSharedRef());
+			}
+		}
+	}
+
+	if (Claimed.Num() == 0 || !ReadbackWatcher.IsValid())
+	{
+		return;
+	}
+
+	// Staging buffers may only be mapped on the render thread. Blocking waits flush it
+	// and pick the frames up on a later pass; otherwise the next tick emits them.
+	ENQUEUE_RENDER_COMMAND(CameraCaptureHarvestReadbacks)
+	(
+		[Watcher = ReadbackWatcher.ToSharedRef(), Claimed = MoveTemp(Claimed), bParallel = bParallelHarvest](FRHICommandListImmediate& RHICmdList) mutable {
+			Watcher->MapAndHarvest(MoveTemp(Claimed), bParallel);
+		});
+}
+
+UCameraCaptureSubsystem::FPendingCameraCapture& UCameraCaptureSubsystem::EnqueuePendingCapture(FRegisteredCamera& Entry, FPendingCameraCapture&& Pending)
+{
+	if (Entry.PendingQueueIndex == INDEX_NONE)
+	{
+		Entry.PendingQueueIndex = PendingQueues.Add(FPendingCaptureQueue());
+	}
+
+	if (bAssembleFrameSets)
+	{
+		AddExpectedFrameSetView(Pending.Metadata);
+	}
+
+	FPendingCaptureQueue& Queue = PendingQueues[Entry.PendingQueueIndex];
+	Queue.Captures.PushLast(MoveTemp(Pending));
+	PendingCaptureCount++;
+
+	Entry.Schedule.MaxQueueDepth = FMath::Max(Entry.Schedule.MaxQueueDepth, static_cast<int32>(Queue.Captures.Num()));
+	MaxPendingCaptureCount = FMath::Max(MaxPendingCaptureCount, PendingCaptureCount);
+
+	return Queue.Captures.Last();
+}
+
+void UCameraCaptureSubsystem::HarvestPendingQueue(int32 QueueIndex, double Now)
+{
+	// Re-fetched every iteration: broadcasts and frame-set callbacks below may add queues.
+	// The slot itself stays valid, orphaned queues are only removed by HarvestReadyReadbacks.
+	for (;;)
+	{
+		FPendingCaptureQueue& Queue = PendingQueues[QueueIndex];
+		if (Queue.Captures.IsEmpty())
+		{
+			break;
+		}
+
+		FPendingCameraCapture& Pending = Queue.Captures.First();
+		const double		   WaitedMs = (Now - Pending.KickTime) * 1000.0;
+
+		FReadbackCompletion* Completion = Pending.Readback.Get();
+
+		// Pixels were copied by the watcher's task or by HarvestClaimableReadbacks.
+		// Unchanged records have no readbacks.
+		if (!Completion || Completion->bHarvested.load(std::memory_order_acquire))
+		{
+			FCaptureData& Data = Pending.Metadata;
+
+			if (Completion)
+			{
+				RecordReadbackOutcome(Pending, (Completion->HarvestTime - Pending.KickTime) * 1000.0, false);
+				RecordHarvestLatencies(Pending, FPlatformTime::Seconds());
+
+				const float EmitDelayMs = static_cast<float>(FMath::Max(0.0, FPlatformTime::Seconds() - Completion->HarvestTime) * 1000.0);
+				AverageEmitDelayMs = AverageEmitDelayMs == 0.0f ? EmitDelayMs : AverageEmitDelayMs * 0.9f + EmitDelayMs * 0.1f;
+
+				// The harvest task is done with the buffers once bHarvested is published
+				Data.ImageData = MoveTemp(Completion->ImageData);
+				Data.DepthData = MoveTemp(Completion->DepthData);
+				Data.MotionVectorData = MoveTemp(Completion->MotionVectorData);
+
+				// The frame takes over the reservation; its planes move to the Frames stage
+				Data.MemoryReservation = Completion->MemoryReservation;
+				if (Completion->MemoryReservation)
+				{
+					Completion->MemoryReservation->GetTracker().AddStageBytes(ECaptureMemoryStage::AwaitingEmit, -Completion->AwaitingEmitBytes);
+					Completion->AwaitingEmitBytes = 0;
+				}
+			}
+
+			// Wrap in shared ref so listeners can safely retain the data
+			TSharedRef<const FCaptureData> SharedData = (Completion && (Completion->BufferPool || Data.MemoryReservation))
+				? MakeSharedCaptureData(MoveTemp(Data), Completion->BufferPool)
+				: MakeShared<FCaptureData>(MoveTemp(Data));
+
+			// Dequeue before notifying, so listeners see a consistent queue (Queue is not used past here)
+			Queue.Captures.PopFirst();
+			PendingCaptureCount--;
+
+			// Notify listeners (streaming, etc.); unchanged records carry no pixels, so only on request
+			if (!SharedData->bUnchanged || bBroadcastUnchangedFrames)
+			{
+				CAMERA_CAPTURE_SCOPE(STAT_CameraCapture_Broadcast, "Broadcast", SharedData->GetCameraInfo().TraceName, SharedData->FrameNumber);
+				OnFrameCaptured.Broadcast(SharedData);
+			}
+
+			// Batched frame sets write their views when the set is finalized
+			const bool bInFrameSet = bAssembleFrameSets && ResolveFrameSetView(SharedData->FrameNumber, SharedData);
+			if (bSerializationEnabled && !(bInFrameSet && bBatchFrameSetSerialization))
+			{
+				SerializeCaptureData(SharedData);
+			}
+
+			// Unchanged records reference an earlier frame and carry no pixels
+			if (!SharedData->bUnchanged)
+			{
+				TotalFramesCaptured++;
+			}
+		}
+		else if (WaitedMs > ReadbackTimeoutMs && !bOfflineMode && !bDrainingReadbacks
+			&& (!Completion || !Completion->bClaimed.exchange(true)))
+		{
+			// Claimed above, so the watcher won't harvest pixels nobody will read. A capture
+			// claimed earlier is already being copied and is waited for instead.
+			UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Dropping capture for %s (readback timed out after %.1fms)"),
+				*Pending.Metadata.GetCameraInfo().CameraID.ToString(), WaitedMs);
+			RecordReadbackOutcome(Pending, WaitedMs, true);
+
+			const int64 FrameNumber = Pending.Metadata.FrameNumber;
+			Queue.Captures.PopFirst();
+			PendingCaptureCount--;
+
+			if (bAssembleFrameSets)
+			{
+				ResolveFrameSetView(FrameNumber, nullptr);
+			}
+		}
+		else
+		{
+			// Later captures of this camera cannot be emitted before this one (still in
+			// flight, or its harvest is under way)
+			break;
+		}
+	}
+}
+
+// ============================================================================
+// Frame Sets
+// ============================================================================
+
+void UCameraCaptureSubsystem::AddExpectedFrameSetView(const FCaptureData& Metadata)
+{
+	FPendingFrameSet& Pending = PendingFrameSets.FindOrAdd(Metadata.FrameNumber);
+	if (Pending.FrameSet->ExpectedCount == 0)
+	{
+		Pending.FrameSet->FrameNumber = Metadata.FrameNumber;
+		Pending.FrameSet->Timestamp = Metadata.Timestamp;
+		Pending.FirstKickTime = FPlatformTime::Seconds();
+	}
+	Pending.FrameSet->ExpectedCount++;
+}
+
+bool UCameraCaptureSubsystem::ResolveFrameSetView(int64 FrameNumber, const TSharedPtr<const FCaptureData>& Data)
+{
+	// Captures kicked before assembly was enabled, or views of a set that already timed out
+	FPendingFrameSet* Pending = PendingFrameSets.Find(FrameNumber);
+	if (!Pending)
+	{
+		return false;
+	}
+
+	if (Data.IsValid())
+	{
+		Pending->FrameSet->Frames.Add(Data.ToSharedRef());
+	}
+
+	if (++Pending->ResolvedCount >= Pending->FrameSet->ExpectedCount)
+	{
+		// Remove first: listeners may kick captures that add sets
+		FPendingFrameSet Finished = MoveTemp(*Pending);
+		PendingFrameSets.Remove(FrameNumber);
+		FinalizeFrameSet(Finished);
+	}
+	return true;
+}
+
+void UCameraCaptureSubsystem::FinalizeFrameSet(FPendingFrameSet& Pending)
+{
+	FCaptureFrameSet& FrameSet = *Pending.FrameSet;
+	FrameSet.Frames.Sort([](const TSharedRef<const FCaptureData>& A, const TSharedRef<const FCaptureData>& B) {
+		return A->GetCameraInfo().CameraID.UniqueID < B->GetCameraInfo().CameraID.UniqueID;
+	});
+
+	const bool bComplete = FrameSet.IsComplete();
+	if (bComplete)
+	{
+		FrameSetsCompleted++;
+	}
+	else
+	{
+		FrameSetsIncomplete++;
+		UE_LOG(LogTemp, Verbose, TEXT("[CameraCaptureSubsystem] Frame set %lld finalized with %d of %d views"),
+			FrameSet.FrameNumber, FrameSet.Frames.Num(), FrameSet.ExpectedCount);
+	}
+
+	if (FrameSet.Frames.Num() == 0)
+	{
+		return;
+	}
+
+	if (bComplete || FrameSetPolicy == ECaptureFrameSetPolicy::EmitPartial)
+	{
+		OnFrameSetCaptured.Broadcast(Pending.FrameSet);
+	}
+
+	if (bSerializationEnabled && bBatchFrameSetSerialization)
+	{
+		SerializeFrameSet(Pending.FrameSet);
+	}
+}
+
+void UCameraCaptureSubsystem::FlushFrameSets(bool bAll)
+{
+	// Offline mode never drops readbacks, so its sets always resolve
+	const double Now = FPlatformTime::Seconds();
+
+	TArray<int64, TInlineAllocator<8>> Expired;
+	for (const TPair<int64, FPendingFrameSet>& Pair : PendingFrameSets)
+	{
+		if (bAll || (!bOfflineMode && (Now - Pair.Value.FirstKickTime) * 1000.0 > FrameSetTimeoutMs))
+		{
+			Expired.Add(Pair.Key);
+		}
+	}
+	Expired.Sort();
+
+	for (int64 FrameNumber : Expired)
+	{
+		FPendingFrameSet Finished;
+		if (PendingFrameSets.RemoveAndCopyValue(FrameNumber, Finished))
+		{
+			FinalizeFrameSet(Finished);
+		}
+	}
+}
+
+void UCameraCaptureSubsystem::RecordReadbackOutcome(const FPendingCameraCapture& Pending, double LatencyMs, bool bDropped)
+{
+	if (bDropped)
+	{
+		TotalFramesDropped++;
+	}
+	else
+	{
+		AverageReadbackLatencyMs = AverageReadbackLatencyMs == 0.0f
+			? static_cast<float>(LatencyMs)
+			: AverageReadbackLatencyMs * 0.9f + static_cast<float>(LatencyMs) * 0.1f;
+	}
+
+	// The camera may have been unregistered while its capture was in flight
+	FRegisteredCamera* Entry = FindRegisteredCamera(Pending.Camera);
+	if (!Entry)
+	{
+		return;
+	}
+
+	FCameraScheduleState& State = Entry->Schedule;
+	if (bDropped)
+	{
+		State.FramesDropped++;
+		return;
+	}
+
+	State.FramesHarvested++;
+	if (LatencyMs > ReadbackTimeoutMs)
+	{
+		State.FramesLate++;
+	}
+
+	State.LastReadbackLatencyMs = static_cast<float>(LatencyMs);
+	State.MaxReadbackLatencyMs = FMath::Max(State.MaxReadbackLatencyMs, State.LastReadbackLatencyMs);
+	State.AverageReadbackLatencyMs = State.AverageReadbackLatencyMs == 0.0f
+		? State.LastReadbackLatencyMs
+		: State.AverageReadbackLatencyMs * 0.9f + State.LastReadbackLatencyMs * 0.1f;
+}
+
+void UCameraCaptureSubsystem::RecordHarvestLatencies(const FPendingCameraCapture& Pending, double EmitTime)
+{
+	const double KickToReadyMs = (Pending.Readback->ReadyTime - Pending.KickTime) * 1000.0;
+	const double ReadyToHarvestMs = (EmitTime - Pending.Readback->ReadyTime) * 1000.0;
+
+	SessionCounters->KickToReady.Record(KickToReadyMs);
+	SessionCounters->ReadyToHarvest.Record(ReadyToHarvestMs);
+
+	if (FRegisteredCamera* Entry = FindRegisteredCamera(Pending.Camera))
+	{
+		Entry->Counters->KickToReady.Record(KickToReadyMs);
+		Entry->Counters->ReadyToHarvest.Record(ReadyToHarvestMs);
+	}
+
+	if (FCaptureTimeline::IsRecording())
+	{
+		FCaptureTimeline::Record(TEXT("GPU Readback"), Pending.Readback->CameraID, Pending.Readback->FrameNumber,
+			Pending.KickTime, Pending.Readback->ReadyTime, FCaptureTimeline::ETrack::Readback);
+	}
+}
+
+void UCameraCaptureSubsystem::HarvestRgbReadback(const FPendingReadback& Readback, TArray<FColor>& OutImageData)
+{
+	const void* SrcData = Readback.MappedData;
+	const int32 RowPitchInPixels = Readback.MappedRowPitch;
+
+	if (!SrcData)
+	{
+		OutImageData.Reset(); // A pooled plane keeps its capacity but carries no pixels
+		return;
+	}
+
+	const int32 Width = Readback.Width;
+	const int32 Height = Readback.Height;
+	OutImageData.SetNumUninitialized(Width * Height);
+
+	if (Readback.bIsFloat)
+	{
+		// Source is FLinearColor (RGBA32f) — convert to FColor
+		const FLinearColor* SrcRow = static_cast<const FLinearColor*>(SrcData);
+		for (int32 y = 0; y < Height; y++)
+		{
+			for (int32 x = 0; x < Width; x++)
+			{
+				OutImageData[y * Width + x] = SrcRow[x].ToFColor(true);
+			}
+			SrcRow += RowPitchInPixels;
+		}
+	}
+	else
+	{
+		// Source is BGRA8 (FColor) — fast memcpy path
+		const FColor* SrcRow = static_cast<const FColor*>(SrcData);
+		if (Width == RowPitchInPixels)
+		{
+			FMemory::Memcpy(OutImageData.GetData(), SrcData, Width * Height * sizeof(FColor));
+		}
+		else
+		{
+			FColor* Dst = OutImageData.GetData();
+			for (int32 y = 0; y < Height; y++)
+			{
+				FMemory::Memcpy(Dst, SrcRow, Width * sizeof(FColor));
+				Dst += Width;
+				SrcRow += RowPitchInPixels;
+			}
+		}
+	}
+}
+
+void UCameraCaptureSubsystem::HarvestDmvReadback(const FPendingReadback& Readback, TArray<float>& OutDepthData, TArray<FVector2D>& OutMotionVectorData)
+{
+	const void* SrcData = Readback.MappedData;
+	const int32 RowPitchInPixels = Readback.MappedRowPitch;
+
+	if (!SrcData)
+	{
+		OutDepthData.Reset();
+		OutMotionVectorData.Reset();
+		return;
+	}
+
+	const int32 Width = Readback.Width;
+	const int32 Height = Readback.Height;
+	const int32 NumPixels = Width * Height;
+
+	OutDepthData.SetNumUninitialized(NumPixels);
+	OutMotionVectorData.SetNumUninitialized(NumPixels);
+
+	// DMV render target is RGBA32f: R=Depth, G=MotionX, B=MotionY, A=1
+	const FLinearColor* SrcRow = static_cast<const FLinearColor*>(SrcData);
+	for (int32 y = 0; y < Height; y++)
+	{
+		const int32 RowStart = y * Width;
+		for (int32 x = 0; x < Width; x++)
+		{
+			const FLinearColor& Pixel = SrcRow[x];
+			OutDepthData[RowStart + x] = Pixel.R;
+			OutMotionVectorData[RowStart + x] = FVector2D(Pixel.G, Pixel.B);
+		}
+		SrcRow += RowPitchInPixels;
+	}
+}
+
+// ============================================================================
+// Metadata + Render Target Helpers
+// ============================================================================
+
+FCaptureData UCameraCaptureSubsystem::BuildCaptureMetadata(UIntrinsicSceneCaptureComponent2D* Camera)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CameraCapture_BuildMetadata);
+
+	FCaptureData Data;
+	Data.CameraInfo = GetCameraInfo(Camera);
+
+	Data.FrameNumber = ExternalFrame.IsSet() ? ExternalFrame->FrameNumber : FrameIdCounter;
+	Data.Timestamp = ExternalFrame.IsSet() ? ExternalFrame->Timestamp : GetCaptureTime();
+	Data.WorldTransform = Camera->GetComponentTransform();
+
+	// Compute transform relative to the owning actor's root (not just the immediate parent)
+	if (AActor* Owner = Camera->GetOwner())
+	{
+		Data.RelativeTransform = Data.WorldTransform.GetRelativeTransform(Owner->GetActorTransform());
+	}
+	else
+	{
+		Data.RelativeTransform = Camera->GetRelativeTransform();
+	}
+
+	Data.Width = Data.CameraInfo->Intrinsics.ImageWidth;
+	Data.Height = Data.CameraInfo->Intrinsics.ImageHeight;
+
+	return Data;
+}
+
+TSharedRef<const FCaptureCameraInfo, ESPMode::ThreadSafe> UCameraCaptureSubsystem::GetCameraInfo(UIntrinsicSceneCaptureComponent2D* Camera)
+{
+	FRegisteredCamera* Entry = FindRegisteredCamera(Camera);
+
+	// Captures already in flight keep the old info; only new ones see the change
+	const uint32 ProjectionHash = Camera->GetProjectionHash();
+	if (Entry && Entry->CameraInfo.IsValid() && Entry->CameraInfo->ProjectionHash == ProjectionHash)
+	{
+		return Entry->CameraInfo.ToSharedRef();
+	}
+
+	TSharedRef<FCaptureCameraInfo, ESPMode::ThreadSafe> Info = MakeShared<FCaptureCameraInfo, ESPMode::ThreadSafe>();
+	if (Entry)
+	{
+		Info->CameraID = Entry->Identifier;
+		Info->TraceName = Entry->TraceName;
+	}
+
+	Info->Intrinsics = Camera->GetActiveIntrinsics();
+	Info->bUsedCustomProjectionMatrix = Camera->bUseCustomProjectionMatrix;
+	if (Info->bUsedCustomProjectionMatrix)
+	{
+		Info->ProjectionMatrix = Camera->CustomProjectionMatrix;
+	}
+	Info->ProjectionHash = ProjectionHash;
+
+	if (AActor* Owner = Camera->GetOwner())
+	{
+		Info->ActorPath = Owner->GetPathName();
+	}
+
+	if (UWorld* World = GetWorld())
+	{
+		Info->LevelName = World->GetMapName();
+	}
+
+	if (Entry)
+	{
+		Entry->CameraInfo = Info;
+	}
+	return Info;
+}
+
+FString UCameraCaptureSubsystem::GetAbsoluteOutputDirectory() const
+{
+	return FPaths::IsRelative(OutputDirectory) ? FPaths::Combine(*FPaths::ProjectDir(), *OutputDirectory) : OutputDirectory;
+}
+
+double UCameraCaptureSubsystem::GetCaptureTime() const
+{
+	if (bOfflineMode)
+	{
+		const UWorld* World = GetWorld();
+		return World ? World->GetTimeSeconds() - SimulationStartTime : 0.0;
+	}
+	return FPlatformTime::Seconds() - CaptureStartTime;
+}
+
+// ============================================================================
+// Offline (Fixed-Step) Mode
+// ============================================================================
+
+void UCameraCaptureSubsystem::ApplyOfflineTiming()
+{
+	if (!bEngineTimingOverridden)
+	{
+		bSavedUseFixedTimeStep = FApp::UseFixedTimeStep();
+		SavedFixedDeltaTime = FApp::GetFixedDeltaTime();
+
+		if (GEngine)
+		{
+			bSavedSmoothFrameRate = GEngine->bSmoothFrameRate;
+			bSavedUseFixedFrameRate = GEngine->bUseFixedFrameRate;
+			SavedMaxFPS = GEngine->GetMaxFPS();
+		}
+
+		if (IConsoleVariable* VSyncVar = IConsoleManager::Get().FindConsoleVariable(TEXT("r.VSync")))
+		{
+			SavedVSync = VSyncVar->GetInt();
+			SavedVSyncSetBy = static_cast<uint32>(VSyncVar->GetFlags()) & ECVF_SetByMask;
+		}
+
+		bEngineTimingOverridden = true;
+	}
+
+	// Fixed step with no frame pacing: each engine tick advances the simulation by
+	// exactly OfflineFixedDeltaSeconds and starts as soon as the previous one ends
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(OfflineFixedDeltaSeconds);
+
+	if (GEngine)
+	{
+		GEngine->bSmoothFrameRate = false;
+		GEngine->bUseFixedFrameRate = false;
+		GEngine->SetMaxFPS(0.0f);
+	}
+
+	// A value the user typed at the console outranks ours; anything lower (ini, device
+	// profile, command line) is overridden and its priority restored afterwards
+	IConsoleVariable* VSyncVar = IConsoleManager::Get().FindConsoleVariable(TEXT("r.VSync"));
+	if (VSyncVar && SavedVSyncSetBy <= ECVF_SetByCode)
+	{
+		VSyncVar->Set(0, ECVF_SetByCode);
+		bVSyncOverridden = true;
+	}
+	else if (VSyncVar && VSyncVar->GetInt() != 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] r.VSync=%d was set from the console and is left on; offline steps will be paced by VSync"),
+			VSyncVar->GetInt());
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Offline timing applied: fixed step %.4fs, unpaced"), OfflineFixedDeltaSeconds);
+}
+
+void UCameraCaptureSubsystem::RestoreEngineTiming()
+{
+	if (!bEngineTimingOverridden)
+	{
+		return;
+	}
+
+	FApp::SetUseFixedTimeStep(bSavedUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(SavedFixedDeltaTime);
+
+	if (GEngine)
+	{
+		GEngine->bSmoothFrameRate = bSavedSmoothFrameRate;
+		GEngine->bUseFixedFrameRate = bSavedUseFixedFrameRate;
+		GEngine->SetMaxFPS(SavedMaxFPS);
+	}
+
+	// Put back the value and the priority it was set with, so later ini, scalability
+	// and command line changes apply again
+	IConsoleVariable* VSyncVar = IConsoleManager::Get().FindConsoleVariable(TEXT("r.VSync"));
+	if (VSyncVar && bVSyncOverridden)
+	{
+		VSyncVar->Set(SavedVSync, ECVF_SetByCode);
+		VSyncVar->SetFlags(static_cast<EConsoleVariableFlags>((static_cast<uint32>(VSyncVar->GetFlags()) & ~ECVF_SetByMask) | SavedVSyncSetBy));
+	}
+	bVSyncOverridden = false;
+
+	bEngineTimingOverridden = false;
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Engine timing restored"));
+}
+
+int32 UCameraCaptureSubsystem::GetQueuedFrameCount() const
+{
+	int32 Queued = PendingCaptureCount + SerializationBacklog->GetValue();
+
+	// Views held for a batched frame set have not reached the serializer yet
+	if (bBatchFrameSetSerialization)
+	{
+		for (const TPair<int64, FPendingFrameSet>& Pair : PendingFrameSets)
+		{
+			Queued += Pair.Value.FrameSet->Frames.Num();
+		}
+	}
+
+	// EXR encodes/writes are finished by the image write queue after the serializer
+	// task returns. Tasks are counted as frames, which over-estimates (a frame may
+	// have two EXRs) and therefore keeps the bound conservative.
+	if (IImageWriteQueueModule* ImageWriteQueueModule = FModuleManager::GetModulePtr<IImageWriteQueueModule>("ImageWriteQueue"))
+	{
+		Queued += ImageWriteQueueModule->GetWriteQueue().GetNumPendingTasks();
+	}
+
+	return Queued;
+}
+
+bool UCameraCaptureSubsystem::WaitForOfflineQueueCapacity()
+{
+	// A slow encoder is not a failure: keep waiting as long as frames leave the queue,
+	// and give up only once a whole timeout passed without progress
+	int32 LastQueuedFrames = GetQueuedFrameCount();
+	while (!WaitForQueueCapacity(OfflineMaxQueuedFrames))
+	{
+		const int32 QueuedFrames = GetQueuedFrameCount();
+		if (QueuedFrames >= LastQueuedFrames)
+		{
+			return false;
+		}
+		LastQueuedFrames = QueuedFrames;
+	}
+	return true;
+}
+
+bool UCameraCaptureSubsystem::WaitForPipeline(TFunctionRef<bool()> IsDone, double TimeoutSeconds)
+{
+	if (IsDone())
+	{
+		return true;
+	}
+
+	// Throughput is limited only by rendering and encoding: push outstanding GPU
+	// work through, harvest what completed, and let the serializer drain
+	TGuardValue<bool> PollReadbacks(bBlockingOnReadbacks, true);
+
+	return WaitUntil(
+		[this, &IsDone]() {
+			if (PendingCaptureCount > 0)
+			{
+				FlushRenderingCommands();
+				HarvestReadyReadbacks();
+			}
+			return IsDone();
+		},
+		TimeoutSeconds);
+}
+
+bool UCameraCaptureSubsystem::WaitUntil(TFunctionRef<bool()> Predicate, double TimeoutSeconds)
+{
+	const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+	while (!Predicate())
+	{
+		if (FPlatformTime::Seconds() >= Deadline)
+		{
+			return false;
+		}
+		FPlatformProcess::Sleep(0.001f);
+	}
+	return true;
+}
+
+bool UCameraCaptureSubsystem::WaitForQueueCapacity(int32 MaxQueuedFrames)
+{
+	MaxQueuedFrames = FMath::Max(1, MaxQueuedFrames);
+
+	if (!WaitForPipeline([this, MaxQueuedFrames]() { return GetQueuedFrameCount() < MaxQueuedFrames; }))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Capture queue did not drain after %.0fs (%d frames queued)"),
+			PipelineWaitTimeoutSeconds, GetQueuedFrameCount());
+		return false;
+	}
+	return true;
+}
+
+bool UCameraCaptureSubsystem::DrainPendingReadbacks()
+{
+	if (PendingCaptureCount == 0)
+	{
+		return true;
+	}
+
+	TGuardValue<bool> NoTimeouts(bDrainingReadbacks, true);
+
+	const double WaitStartTime = FPlatformTime::Seconds();
+	const int32	 InitialCount = PendingCaptureCount;
+	if (!WaitForPipeline([this]() { return PendingCaptureCount == 0; }))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Readbacks did not complete after %.0fs (%d pending)"),
+			PipelineWaitTimeoutSeconds, PendingCaptureCount);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Drained %d pending readback(s) in %.1fms"),
+		InitialCount - PendingCaptureCount, (FPlatformTime::Seconds() - WaitStartTime) * 1000.0);
+	return PendingCaptureCount == 0;
+}
+
+void UCameraCaptureSubsystem::EnsureCameraRenderTarget(FRegisteredCamera& Entry, UIntrinsicSceneCaptureComponent2D* Camera)
+{
+	if (UTextureRenderTarget2D* Existing = Camera->TextureTarget)
+	{
+		// A target assigned by the camera's owner stays on the camera and out of the pool
+		if (Existing != Entry.OwnedRgbTarget.Get())
+		{
+			Entry.bPoolableRgb = false;
+			Entry.RgbFormat = Existing->RenderTargetFormat;
+			Entry.OwnedRgbTarget = nullptr;
+		}
+		return;
+	}
+
+	// Pooled captures borrow a target per capture
+	Entry.bPoolableRgb = true;
+	if (bPoolRenderTargets)
+	{
+		return;
+	}
+
+	FCameraIntrinsics Intrinsics = Camera->GetActiveIntrinsics();
+	int32			  Width = Intrinsics.ImageWidth;
+	int32			  Height = Intrinsics.ImageHeight;
+
+	// RGB only needs 8-bit unless the camera's own target used another format
+	UTextureRenderTarget2D* NewRenderTarget = NewObject<UTextureRenderTarget2D>(Camera);
+	NewRenderTarget->RenderTargetFormat = Entry.RgbFormat;
+	NewRenderTarget->InitAutoFormat(Width, Height);
+	NewRenderTarget->UpdateResourceImmediate(true);
+
+	Camera->TextureTarget = NewRenderTarget;
+	Entry.OwnedRgbTarget = NewRenderTarget;
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Created render target (%dx%d, format %d) for camera %s"),
+		Width, Height, static_cast<int32>(Entry.RgbFormat.GetValue()), *Camera->GetName());
+}
+
+void UCameraCaptureSubsystem::EnsureDmvRenderTarget(UIntrinsicSceneCaptureComponent2D* RgbCamera, USceneCaptureComponent2D* DmvCamera)
+{
+	if (bPoolRenderTargets || DmvCamera->TextureTarget)
+	{
+		return;
+	}
+
+	// RGBA32f for depth float precision. Uses depth intrinsics dimensions
+	// (may differ from RGB if separate depth intrinsics are set)
+	FCameraIntrinsics DepthIntrinsics = RgbCamera->GetActiveDepthIntrinsics();
+
+	UTextureRenderTarget2D* DmvRT = NewObject<UTextureRenderTarget2D>(this);
+	DmvRT->RenderTargetFormat = RTF_RGBA32f;
+	DmvRT->InitAutoFormat(DepthIntrinsics.ImageWidth, DepthIntrinsics.ImageHeight);
+	DmvRT->UpdateResourceImmediate(true);
+
+	DmvCamera->TextureTarget = DmvRT;
+	DmvRenderTargets.Add(RgbCamera, DmvRT);
+}
+
+void UCameraCaptureSubsystem::RenderWithoutReadback(const FRegisteredCamera& Entry, UIntrinsicSceneCaptureComponent2D* Camera)
+{
+	if (bCaptureRGB)
+	{
+		const bool bPooledRgb = bPoolRenderTargets && Entry.bPoolableRgb;
+		if (bPooledRgb)
+		{
+			const FCameraIntrinsics Intrinsics = Camera->GetActiveIntrinsics();
+			BindPooledTarget(Camera, Intrinsics.ImageWidth, Intrinsics.ImageHeight, Entry.RgbFormat);
+		}
+
+		if (Camera->TextureTarget)
+		{
+			Camera->CaptureScene();
+		}
+
+		if (bPooledRgb)
+		{
+			UnbindPooledTarget(Camera);
+		}
+	}
+
+	TWeakObjectPtr<USceneCaptureComponent2D>* DmvCameraPtr = DmvCameras.Find(Camera);
+	USceneCaptureComponent2D*				  DmvCamera = DmvCameraPtr ? DmvCameraPtr->Get() : nullptr;
+	if ((bCaptureDepth || bCaptureMotionVectors) && DmvCamera)
+	{
+		if (bPoolRenderTargets)
+		{
+			const FCameraIntrinsics DepthIntrinsics = Camera->GetActiveDepthIntrinsics();
+			BindPooledTarget(DmvCamera, DepthIntrinsics.ImageWidth, DepthIntrinsics.ImageHeight, RTF_RGBA32f);
+		}
+
+		DmvCamera->CaptureScene();
+
+		if (bPoolRenderTargets)
+		{
+			UnbindPooledTarget(DmvCamera);
+		}
+	}
+}
+
+// ============================================================================
+// Render Target Pool
+// ============================================================================
+
+void UCameraCaptureSubsystem::SetPixelBufferPooling(bool bEnabled, int32 MaxPooledMB)
+{
+	if (!bEnabled)
+	{
+		// Frames in flight keep their pool; new captures allocate directly
+		if (PixelBufferPool.IsValid())
+		{
+			PixelBufferPool->Empty();
+			PixelBufferPool.Reset();
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Pixel buffer pooling disabled"));
+		return;
+	}
+
+	if (!PixelBufferPool.IsValid())
+	{
+		PixelBufferPool = MakeShared<FCaptureBufferPool, ESPMode::ThreadSafe>();
+	}
+	PixelBufferPool->SetMaxPooledBytes(static_cast<int64>(FMath::Max(MaxPooledMB, 0)) * 1024 * 1024);
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Pixel buffer pooling enabled (max %d MB idle)"), MaxPooledMB);
+}
+
+// ============================================================================
+// Memory Budget
+// ============================================================================
+
+void UCameraCaptureSubsystem::SetMemoryBudget(int32 BudgetMB, ECaptureMemoryOverflowPolicy Policy)
+{
+	// Captures already holding reservations keep them; only admission changes
+	MemoryTracker->SetBudgetBytes(static_cast<int64>(FMath::Max(BudgetMB, 0)) * 1024 * 1024);
+	MemoryOverflowPolicy = Policy;
+
+	const TCHAR* PolicyName = TEXT("skip kick");
+	if (Policy == ECaptureMemoryOverflowPolicy::DropOldest)
+	{
+		PolicyName = TEXT("drop oldest");
+	}
+	else if (Policy == ECaptureMemoryOverflowPolicy::Block)
+	{
+		PolicyName = TEXT("block");
+	}
+
+	if (BudgetMB > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Capture memory budget %d MB (%s)"), BudgetMB, PolicyName);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Capture memory budget unlimited (accounting only)"));
+	}
+}
+
+int64 UCameraCaptureSubsystem::EstimateCaptureBytes(const FCaptureKickRecord& Record, int64& OutPlaneBytes) const
+{
+	// Pooled planes are rounded up to the pool's size class
+	auto PlaneBytes = [this](int64 Bytes) {
+		return PixelBufferPool.IsValid() ? Align(Bytes, FCaptureBufferPool::SizeClassBytes) : Bytes;
+	};
+
+	const int64 RgbPixels = bCaptureRGB ? static_cast<int64>(Record.RgbWidth) * Record.RgbHeight : 0;
+	const int64 DmvPixels = ((bCaptureDepth || bCaptureMotionVectors) && Record.DmvCamera) ? static_cast<int64>(Record.DmvWidth) * Record.DmvHeight : 0;
+
+	OutPlaneBytes = 0;
+	if (RgbPixels > 0)
+	{
+		OutPlaneBytes += PlaneBytes(RgbPixels * sizeof(FColor));
+	}
+	if (DmvPixels > 0)
+	{
+		// The DMV harvest fills depth and motion planes together
+		OutPlaneBytes += PlaneBytes(DmvPixels * sizeof(float)) + PlaneBytes(DmvPixels * sizeof(FVector2D));
+	}
+
+	if (!bSerializationEnabled)
+	{
+		return OutPlaneBytes;
+	}
+
+	// WriteEXRFile_Static: two FLinearColor staging arrays plus one queued copy per file
+	const int64 EncodePixels = FMath::Max(RgbPixels, DmvPixels);
+	const int64 NumFiles = bCaptureMotionVectors ? 2 : 1;
+	return OutPlaneBytes + EncodePixels * sizeof(FLinearColor) * (2 + NumFiles);
+}
+
+FCaptureMemoryTracker::FReservationPtr UCameraCaptureSubsystem::ReserveCaptureMemory(int64 Bytes, bool bMustCapture)
+{
+	if (FCaptureMemoryTracker::FReservationPtr Reservation = MemoryTracker->TryReserve(Bytes))
+	{
+		return Reservation;
+	}
+
+	// Offline and explicit captures waited for memory before the kick; anything still missing is an overrun
+	if (bMustCapture)
+	{
+		return MemoryTracker->ForceReserve(Bytes);
+	}
+
+	if (MemoryOverflowPolicy == ECaptureMemoryOverflowPolicy::DropOldest)
+	{
+		while (DropOldestPendingCapture())
+		{
+			if (FCaptureMemoryTracker::FReservationPtr Reservation = MemoryTracker->TryReserve(Bytes))
+			{
+				return Reservation;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+bool UCameraCaptureSubsystem::WaitForCaptureMemory()
+{
+	const int64 BudgetBytes = MemoryTracker->GetBudgetBytes();
+	if (BudgetBytes <= 0)
+	{
+		return true;
+	}
+
+	int64 KickBytes = 0;
+	for (const FCaptureKickRecord& Record : KickList)
+	{
+		int64 PlaneBytes = 0;
+		KickBytes += EstimateCaptureBytes(Record, PlaneBytes);
+	}
+
+	// A kick larger than the whole budget can at best start from empty
+	KickBytes = FMath::Min(KickBytes, BudgetBytes);
+	if (MemoryTracker->WouldFit(KickBytes))
+	{
+		return true;
+	}
+
+	// Only readbacks, emits and the writer give memory back while we wait. Frames listeners
+	// hold on to stay until they let go, so don't stall on memory that won't come back.
+	const int64 DeficitBytes = MemoryTracker->GetReservedBytes() + KickBytes - BudgetBytes;
+	const int64 DrainableBytes = MemoryTracker->GetStageBytes(ECaptureMemoryStage::Readback) + MemoryTracker->GetStageBytes(ECaptureMemoryStage::AwaitingEmit)
+		+ MemoryTracker->GetStageBytes(ECaptureMemoryStage::QueuedForWrite) + MemoryTracker->GetStageBytes(ECaptureMemoryStage::Encoding);
+	if (DrainableBytes < DeficitBytes)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("[CameraCaptureSubsystem] Not waiting for capture memory: %.1f MB short, only %.1f MB draining"),
+			DeficitBytes / (1024.0 * 1024.0), DrainableBytes / (1024.0 * 1024.0));
+		return false;
+	}
+
+	// Memory comes back as readbacks are harvested and the writer gets frames onto disk
+	if (!WaitForPipeline([this, KickBytes]() { return MemoryTracker->WouldFit(KickBytes); }))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Capture memory did not drain after %.0fs (%.1f MB reserved of %.1f MB), continuing"),
+			PipelineWaitTimeoutSeconds, MemoryTracker->GetReservedBytes() / (1024.0 * 1024.0), BudgetBytes / (1024.0 * 1024.0));
+		return false;
+	}
+	return true;
+}
+
+bool UCameraCaptureSubsystem::DropOldestPendingCapture()
+{
+	for (;;)
+	{
+		// Only the front of a queue can go without breaking its camera's emit order
+		FPendingCaptureQueue* Oldest = nullptr;
+		for (FPendingCaptureQueue& Queue : PendingQueues)
+		{
+			if (Queue.Captures.IsEmpty())
+			{
+				continue;
+			}
+
+			const FPendingCameraCapture& Front = Queue.Captures.First();
+			if (!Front.Readback.IsValid() || !Front.Readback->MemoryReservation || Front.Readback->bClaimed.load())
+			{
+				continue;
+			}
+
+			if (!Oldest || Front.KickTime < Oldest->Captures.First().KickTime)
+			{
+				Oldest = &Queue;
+			}
+		}
+
+		if (!Oldest)
+		{
+			return false;
+		}
+
+		// Lost to a harvest that started meanwhile: its pixels are on their way, try the next queue
+		FPendingCameraCapture& Pending = Oldest->Captures.First();
+		if (Pending.Readback->bClaimed.exchange(true))
+		{
+			continue;
+		}
+
+		const double WaitedMs = (FPlatformTime::Seconds() - Pending.KickTime) * 1000.0;
+		UE_LOG(LogTemp, Verbose, TEXT("[CameraCaptureSubsystem] Dropping capture for %s (over memory budget, waited %.1fms)"),
+			*Pending.Metadata.GetCameraInfo().CameraID.ToString(), WaitedMs);
+		RecordReadbackOutcome(Pending, WaitedMs, true);
+
+		if (FRegisteredCamera* Entry = FindRegisteredCamera(Pending.Camera))
+		{
+			Entry->Schedule.FramesOverBudget++;
+		}
+
+		// Nobody will harvest it now; give its memory back even while the watcher still holds it
+		FReadbackCompletion& Completion = *Pending.Readback;
+		MemoryTracker->AddStageBytes(ECaptureMemoryStage::Readback, -Completion.ReadbackBytes);
+		Completion.ReadbackBytes = 0;
+		Completion.MemoryReservation.Reset();
+
+		const int64 FrameNumber = Pending.Metadata.FrameNumber;
+		Oldest->Captures.PopFirst();
+		PendingCaptureCount--;
+
+		// Completing a frame set broadcasts it; that waits until the kick loop is done
+		if (bAssembleFrameSets)
+		{
+			FrameSetViewsDroppedOverBudget.Add(FrameNumber);
+		}
+		return true;
+	}
+}
+
+void UCameraCaptureSubsystem::SetRenderTargetPooling(bool bEnabled)
+{
+	if (bEnabled == bPoolRenderTargets)
+	{
+		return;
+	}
+	bPoolRenderTargets = bEnabled;
+
+	for (auto It = CameraRegistry.CreateIterator(); It; ++It)
+	{
+		FRegisteredCamera&				   Entry = *It;
+		UIntrinsicSceneCaptureComponent2D* Camera = Entry.Camera.Get();
+		if (!Camera)
+		{
+			continue;
+		}
+
+		TWeakObjectPtr<USceneCaptureComponent2D>* DmvCameraPtr = DmvCameras.Find(Camera);
+		USceneCaptureComponent2D*				  DmvCamera = DmvCameraPtr ? DmvCameraPtr->Get() : nullptr;
+
+		if (bEnabled)
+		{
+			// Dedicated targets the subsystem created are garbage collected once nothing
+			// references them. Targets assigned by the camera's owner are left in place.
+			UTextureRenderTarget2D* RgbTarget = Camera->TextureTarget;
+			if (RgbTarget && RgbTarget == Entry.OwnedRgbTarget.Get())
+			{
+				Entry.RgbFormat = RgbTarget->RenderTargetFormat;
+				Camera->TextureTarget = nullptr;
+			}
+			Entry.OwnedRgbTarget = nullptr;
+			if (DmvCamera)
+			{
+				DmvCamera->TextureTarget = nullptr;
+			}
+			DmvRenderTargets.Remove(Camera);
+		}
+		else if (Entry.bResourcesReady)
+		{
+			// Give the camera dedicated targets again (cameras with their own RGB target
+			// only get their DMV target back)
+			Entry.bResourcesReady = false;
+			QueueResourceSetup(FCameraHandle{ It.GetIndex(), Entry.Serial });
+		}
+	}
+
+	if (!bEnabled)
+	{
+		ReleaseRenderTargetPool();
+	}
+	bKickListDirty = true;
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Render target pooling %s"), bEnabled ? TEXT("enabled") : TEXT("disabled"));
+}
+
+UTextureRenderTarget2D* UCameraCaptureSubsystem::BindPooledTarget(USceneCaptureComponent2D* Capture, int32 Width, int32 Height, ETextureRenderTargetFormat Format)
+{
+	if (Width < 1 || Height < 1)
+	{
+		return nullptr;
+	}
+
+	UTextureRenderTarget2D*		 Target = nullptr;
+	TArray<FPooledRenderTarget>* FreeList = FreeRenderTargets.Find(FIntVector(Width, Height, Format));
+	if (FreeList && FreeList->Num() > 0)
+	{
+		Target = FreeList->Pop(false).Target;
+	}
+	else
+	{
+		Target = NewObject<UTextureRenderTarget2D>(this);
+		Target->RenderTargetFormat = Format;
+		Target->InitAutoFormat(Width, Height);
+		Target->UpdateResourceImmediate(true);
+		PooledRenderTargets.Add(Target);
+
+		PooledRenderTargetBytes += GetRenderTargetBytes(Width, Height, Format);
+		PeakPooledRenderTargetBytes = FMath::Max(PeakPooledRenderTargetBytes, PooledRenderTargetBytes);
+
+		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Created pooled render target (%dx%d, format %d), pool holds %d targets / %.1f MB"),
+			Width, Height, static_cast<int32>(Format), PooledRenderTargets.Num(), PooledRenderTargetBytes / (1024.0 * 1024.0));
+	}
+
+	Capture->TextureTarget = Target;
+	return Target;
+}
+
+void UCameraCaptureSubsystem::UnbindPooledTarget(USceneCaptureComponent2D* Capture)
+{
+	UTextureRenderTarget2D* Target = Capture->TextureTarget;
+	if (!Target)
+	{
+		return;
+	}
+
+	Capture->TextureTarget = nullptr;
+	FreeRenderTargets.FindOrAdd(FIntVector(Target->SizeX, Target->SizeY, Target->RenderTargetFormat))
+		.Add({ Target, RenderTargetPoolKicks });
+}
+
+void UCameraCaptureSubsystem::TrimRenderTargetPool(uint64 IdleKicks)
+{
+	int32 Released = 0;
+
+	for (auto It = FreeRenderTargets.CreateIterator(); It; ++It)
+	{
+		TArray<FPooledRenderTarget>& FreeList = It.Value();
+		for (int32 i = FreeList.Num() - 1; i >= 0; --i)
+		{
+			if (RenderTargetPoolKicks - FreeList[i].LastUsedKick <= IdleKicks)
+			{
+				continue;
+			}
+
+			// Unreferenced targets are garbage collected; pending copies keep their RHI texture alive
+			PooledRenderTargets.RemoveSingleSwap(FreeList[i].Target);
+			PooledRenderTargetBytes -= GetRenderTargetBytes(It.Key().X, It.Key().Y, static_cast<ETextureRenderTargetFormat>(It.Key().Z));
+			FreeList.RemoveAtSwap(i);
+			Released++;
+		}
+
+		if (FreeList.Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (Released > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Released %d idle pooled render target(s), pool holds %d targets / %.1f MB"),
+			Released, PooledRenderTargets.Num(), PooledRenderTargetBytes / (1024.0 * 1024.0));
+	}
+}
+
+void UCameraCaptureSubsystem::ReleaseRenderTargetPool()
+{
+	FreeRenderTargets.Empty();
+	PooledRenderTargets.Empty();
+	PooledRenderTargetBytes = 0;
+}
+
+int64 UCameraCaptureSubsystem::GetRenderTargetBytes(int32 Width, int32 Height, ETextureRenderTargetFormat Format)
+{
+	int64 BytesPerPixel = 4;
+	switch (Format)
+	{
+		case RTF_RGBA16f:
+			BytesPerPixel = 8;
+			break;
+		case RTF_RGBA32f:
+			BytesPerPixel = 16;
+			break;
+		default:
+			break;
+	}
+	return static_cast<int64>(FMath::Max(0, Width)) * FMath::Max(0, Height) * BytesPerPixel;
+}
+
+// ============================================================================
+// Kick List
+// ============================================================================
+
+void UCameraCaptureSubsystem::RebuildKickList()
+{
+	// Removing sets the list dirty again; it is rebuilt right below
+	for (auto It = CameraRegistry.CreateIterator(); It; ++It)
+	{
+		if (!IsValid(It->Camera.Get()))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Removing destroyed camera: %s"), *It->Identifier.ToString());
+			RemoveRegisteredCamera(It.GetIndex());
+		}
+	}
+
+	KickList.Reset(CameraRegistry.Num());
+
+	for (auto It = CameraRegistry.CreateIterator(); It; ++It)
+	{
+		FRegisteredCamera& Entry = *It;
+		Entry.KickIndex = KickList.Num();
+
+		FCaptureKickRecord& Record = KickList.AddDefaulted_GetRef();
+		Record.Camera = Entry.Camera.Get();
+		Record.RegistryIndex = It.GetIndex();
+		RefreshKickRecord(Record, Record.Camera);
+	}
+
+	bKickListDirty = false;
+}
+
+void UCameraCaptureSubsystem::OnCameraComponentUnregistered(UIntrinsicSceneCaptureComponent2D* Camera)
 {
-	FCaptureStatistics Stats;
-	Stats.TotalFramesCaptured = TotalFramesCaptured;
-	Stats.RegisteredCameraCount = RegisteredCameras.Num();
-	Stats.AverageCaptureTimeMs = AverageCaptureTimeMs;
-	Stats.LastCaptureTimeMs = LastCaptureDurationMs;
-	return Stats;
+	if (FindRegisteredCamera(Camera))
+	{
+		bKickListDirty = true;
+	}
 }
 
-// ============================================================================
-// Legacy wrapper
-// ============================================================================
+void UCameraCaptureSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
 
-void UCameraCaptureSubsystem::ExecuteSynchronizedCapture()
+	UCameraCaptureSubsystem* This = CastChecked<UCameraCaptureSubsystem>(InThis);
+	for (FCaptureKickRecord& Record : This->KickList)
+	{
+		Collector.AddReferencedObject(Record.Camera);
+		Collector.AddReferencedObject(Record.RgbTarget);
+		Collector.AddReferencedObject(Record.DmvCamera);
+		Collector.AddReferencedObject(Record.DmvTarget);
+	}
+}
+
+void UCameraCaptureSubsystem::RefreshKickRecord(FCaptureKickRecord& Record, UIntrinsicSceneCaptureComponent2D* Camera)
 {
-	KickAllCaptures();
+	TWeakObjectPtr<USceneCaptureComponent2D>* DmvCameraPtr = DmvCameras.Find(Camera);
+	USceneCaptureComponent2D*				  DmvCamera = DmvCameraPtr ? DmvCameraPtr->Get() : nullptr;
+	Record.DmvCamera = DmvCamera;
+
+	// Pooled targets are bound per capture; record the sizes and format to borrow.
+	// Cameras whose owner assigned a target keep using it.
+	const FRegisteredCamera& Entry = CameraRegistry[Record.RegistryIndex];
+	Record.bPooledRgb = bPoolRenderTargets && Entry.bPoolableRgb;
+	if (Record.bPooledRgb)
+	{
+		const FCameraIntrinsics Intrinsics = Camera->GetActiveIntrinsics();
+		Record.RgbTarget = nullptr;
+		Record.RgbWidth = Intrinsics.ImageWidth;
+		Record.RgbHeight = Intrinsics.ImageHeight;
+		Record.RgbFormat = Entry.RgbFormat;
+	}
+	else
+	{
+		UTextureRenderTarget2D* RgbTarget = Camera->TextureTarget;
+		Record.RgbTarget = RgbTarget;
+		Record.RgbWidth = RgbTarget ? RgbTarget->SizeX : 0;
+		Record.RgbHeight = RgbTarget ? RgbTarget->SizeY : 0;
+		Record.RgbFormat = RgbTarget ? RgbTarget->RenderTargetFormat.GetValue() : RTF_RGBA8;
+	}
+	Record.bRgbIsFloat = Record.RgbFormat == RTF_RGBA32f || Record.RgbFormat == RTF_RGBA16f;
+
+	// DMV targets are always the subsystem's, so they follow the pooling setting
+	if (bPoolRenderTargets)
+	{
+		const FCameraIntrinsics DepthIntrinsics = Camera->GetActiveDepthIntrinsics();
+		Record.DmvTarget = nullptr;
+		Record.DmvWidth = DmvCamera ? DepthIntrinsics.ImageWidth : 0;
+		Record.DmvHeight = DmvCamera ? DepthIntrinsics.ImageHeight : 0;
+		return;
+	}
+
+	UTextureRenderTarget2D* DmvTarget = DmvCamera ? DmvCamera->TextureTarget.Get() : nullptr;
+	Record.DmvTarget = DmvTarget;
+	Record.DmvWidth = DmvTarget ? DmvTarget->SizeX : 0;
+	Record.DmvHeight = DmvTarget ? DmvTarget->SizeY : 0;
+}
+
+void UCameraCaptureSubsystem::RefreshKickRecord(UIntrinsicSceneCaptureComponent2D* Camera)
+{
+	if (bKickListDirty)
+	{
+		return;
+	}
+
+	const FRegisteredCamera* Entry = FindRegisteredCamera(Camera);
+	if (Entry && KickList.IsValidIndex(Entry->KickIndex))
+	{
+		RefreshKickRecord(KickList[Entry->KickIndex], Camera);
+	}
 }
 
 // ============================================================================
-// Phase 1: Kick all scene captures + enqueue async GPU readbacks
+// Deferred Resource Setup
 // ============================================================================
 
-void UCameraCaptureSubsystem::KickAllCaptures()
+void UCameraCaptureSubsystem::QueueResourceSetup(FCameraHandle Handle)
 {
-	double StartTime = FPlatformTime::Seconds();
-	int32  KickedCount = 0;
+	PendingResourceSetups.Add(Handle);
+	PendingResourceSetupCount++;
+}
 
-	for (int32 i = RegisteredCameras.Num() - 1; i >= 0; --i)
+void UCameraCaptureSubsystem::SetupCameraResources(FRegisteredCamera& Entry)
+{
+	UIntrinsicSceneCaptureComponent2D* Camera = Entry.Camera.Get();
+	if (Entry.bResourcesReady || !Camera)
 	{
-		TWeakObjectPtr<UIntrinsicSceneCaptureComponent2D>& WeakCamera = RegisteredCameras[i];
+		return;
+	}
 
-		if (!WeakCamera.IsValid())
-		{
-			UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Removing invalid camera at index %d"), i);
-			RegisteredCameras.RemoveAt(i);
-			continue;
-		}
+	EnsureCameraRenderTarget(Entry, Camera);
 
-		UIntrinsicSceneCaptureComponent2D* Camera = WeakCamera.Get();
+	// Create DMV camera if depth/motion capture is enabled (or re-create its target
+	// after pooling was turned off)
+	TWeakObjectPtr<USceneCaptureComponent2D>* DmvCameraPtr = DmvCameras.Find(Camera);
+	if (DmvCameraPtr && DmvCameraPtr->IsValid())
+	{
+		EnsureDmvRenderTarget(Camera, DmvCameraPtr->Get());
+	}
+	else if ((bCaptureDepth || bCaptureMotionVectors) && DmvCaptureMaterialBase)
+	{
+		SetupDmvCamera(Camera);
+	}
 
-		// Ensure render targets exist
-		EnsureCameraRenderTarget(Camera);
+	Entry.bResourcesReady = true;
+	PendingResourceSetupCount--;
+	RefreshKickRecord(Camera);
+}
 
-		// Build metadata snapshot (cheap — no pixel data)
-		FPendingCameraCapture Pending;
-		Pending.Metadata = BuildCaptureMetadata(Camera);
+void UCameraCaptureSubsystem::ProcessPendingResourceSetups(double BudgetSeconds)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	int32		 Processed = 0;
+	int32		 SetUp = 0;
 
-		// --- Kick RGB capture + enqueue async readback ---
-		if (bCaptureRGB && Camera->TextureTarget)
+	while (Processed < PendingResourceSetups.Num())
+	{
+		FRegisteredCamera* Entry = FindRegisteredCamera(PendingResourceSetups[Processed++]);
+		if (!Entry || Entry->bResourcesReady)
 		{
-			Camera->CaptureScene();
+			continue; // Unregistered, or set up early by an explicit capture
+		}
 
-			UTextureRenderTarget2D* RgbRT = Camera->TextureTarget;
-			Pending.RgbReadback.Width = RgbRT->SizeX;
-			Pending.RgbReadback.Height = RgbRT->SizeY;
-			Pending.RgbReadback.bIsFloat = (RgbRT->RenderTargetFormat == RTF_RGBA32f || RgbRT->RenderTargetFormat == RTF_RGBA16f);
-			Pending.Metadata.Width = RgbRT->SizeX;
-			Pending.Metadata.Height = RgbRT->SizeY;
+		SetupCameraResources(*Entry);
+		SetUp++;
 
-			EnqueueAsyncReadback(RgbRT, Pending.RgbReadback.Readback);
-			Pending.bHasRgb = true;
+		if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
 		}
+	}
+	PendingResourceSetups.RemoveAt(0, Processed, false);
 
-		// --- Kick DMV capture + enqueue async readback ---
-		if (bCaptureDepth || bCaptureMotionVectors)
-		{
-			TWeakObjectPtr<USceneCaptureComponent2D>* DmvCameraPtr = DmvCameras.Find(Camera);
-			if (DmvCameraPtr && DmvCameraPtr->IsValid())
-			{
-				USceneCaptureComponent2D* DmvCamera = DmvCameraPtr->Get();
-				DmvCamera->CaptureScene();
+	if (SetUp > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Set up capture resources for %d camera(s) in %.2fms, %d pending"),
+			SetUp, (FPlatformTime::Seconds() - StartTime) * 1000.0, PendingResourceSetupCount);
+	}
+}
 
-				UTextureRenderTarget2D* DmvRT = DmvCamera->TextureTarget;
-				if (DmvRT)
-				{
-					Pending.DmvReadback.Width = DmvRT->SizeX;
-					Pending.DmvReadback.Height = DmvRT->SizeY;
-					Pending.DmvReadback.bIsFloat = true; // DMV is always RGBA32f
+void UCameraCaptureSubsystem::PrewarmCapture()
+{
+	const double StartTime = FPlatformTime::Seconds();
 
-					EnqueueAsyncReadback(DmvRT, Pending.DmvReadback.Readback);
-					Pending.bHasDmv = true;
-				}
-			}
-		}
+	ProcessPendingResourceSetups(TNumericLimits<double>::Max());
 
-		// If neither RGB nor DMV was kicked, skip enqueueing this capture
-		// (should be rare since RGB is usually enabled, but just in case)
-		if (!Pending.bHasRgb && !Pending.bHasDmv)
+#if WITH_EDITOR
+	// Materials used by the captures (including the DMV post-process) may still be compiling
+	if (GShaderCompilingManager)
+	{
+		GShaderCompilingManager->FinishAllCompilation();
+	}
+#endif
+
+	// Render every camera once so its shaders/PSOs are compiled and its targets are resident
+	for (const FRegisteredCamera& Entry : CameraRegistry)
+	{
+		UIntrinsicSceneCaptureComponent2D* Camera = Entry.Camera.Get();
+		if (!Camera || !IsCameraInShard(Camera))
 		{
 			continue;
 		}
 
-		// Only enqueue a pending capture if at least one channel was actually
-		// kicked
-		PendingCaptures.Add(MoveTemp(Pending));
-		KickedCount++;
+		RenderWithoutReadback(Entry, Camera);
 	}
 
-	FrameIdCounter++;
+	FlushRenderingCommands();
 
-	double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
-	LastCaptureDurationMs = static_cast<float>(ElapsedMs);
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Prewarmed %d cameras in %.1fms"),
+		CameraRegistry.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
 
-	// Running average
-	if (AverageCaptureTimeMs == 0.0f)
+void UCameraCaptureSubsystem::SetResourceSetupBudget(float BudgetMs)
+{
+	ResourceSetupBudgetMs = FMath::Max(0.0f, BudgetMs);
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Set resource setup budget: %.2fms per tick"), ResourceSetupBudgetMs);
+}
+
+// ============================================================================
+// Serialization (dispatched to background thread)
+// ============================================================================
+
+void UCameraCaptureSubsystem::SerializeCaptureData(TSharedRef<const FCaptureData> Data)
+{
+	FString OutputDir = OutputDirectory;
+	bool	bRGB = bCaptureRGB;
+	bool	bDepth = bCaptureDepth;
+	bool	bMotion = bCaptureMotionVectors;
+
+	TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> Backlog = SerializationBacklog;
+	PeakSerializationBacklog = FMath::Max(PeakSerializationBacklog, Backlog->Increment());
+
+	AddShardManifestEntry(*Data);
+
+	const int64 QueuedBytes = GetPixelPlaneBytes(*Data);
+	MemoryTracker->AddStageBytes(ECaptureMemoryStage::QueuedForWrite, QueuedBytes);
+
+	// Lambda captures the shared ref — keeps data alive until async write completes
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+		[Data, OutputDir, bRGB, bDepth, bMotion, Backlog, OnWritten = MakeWriteRecorder(*Data), Memory = MemoryTracker, QueuedBytes]() {
+			WriteCaptureFiles_Static(OutputDir, *Data, bRGB, bDepth, bMotion, OnWritten);
+			Memory->AddStageBytes(ECaptureMemoryStage::QueuedForWrite, -QueuedBytes);
+			Backlog->Decrement();
+		});
+}
+
+void UCameraCaptureSubsystem::SerializeFrameSet(TSharedRef<const FCaptureFrameSet> FrameSet)
+{
+	FString OutputDir = OutputDirectory;
+	bool	bRGB = bCaptureRGB;
+	bool	bDepth = bCaptureDepth;
+	bool	bMotion = bCaptureMotionVectors;
+
+	// The backlog counts frames, so the set adds one per view and drains as each is written
+	TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> Backlog = SerializationBacklog;
+	PeakSerializationBacklog = FMath::Max(PeakSerializationBacklog, Backlog->Add(FrameSet->Frames.Num()) + FrameSet->Frames.Num());
+
+	TArray<TFunction<void(bool, int64)>> Recorders;
+	Recorders.Reserve(FrameSet->Frames.Num());
+	for (const TSharedRef<const FCaptureData>& Data : FrameSet->Frames)
 	{
-		AverageCaptureTimeMs = LastCaptureDurationMs;
+		AddShardManifestEntry(*Data);
+		Recorders.Add(MakeWriteRecorder(*Data));
+		MemoryTracker->AddStageBytes(ECaptureMemoryStage::QueuedForWrite, GetPixelPlaneBytes(*Data));
 	}
-	else
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+		[FrameSet, OutputDir, bRGB, bDepth, bMotion, Backlog, Recorders = MoveTemp(Recorders), Memory = MemoryTracker]() {
+			for (int32 i = 0; i < FrameSet->Frames.Num(); ++i)
+			{
+				WriteCaptureFiles_Static(OutputDir, *FrameSet->Frames[i], bRGB, bDepth, bMotion, Recorders[i]);
+				Memory->AddStageBytes(ECaptureMemoryStage::QueuedForWrite, -GetPixelPlaneBytes(*FrameSet->Frames[i]));
+				Backlog->Decrement();
+			}
+		});
+}
+
+TFunction<void(bool, int64)> UCameraCaptureSubsystem::MakeWriteRecorder(const FCaptureData& Data) const
+{
+	TSharedPtr<FCapturePipelineCounters, ESPMode::ThreadSafe> CameraCounters;
+	if (const int32* Index = UniqueIDIndices.Find(Data.GetCameraInfo().CameraID.UniqueID))
 	{
-		AverageCaptureTimeMs = AverageCaptureTimeMs * 0.9f + LastCaptureDurationMs * 0.1f;
+		CameraCounters = CameraRegistry[*Index].Counters;
 	}
 
-	UE_LOG(LogTemp, Verbose, TEXT("[CameraCaptureSubsystem] Kicked %d cameras in %.2fms (frame %lld, pending: %d)"),
-		KickedCount, ElapsedMs, FrameIdCounter, PendingCaptures.Num());
+	// Only set while the timeline records; FinishTimelineRecording waits for these spans
+	TSharedPtr<FThreadSafeCounter, ESPMode::ThreadSafe> TimelineWrites;
+	if (FCaptureTimeline::IsRecording())
+	{
+		TimelineWrites = PendingTimelineWrites;
+		TimelineWrites->Increment();
+	}
+
+	// Runs on a serializer thread, or on the ImageWriteQueue thread that writes the frame's last file
+	return [CameraCounters, Session = SessionCounters, HandoffTime = FPlatformTime::Seconds(), TimelineWrites, TimelineCameraID = Data.GetCameraInfo().TraceName, FrameNumber = Data.FrameNumber](bool bSucceeded, int64 Bytes) {
+		const double Now = FPlatformTime::Seconds();
+		const double LatencyMs = (Now - HandoffTime) * 1000.0;
+		Session->RecordWrite(bSucceeded, Bytes, LatencyMs);
+		if (CameraCounters)
+		{
+			CameraCounters->RecordWrite(bSucceeded, Bytes, LatencyMs);
+		}
+		if (TimelineWrites)
+		{
+			FCaptureTimeline::Record(bSucceeded ? TEXT("Write") : TEXT("Write (failed)"), TimelineCameraID, FrameNumber, HandoffTime, Now, FCaptureTimeline::ETrack::Write);
+			TimelineWrites->Decrement();
+		}
+	};
 }
 
-void UCameraCaptureSubsystem::EnqueueAsyncReadback(UTextureRenderTarget2D* RenderTarget, TUniquePtr<FRHIGPUTextureReadback>& OutReadback)
+void UCameraCaptureSubsystem::FCaptureWriteTracker::EndFile(bool bSucceeded, int64 FileBytes)
 {
-	if (!RenderTarget)
+	Bytes.fetch_add(FMath::Max<int64>(FileBytes, 0));
+	if (!bSucceeded)
 	{
-		return;
+		bFailed = true;
 	}
 
-	FTextureRenderTargetResource* RTResource = RenderTarget->GameThread_GetRenderTargetResource();
-	if (!RTResource)
+	if (PendingFiles.fetch_sub(1) == 1 && OnWritten)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] No render target resource for async readback"));
-		return;
+		OnWritten(!bFailed.load(), Bytes.load());
 	}
+}
 
-	OutReadback = MakeUnique<FRHIGPUTextureReadback>(TEXT("CamCaptureReadback"));
+void UCameraCaptureSubsystem::AddShardManifestEntry(const FCaptureData& Data)
+{
+	if (!bShardConfigured)
+	{
+		return;
+	}
 
-	FRHIGPUTextureReadback*		  ReadbackPtr = OutReadback.Get();
-	FTextureRenderTargetResource* ResourcePtr = RTResource;
+	const FCameraIdentifier& CameraID = Data.GetCameraInfo().CameraID;
 
-	ENQUEUE_RENDER_COMMAND(CameraCaptureEnqueueReadback)
-	(
-		[ReadbackPtr, ResourcePtr](FRHICommandListImmediate& RHICmdList) {
-			FRHITexture* Texture = ResourcePtr->GetRenderTargetTexture();
-			if (Texture)
-			{
-				ReadbackPtr->EnqueueCopy(RHICmdList, Texture);
-			}
-		});
+	FShardManifestEntry& Entry = ShardManifestEntries.AddDefaulted_GetRef();
+	Entry.CameraID = CameraID.UniqueID;
+	Entry.CameraDirectory = CameraID.GetActorDirectoryName() / CameraID.GetCameraDirectoryName();
+	Entry.FrameNumber = Data.FrameNumber;
+	Entry.Timestamp = Data.Timestamp;
+	Entry.bUnchanged = Data.bUnchanged;
 }
 
-// ============================================================================
-// Phase 2: Poll pending readbacks + harvest completed ones
-// ============================================================================
-
-void UCameraCaptureSubsystem::HarvestReadyReadbacks()
+void UCameraCaptureSubsystem::WriteCaptureFiles_Static(const FString& OutputDir, const FCaptureData& Data, bool bCaptureRGB, bool bCaptureDepth, bool bCaptureMotionVectors,
+	TFunction<void(bool, int64)> OnWritten)
 {
-	if (PendingCaptures.Num() == 0)
+	TSharedPtr<FCaptureWriteTracker, ESPMode::ThreadSafe> Tracker;
+	if (OnWritten)
 	{
-		return;
+		Tracker = MakeShared<FCaptureWriteTracker, ESPMode::ThreadSafe>();
+		Tracker->OnWritten = MoveTemp(OnWritten);
 	}
 
-	for (int32 i = PendingCaptures.Num() - 1; i >= 0; --i)
+	FString AbsoluteOutputDir = OutputDir;
+	if (FPaths::IsRelative(AbsoluteOutputDir))
 	{
-		FPendingCameraCapture& Pending = PendingCaptures[i];
-		Pending.FramesWaiting++;
+		AbsoluteOutputDir = FPaths::Combine(*FPaths::ProjectDir(), *OutputDir);
+	}
 
-		// Check if ALL readbacks for this camera are ready (non-blocking poll)
-		bool bRgbReady = !Pending.bHasRgb || !Pending.RgbReadback.Readback || Pending.RgbReadback.Readback->IsReady();
-		bool bDmvReady = !Pending.bHasDmv || !Pending.DmvReadback.Readback || Pending.DmvReadback.Readback->IsReady();
+	FString CameraPath = Data.GetCameraInfo().CameraID.GetFullPath(AbsoluteOutputDir);
 
-		if (bRgbReady && bDmvReady)
+	{
+		CAMERA_CAPTURE_SCOPE(STAT_CameraCapture_FileIO, "Make Directory", Data.GetCameraInfo().TraceName, Data.FrameNumber);
+		if (!IFileManager::Get().DirectoryExists(*CameraPath))
 		{
-			// Harvest pixel data from GPU staging buffers (fast memcpy, no stall)
-			FCaptureData& Data = Pending.Metadata;
+			IFileManager::Get().MakeDirectory(*CameraPath, true);
+		}
+	}
 
-			if (Pending.bHasRgb && Pending.RgbReadback.Readback)
-			{
-				HarvestRgbReadback(Pending.RgbReadback, Data);
-			}
+	FString FrameNumberStr = FString::Printf(TEXT("%07lld"), Data.FrameNumber);
 
-			if (Pending.bHasDmv && Pending.DmvReadback.Readback)
-			{
-				HarvestDmvReadback(Pending.DmvReadback, Data);
-			}
+	// Write EXR (unchanged frames only get metadata pointing at the reference frame)
+	if (!Data.bUnchanged)
+	{
+		FString ExrPath = FPaths::Combine(CameraPath, FString::Printf(TEXT("frame_%s.exr"), *FrameNumberStr));
+		if (!WriteEXRFile_Static(ExrPath, Data, bCaptureRGB, bCaptureDepth, bCaptureMotionVectors, Tracker) && Tracker)
+		{
+			Tracker->bFailed = true;
+		}
+	}
 
-			// Wrap in shared ref so listeners can safely retain the data
-			TSharedRef<const FCaptureData> SharedData = MakeShared<FCaptureData>(MoveTemp(Data));
+	// Write metadata JSON
+	FString	   MetadataPath = FPaths::Combine(CameraPath, FString::Printf(TEXT("frame_%s.json"), *FrameNumberStr));
+	const bool bMetadataWritten = WriteMetadataFile_Static(MetadataPath, Data);
 
-			// Notify listeners (streaming, etc.)
-			OnFrameCaptured.Broadcast(SharedData);
+	// Releases the writer's own hold; completes now unless EXR writes are still queued
+	if (Tracker)
+	{
+		Tracker->EndFile(bMetadataWritten, bMetadataWritten ? IFileManager::Get().FileSize(*MetadataPath) : 0);
+	}
+}
 
-			if (bSerializationEnabled)
-			{
-				SerializeCaptureData(SharedData);
-			}
+bool UCameraCaptureSubsystem::WriteEXRFile_Static(const FString& FilePath, const FCaptureData& Data, bool bCaptureRGB, bool bCaptureDepth, bool bCaptureMotionVectors,
+	const TSharedPtr<FCaptureWriteTracker, ESPMode::ThreadSafe>& Tracker)
+{
+	// Safety checks
+	if (Data.Width <= 0 || Data.Height <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Invalid image dimensions: %dx%d"), Data.Width, Data.Height);
+		return false;
+	}
 
-			TotalFramesCaptured++;
+	int32 NumPixels = Data.Width * Data.Height;
+
+	if (Data.ImageData.Num() == 0 && Data.DepthData.Num() == 0 && Data.MotionVectorData.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] No image data to write"));
+		return false;
+	}
+
+	const FName CameraID = Data.GetCameraInfo().TraceName;
 
-			PendingCaptures.RemoveAt(i);
+	// Each queued file holds an FLinearColor copy on the ImageWriteQueue until it is written
+	// (keeping the capture's reservation alive), then reports its size
+	const FCaptureMemoryTracker::FReservationPtr& Reservation = Data.MemoryReservation;
+	const int64									  QueuedCopyBytes = static_cast<int64>(NumPixels) * sizeof(FLinearColor);
+
+	auto TrackFile = [&Tracker, &Reservation, QueuedCopyBytes](const FString& Path) -> TFunction<void(bool)> {
+		if (!Tracker && !Reservation)
+		{
+			return nullptr;
 		}
-		else if (Pending.FramesWaiting > MaxReadbackWaitFrames)
+		if (Tracker)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Dropping capture for %s (readback timed out after %d frames)"),
-				*Pending.Metadata.CameraID.ToString(), Pending.FramesWaiting);
-			PendingCaptures.RemoveAt(i);
+			Tracker->BeginFile();
 		}
-	}
-}
+		if (Reservation)
+		{
+			Reservation->GetTracker().AddStageBytes(ECaptureMemoryStage::Encoding, QueuedCopyBytes);
+		}
+		// Called on the writer thread, so the size lookup never touches the game thread
+		return [Tracker, Reservation, QueuedCopyBytes, Path](bool bSucceeded) {
+			if (Reservation)
+			{
+				Reservation->GetTracker().AddStageBytes(ECaptureMemoryStage::Encoding, -QueuedCopyBytes);
+			}
+			if (Tracker)
+			{
+				Tracker->EndFile(bSucceeded, bSucceeded ? IFileManager::Get().FileSize(*Path) : 0);
+			}
+		};
+	};
 
-void UCameraCaptureSubsystem::HarvestRgbReadback(FPendingReadback& Readback, FCaptureData& OutData)
-{
-	int32 RowPitchInPixels = 0;
-	int32 BufferHeight = 0;
-	void* SrcData = Readback.Readback->Lock(RowPitchInPixels, &BufferHeight);
+	// Convert FCaptureData format to TArray<FLinearColor> format expected by utility functions
+	TArray<FLinearColor> RgbData;
+	TArray<FLinearColor> DmvData;
 
-	if (!SrcData)
+	// The staging arrays live until the files are queued
+	const int64 StagingBytes = 2 * QueuedCopyBytes;
+	if (Reservation)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Failed to lock RGB readback"));
-		Readback.Readback->Unlock();
-		return;
+		Reservation->GetTracker().AddStageBytes(ECaptureMemoryStage::Encoding, StagingBytes);
 	}
+	ON_SCOPE_EXIT
+	{
+		if (Reservation)
+		{
+			Reservation->GetTracker().AddStageBytes(ECaptureMemoryStage::Encoding, -StagingBytes);
+		}
+	};
 
-	const int32 Width = Readback.Width;
-	const int32 Height = Readback.Height;
-	OutData.ImageData.SetNumUninitialized(Width * Height);
-
-	if (Readback.bIsFloat)
 	{
-		// Source is FLinearColor (RGBA32f) — convert to FColor
-		const FLinearColor* SrcRow = static_cast<const FLinearColor*>(SrcData);
-		for (int32 y = 0; y < Height; y++)
+		CAMERA_CAPTURE_SCOPE(STAT_CameraCapture_ExrPack, "EXR Pack", CameraID, Data.FrameNumber);
+
+		RgbData.SetNum(NumPixels);
+		DmvData.SetNum(NumPixels);
+
+		// Convert RGB from FColor to FLinearColor
+		if (bCaptureRGB && Data.ImageData.Num() == NumPixels)
 		{
-			for (int32 x = 0; x < Width; x++)
+			for (int32 i = 0; i < NumPixels; i++)
 			{
-				OutData.ImageData[y * Width + x] = SrcRow[x].ToFColor(true);
+				RgbData[i] = FLinearColor(Data.ImageData[i]);
 			}
-			SrcRow += RowPitchInPixels;
+		}
+		else
+		{
+			for (int32 i = 0; i < NumPixels; i++)
+			{
+				RgbData[i] = FLinearColor::Black;
+			}
+		}
+
+		// Prepare DMV data: Depth in R, Motion X in G, Motion Y in B
+		for (int32 i = 0; i < NumPixels; i++)
+		{
+			float Depth = (bCaptureDepth && Data.DepthData.Num() == NumPixels) ? Data.DepthData[i] : 0.0f;
+			float MotionX = (bCaptureMotionVectors && Data.MotionVectorData.Num() == NumPixels) ? Data.MotionVectorData[i].X : 0.0f;
+			float MotionY = (bCaptureMotionVectors && Data.MotionVectorData.Num() == NumPixels) ? Data.MotionVectorData[i].Y : 0.0f;
+
+			DmvData[i] = FLinearColor(Depth, MotionX, MotionY, 0.0f);
 		}
 	}
-	else
+
+	// Encoding and the file write run on the ImageWriteQueue; this covers interleaving + enqueue
+	CAMERA_CAPTURE_SCOPE(STAT_CameraCapture_ExrEnqueue, "EXR Enqueue", CameraID, Data.FrameNumber);
+
+	// Use shared utility to write RGB+Depth EXR. Files that never reach the queue complete here.
+	TFunction<void(bool)> OnRgbWritten = TrackFile(FilePath);
+	if (!CameraCaptureUtils::WriteEXRFile(FilePath, RgbData, DmvData, Data.Width, Data.Height, true, OnRgbWritten))
 	{
-		// Source is BGRA8 (FColor) — fast memcpy path
-		const FColor* SrcRow = static_cast<const FColor*>(SrcData);
-		if (Width == RowPitchInPixels)
+		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Failed to write RGB+Depth EXR: %s"), *FilePath);
+		if (OnRgbWritten)
 		{
-			FMemory::Memcpy(OutData.ImageData.GetData(), SrcData, Width * Height * sizeof(FColor));
+			OnRgbWritten(false);
 		}
-		else
+		return false;
+	}
+
+	// Write motion vectors to separate file if we have them
+	if (bCaptureMotionVectors && Data.MotionVectorData.Num() == NumPixels)
+	{
+		FString				  MotionPath = FilePath.Replace(TEXT(".exr"), TEXT("_motion.exr"));
+		TFunction<void(bool)> OnMotionWritten = TrackFile(MotionPath);
+		if (!CameraCaptureUtils::WriteEXRFile(MotionPath, RgbData, DmvData, Data.Width, Data.Height, false, OnMotionWritten))
 		{
-			FColor* Dst = OutData.ImageData.GetData();
-			for (int32 y = 0; y < Height; y++)
+			UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Failed to write motion EXR: %s"), *MotionPath);
+			if (OnMotionWritten)
 			{
-				FMemory::Memcpy(Dst, SrcRow, Width * sizeof(FColor));
-				Dst += Width;
-				SrcRow += RowPitchInPixels;
+				OnMotionWritten(false);
 			}
 		}
 	}
 
-	Readback.Readback->Unlock();
+	return true;
 }
 
-void UCameraCaptureSubsystem::HarvestDmvReadback(FPendingReadback& Readback, FCaptureData& OutData)
+bool UCameraCaptureSubsystem::WriteMetadataFile_Static(const FString& FilePath, const FCaptureData& Data)
 {
-	int32 RowPitchInPixels = 0;
-	int32 BufferHeight = 0;
-	void* SrcData = Readback.Readback->Lock(RowPitchInPixels, &BufferHeight);
+	const FCaptureCameraInfo& Info = Data.GetCameraInfo();
 
-	if (!SrcData)
+	FString OutputString;
 	{
-		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Failed to lock DMV readback"));
-		Readback.Readback->Unlock();
-		return;
-	}
+		CAMERA_CAPTURE_SCOPE(STAT_CameraCapture_JsonWrite, "JSON Write", Info.TraceName, Data.FrameNumber);
 
-	const int32 Width = Readback.Width;
-	const int32 Height = Readback.Height;
-	const int32 NumPixels = Width * Height;
+		// Create JSON object
+		TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
 
-	OutData.DepthData.SetNumUninitialized(NumPixels);
-	OutData.MotionVectorData.SetNumUninitialized(NumPixels);
+		JsonObject->SetNumberField(TEXT("frame_number"), Data.FrameNumber);
+		JsonObject->SetNumberField(TEXT("timestamp"), Data.Timestamp);
+		JsonObject->SetStringField(TEXT("camera_id"), Info.CameraID.ToString());
 
-	// DMV render target is RGBA32f: R=Depth, G=MotionX, B=MotionY, A=1
-	const FLinearColor* SrcRow = static_cast<const FLinearColor*>(SrcData);
-	for (int32 y = 0; y < Height; y++)
-	{
-		const int32 RowStart = y * Width;
-		for (int32 x = 0; x < Width; x++)
+		if (Data.bUnchanged)
 		{
-			const FLinearColor& Pixel = SrcRow[x];
-			OutData.DepthData[RowStart + x] = Pixel.R;
-			OutData.MotionVectorData[RowStart + x] = FVector2D(Pixel.G, Pixel.B);
+			JsonObject->SetBoolField(TEXT("unchanged"), true);
+			JsonObject->SetNumberField(TEXT("reference_frame"), Data.ReferenceFrameNumber);
 		}
-		SrcRow += RowPitchInPixels;
+
+		// Transforms
+		JsonObject->SetObjectField(TEXT("world_transform"),
+			CameraCaptureUtils::TransformToJsonObject(Data.WorldTransform));
+		JsonObject->SetObjectField(TEXT("relative_transform"),
+			CameraCaptureUtils::TransformToJsonObject(Data.RelativeTransform));
+
+		// Intrinsics
+		TSharedPtr<FJsonObject> IntrinsicsJson = MakeShared<FJsonObject>();
+		IntrinsicsJson->SetNumberField(TEXT("focal_length_x"), Info.Intrinsics.FocalLengthX);
+		IntrinsicsJson->SetNumberField(TEXT("focal_length_y"), Info.Intrinsics.FocalLengthY);
+		IntrinsicsJson->SetNumberField(TEXT("principal_point_x"), Info.Intrinsics.PrincipalPointX);
+		IntrinsicsJson->SetNumberField(TEXT("principal_point_y"), Info.Intrinsics.PrincipalPointY);
+		IntrinsicsJson->SetNumberField(TEXT("image_width"), Info.Intrinsics.ImageWidth);
+		IntrinsicsJson->SetNumberField(TEXT("image_height"), Info.Intrinsics.ImageHeight);
+		IntrinsicsJson->SetBoolField(TEXT("maintain_y_axis"), Info.Intrinsics.bMaintainYAxis);
+		JsonObject->SetObjectField(TEXT("intrinsics"), IntrinsicsJson);
+
+		JsonObject->SetStringField(TEXT("actor_path"), Info.ActorPath);
+		JsonObject->SetStringField(TEXT("level_name"), Info.LevelName);
+
+		// Serialize to string
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+		FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
 	}
 
-	Readback.Readback->Unlock();
+	// Write to file
+	CAMERA_CAPTURE_SCOPE(STAT_CameraCapture_FileIO, "Write JSON File", Info.TraceName, Data.FrameNumber);
+	if (FFileHelper::SaveStringToFile(OutputString, *FilePath))
+	{
+		return true;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Failed to write metadata: %s"), *FilePath);
+		return false;
+	}
 }
 
 // ============================================================================
-// Metadata + Render Target Helpers
+// Sharding (multi-process capture)
 // ============================================================================
 
-FCaptureData UCameraCaptureSubsystem::BuildCaptureMetadata(UIntrinsicSceneCaptureComponent2D* Camera)
+void UCameraCaptureSubsystem::SetShard(int32 InShardIndex, int32 InShardCount, ECaptureShardMode InShardMode)
 {
-	FCaptureData Data;
+	ShardCount = FMath::Max(1, InShardCount);
+	ShardIndex = FMath::Clamp(InShardIndex, 0, ShardCount - 1);
+	ShardMode = InShardMode;
+	bShardConfigured = true;
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Capturing shard %d of %d (by %s)"),
+		ShardIndex, ShardCount, ShardMode == ECaptureShardMode::Cameras ? TEXT("camera") : TEXT("time range"));
+}
 
-	FCameraIdentifier* CameraID = CameraIDMap.Find(Camera);
-	if (CameraID)
+bool UCameraCaptureSubsystem::IsCameraInShard(const UIntrinsicSceneCaptureComponent2D* Camera) const
+{
+	if (ShardMode != ECaptureShardMode::Cameras || ShardCount <= 1)
 	{
-		Data.CameraID = *CameraID;
+		return true;
 	}
 
-	Data.FrameNumber = FrameIdCounter;
-	Data.Timestamp = FPlatformTime::Seconds() - CaptureStartTime;
-	Data.WorldTransform = Camera->GetComponentTransform();
+	// CRC of the unique ID (not the per-process GUID or pointer) gives every process the same partition
+	const FRegisteredCamera* Entry = FindRegisteredCamera(Camera);
+	return Entry && FCrc::StrCrc32(*Entry->Identifier.UniqueID) % static_cast<uint32>(ShardCount) == static_cast<uint32>(ShardIndex);
+}
 
-	// Compute transform relative to the owning actor's root (not just the immediate parent)
-	if (AActor* Owner = Camera->GetOwner())
-	{
-		Data.RelativeTransform = Data.WorldTransform.GetRelativeTransform(Owner->GetActorTransform());
-	}
-	else
+void UCameraCaptureSubsystem::GetShardRange(int32 NumItems, int32& OutBegin, int32& OutEnd) const
+{
+	OutBegin = 0;
+	OutEnd = NumItems;
+
+	if (ShardMode != ECaptureShardMode::TimeRange || ShardCount <= 1)
 	{
-		Data.RelativeTransform = Camera->GetRelativeTransform();
+		return;
 	}
 
-	Data.Intrinsics = Camera->GetActiveIntrinsics();
-	Data.bUsedCustomProjectionMatrix = Camera->bUseCustomProjectionMatrix;
+	OutBegin = static_cast<int32>(static_cast<int64>(NumItems) * ShardIndex / ShardCount);
+	OutEnd = static_cast<int32>(static_cast<int64>(NumItems) * (ShardIndex + 1) / ShardCount);
+}
+
+bool UCameraCaptureSubsystem::WriteShardManifest()
+{
+	// The manifest lists frames on disk, so let the serializer finish first
+	WaitForQueueCapacity(1);
+
+	const FString ManifestPath = GetAbsoluteOutputDirectory() / FString::Printf(TEXT("shard_%d_of_%d.json"), ShardIndex, ShardCount);
 
-	if (Data.bUsedCustomProjectionMatrix)
+	struct FManifestFrame
+	{
+		int64					FrameNumber = 0;
+		FString					CameraID;
+		TSharedPtr<FJsonObject> Json;
+	};
+
+	// Each StopCapture (or finished replay block) of this shard writes the same file, so
+	// earlier sessions' frames are kept; a recapture of the same camera/frame replaces its entry
+	TMap<FString, FManifestFrame> FramesByKey;
+	FString						  ExistingJsonString;
+	if (FFileHelper::LoadFileToString(ExistingJsonString, *ManifestPath))
 	{
-		Data.ProjectionMatrix = Camera->CustomProjectionMatrix;
+		TSharedPtr<FJsonObject>				  ExistingJson;
+		TSharedRef<TJsonReader<>>			  Reader = TJsonReaderFactory<>::Create(ExistingJsonString);
+		const TArray<TSharedPtr<FJsonValue>>* ExistingFrames = nullptr;
+		if (FJsonSerializer::Deserialize(Reader, ExistingJson) && ExistingJson.IsValid() && ExistingJson->TryGetArrayField(TEXT("frames"), ExistingFrames))
+		{
+			for (const TSharedPtr<FJsonValue>& FrameValue : *ExistingFrames)
+			{
+				TSharedPtr<FJsonObject> FrameJson = FrameValue->AsObject();
+				if (!FrameJson.IsValid())
+				{
+					continue;
+				}
+
+				FManifestFrame Frame;
+				Frame.FrameNumber = static_cast<int64>(FrameJson->GetNumberField(TEXT("frame_number")));
+				Frame.CameraID = FrameJson->GetStringField(TEXT("camera_id"));
+				Frame.Json = FrameJson;
+				FramesByKey.Add(FString::Printf(TEXT("%lld|%s"), Frame.FrameNumber, *Frame.CameraID), MoveTemp(Frame));
+			}
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Existing shard manifest is unreadable and will be replaced: %s"), *ManifestPath);
+		}
 	}
+	const int32 PreviousFrameCount = FramesByKey.Num();
 
-	if (AActor* Owner = Camera->GetOwner())
+	for (const FShardManifestEntry& Entry : ShardManifestEntries)
 	{
-		Data.ActorPath = Owner->GetPathName();
+		const FString FrameName = FString::Printf(TEXT("frame_%07lld"), Entry.FrameNumber);
+
+		TSharedPtr<FJsonObject> FrameJson = MakeShared<FJsonObject>();
+		FrameJson->SetStringField(TEXT("camera_id"), Entry.CameraID);
+		FrameJson->SetNumberField(TEXT("frame_number"), Entry.FrameNumber);
+		FrameJson->SetNumberField(TEXT("timestamp"), Entry.Timestamp);
+		FrameJson->SetStringField(TEXT("metadata"), Entry.CameraDirectory / FrameName + TEXT(".json"));
+		if (!Entry.bUnchanged)
+		{
+			FrameJson->SetStringField(TEXT("exr"), Entry.CameraDirectory / FrameName + TEXT(".exr"));
+		}
+		FramesByKey.Add(FString::Printf(TEXT("%lld|%s"), Entry.FrameNumber, *Entry.CameraID), { Entry.FrameNumber, Entry.CameraID, FrameJson });
 	}
 
-	UWorld* World = GetWorld();
-	if (World)
+	TArray<FManifestFrame> SortedFrames;
+	FramesByKey.GenerateValueArray(SortedFrames);
+	SortedFrames.Sort([](const FManifestFrame& A, const FManifestFrame& B) {
+		return A.FrameNumber != B.FrameNumber ? A.FrameNumber < B.FrameNumber : A.CameraID < B.CameraID;
+	});
+
+	TArray<TSharedPtr<FJsonValue>> Frames;
+	Frames.Reserve(SortedFrames.Num());
+	for (const FManifestFrame& Frame : SortedFrames)
 	{
-		Data.LevelName = World->GetMapName();
+		Frames.Add(MakeShared<FJsonValueObject>(Frame.Json));
 	}
 
-	Data.Width = Data.Intrinsics.ImageWidth;
-	Data.Height = Data.Intrinsics.ImageHeight;
+	TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetNumberField(TEXT("shard_index"), ShardIndex);
+	JsonObject->SetNumberField(TEXT("shard_count"), ShardCount);
+	JsonObject->SetStringField(TEXT("shard_mode"), ShardMode == ECaptureShardMode::Cameras ? TEXT("cameras") : TEXT("time_range"));
+	JsonObject->SetStringField(TEXT("level_name"), GetWorld() ? GetWorld()->GetMapName() : FString());
+	JsonObject->SetArrayField(TEXT("frames"), Frames);
 
-	return Data;
-}
+	FString					  OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
 
-void UCameraCaptureSubsystem::EnsureCameraRenderTarget(UIntrinsicSceneCaptureComponent2D* Camera)
-{
-	if (Camera->TextureTarget)
+	if (!FFileHelper::SaveStringToFile(OutputString, *ManifestPath))
 	{
-		return;
+		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Failed to write shard manifest: %s"), *ManifestPath);
+		return false;
 	}
 
-	FCameraIntrinsics Intrinsics = Camera->GetActiveIntrinsics();
-	int32			  Width = Intrinsics.ImageWidth;
-	int32			  Height = Intrinsics.ImageHeight;
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Wrote shard manifest with %d frames (%d from this session, %d already listed): %s"),
+		SortedFrames.Num(), ShardManifestEntries.Num(), PreviousFrameCount, *ManifestPath);
+	ShardManifestEntries.Reset();
+	return true;
+}
 
-	UTextureRenderTarget2D* NewRenderTarget = NewObject<UTextureRenderTarget2D>(Camera);
-	NewRenderTarget->RenderTargetFormat = RTF_RGBA8; // RGB only needs 8-bit
-	NewRenderTarget->InitAutoFormat(Width, Height);
-	NewRenderTarget->UpdateResourceImmediate(true);
+bool UCameraCaptureSubsystem::MergeShardManifests(const FString& Directory)
+{
+	const FString AbsoluteDirectory = FPaths::IsRelative(Directory) ? FPaths::Combine(*FPaths::ProjectDir(), *Directory) : Directory;
 
-	Camera->TextureTarget = NewRenderTarget;
+	TArray<FString> ManifestFiles;
+	IFileManager::Get().FindFiles(ManifestFiles, *(AbsoluteDirectory / TEXT("shard_*_of_*.json")), true, false);
+	if (ManifestFiles.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] No shard manifests found in %s"), *AbsoluteDirectory);
+		return false;
+	}
 
-	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Created RGBA8 render target (%dx%d) for camera %s"),
-		Width, Height, *Camera->GetName());
-}
+	struct FMergedFrame
+	{
+		int64					FrameNumber = 0;
+		FString					CameraID;
+		TSharedPtr<FJsonObject> Json;
+	};
+
+	TArray<FMergedFrame> MergedFrames;
+	TSet<FString>		 SeenFrames;
+	TSet<FString>		 Cameras;
+	TSet<int32>			 SeenShards;
+	int32				 ExpectedShardCount = INDEX_NONE;
+	FString				 LevelName;
+
+	for (const FString& ManifestFile : ManifestFiles)
+	{
+		FString JsonString;
+		if (!FFileHelper::LoadFileToString(JsonString, *(AbsoluteDirectory / ManifestFile)))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Failed to read shard manifest: %s"), *ManifestFile);
+			return false;
+		}
 
-// ============================================================================
-// Serialization (dispatched to background thread)
-// ============================================================================
+		TSharedPtr<FJsonObject>	  ManifestJson;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+		if (!FJsonSerializer::Deserialize(Reader, ManifestJson) || !ManifestJson.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Invalid shard manifest: %s"), *ManifestFile);
+			return false;
+		}
 
-void UCameraCaptureSubsystem::SerializeCaptureData(TSharedRef<const FCaptureData> Data)
-{
-	FString OutputDir = OutputDirectory;
-	bool	bRGB = bCaptureRGB;
-	bool	bDepth = bCaptureDepth;
-	bool	bMotion = bCaptureMotionVectors;
+		const int32 ManifestShardCount = static_cast<int32>(ManifestJson->GetNumberField(TEXT("shard_count")));
+		if (ExpectedShardCount != INDEX_NONE && ManifestShardCount != ExpectedShardCount)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] %s has shard count %d, expected %d (manifests from different sessions?)"),
+				*ManifestFile, ManifestShardCount, ExpectedShardCount);
+			return false;
+		}
+		ExpectedShardCount = ManifestShardCount;
+		SeenShards.Add(static_cast<int32>(ManifestJson->GetNumberField(TEXT("shard_index"))));
+		ManifestJson->TryGetStringField(TEXT("level_name"), LevelName);
 
-	// Lambda captures the shared ref — keeps data alive until async write completes
-	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
-		[Data, OutputDir, bRGB, bDepth, bMotion]() {
-			FString AbsoluteOutputDir = OutputDir;
-			if (FPaths::IsRelative(AbsoluteOutputDir))
+		const TArray<TSharedPtr<FJsonValue>>* Frames = nullptr;
+		if (!ManifestJson->TryGetArrayField(TEXT("frames"), Frames))
+		{
+			continue;
+		}
+
+		for (const TSharedPtr<FJsonValue>& FrameValue : *Frames)
+		{
+			TSharedPtr<FJsonObject> FrameJson = FrameValue->AsObject();
+			if (!FrameJson.IsValid())
 			{
-				AbsoluteOutputDir = FPaths::Combine(*FPaths::ProjectDir(), *OutputDir);
+				continue;
 			}
 
-			FString CameraPath = Data->CameraID.GetFullPath(AbsoluteOutputDir);
+			FMergedFrame Frame;
+			Frame.FrameNumber = static_cast<int64>(FrameJson->GetNumberField(TEXT("frame_number")));
+			Frame.CameraID = FrameJson->GetStringField(TEXT("camera_id"));
+			Frame.Json = FrameJson;
 
-			if (!IFileManager::Get().DirectoryExists(*CameraPath))
+			// A camera/frame pair written by two shards means the partitions overlapped
+			bool bAlreadySeen = false;
+			SeenFrames.Add(FString::Printf(TEXT("%lld|%s"), Frame.FrameNumber, *Frame.CameraID), &bAlreadySeen);
+			if (bAlreadySeen)
 			{
-				IFileManager::Get().MakeDirectory(*CameraPath, true);
+				UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Duplicate frame %lld for %s in %s, keeping the first"),
+					Frame.FrameNumber, *Frame.CameraID, *ManifestFile);
+				continue;
 			}
 
-			FString FrameNumberStr = FString::Printf(TEXT("%07lld"), Data->FrameNumber);
-
-			// Write EXR
-			FString ExrPath = FPaths::Combine(CameraPath, FString::Printf(TEXT("frame_%s.exr"), *FrameNumberStr));
-			WriteEXRFile_Static(ExrPath, *Data, bRGB, bDepth, bMotion);
-
-			// Write metadata JSON
-			FString MetadataPath = FPaths::Combine(CameraPath, FString::Printf(TEXT("frame_%s.json"), *FrameNumberStr));
-			WriteMetadataFile_Static(MetadataPath, *Data);
-		});
-}
+			Cameras.Add(Frame.CameraID);
+			MergedFrames.Add(MoveTemp(Frame));
+		}
+	}
 
-bool UCameraCaptureSubsystem::WriteEXRFile_Static(const FString& FilePath, const FCaptureData& Data, bool bCaptureRGB, bool bCaptureDepth, bool bCaptureMotionVectors)
-{
-	// Safety checks
-	if (Data.Width <= 0 || Data.Height <= 0)
+	TArray<int32> MissingShards;
+	for (int32 Index = 0; Index < ExpectedShardCount; ++Index)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Invalid image dimensions: %dx%d"), Data.Width, Data.Height);
+		if (!SeenShards.Contains(Index))
+		{
+			MissingShards.Add(Index);
+		}
+	}
+	if (MissingShards.Num() > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Cannot merge: %d of %d shard manifests missing (first missing: %d)"),
+			MissingShards.Num(), ExpectedShardCount, MissingShards[0]);
 		return false;
 	}
 
-	int32 NumPixels = Data.Width * Data.Height;
+	// Shard layout does not appear in the index, so any sharding yields the same file
+	MergedFrames.Sort([](const FMergedFrame& A, const FMergedFrame& B) {
+		return A.FrameNumber != B.FrameNumber ? A.FrameNumber < B.FrameNumber : A.CameraID < B.CameraID;
+	});
 
-	if (Data.ImageData.Num() == 0 && Data.DepthData.Num() == 0 && Data.MotionVectorData.Num() == 0)
+	TArray<FString> SortedCameras = Cameras.Array();
+	SortedCameras.Sort();
+
+	TArray<TSharedPtr<FJsonValue>> CameraValues;
+	for (const FString& CameraID : SortedCameras)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] No image data to write"));
-		return false;
+		CameraValues.Add(MakeShared<FJsonValueString>(CameraID));
 	}
 
-	// Convert FCaptureData format to TArray<FLinearColor> format expected by utility functions
-	TArray<FLinearColor> RgbData;
-	TArray<FLinearColor> DmvData;
-	RgbData.SetNum(NumPixels);
-	DmvData.SetNum(NumPixels);
-
-	// Convert RGB from FColor to FLinearColor
-	if (bCaptureRGB && Data.ImageData.Num() == NumPixels)
+	TArray<TSharedPtr<FJsonValue>> FrameValues;
+	FrameValues.Reserve(MergedFrames.Num());
+	for (const FMergedFrame& Frame : MergedFrames)
 	{
-		for (int32 i = 0; i < NumPixels; i++)
-		{
-			RgbData[i] = FLinearColor(Data.ImageData[i]);
-		}
+		FrameValues.Add(MakeShared<FJsonValueObject>(Frame.Json));
 	}
-	else
+
+	TSharedPtr<FJsonObject> IndexJson = MakeShared<FJsonObject>();
+	IndexJson->SetStringField(TEXT("level_name"), LevelName);
+	IndexJson->SetNumberField(TEXT("frame_count"), MergedFrames.Num());
+	IndexJson->SetArrayField(TEXT("cameras"), CameraValues);
+	IndexJson->SetArrayField(TEXT("frames"), FrameValues);
+
+	FString					  OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(IndexJson.ToSharedRef(), Writer);
+
+	const FString IndexPath = AbsoluteDirectory / TEXT("session_index.json");
+	if (!FFileHelper::SaveStringToFile(OutputString, *IndexPath))
 	{
-		for (int32 i = 0; i < NumPixels; i++)
-		{
-			RgbData[i] = FLinearColor::Black;
-		}
+		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Failed to write session index: %s"), *IndexPath);
+		return false;
 	}
 
-	// Prepare DMV data: Depth in R, Motion X in G, Motion Y in B
-	for (int32 i = 0; i < NumPixels; i++)
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Merged %d shard manifests (%d frames, %d cameras) into %s"),
+		ManifestFiles.Num(), MergedFrames.Num(), SortedCameras.Num(), *IndexPath);
+	return true;
+}
+
+bool UCameraCaptureSubsystem::CompareSessionOutputs(const FString& DirectoryA, const FString& DirectoryB)
+{
+	auto Absolute = [](const FString& Directory) {
+		return FPaths::IsRelative(Directory) ? FPaths::Combine(*FPaths::ProjectDir(), *Directory) : Directory;
+	};
+	const FString AbsoluteA = Absolute(DirectoryA);
+	const FString AbsoluteB = Absolute(DirectoryB);
+
+	FString IndexA;
+	FString IndexB;
+	if (!FFileHelper::LoadFileToString(IndexA, *(AbsoluteA / TEXT("session_index.json")))
+		|| !FFileHelper::LoadFileToString(IndexB, *(AbsoluteB / TEXT("session_index.json"))))
 	{
-		float Depth = (bCaptureDepth && Data.DepthData.Num() == NumPixels) ? Data.DepthData[i] : 0.0f;
-		float MotionX = (bCaptureMotionVectors && Data.MotionVectorData.Num() == NumPixels) ? Data.MotionVectorData[i].X : 0.0f;
-		float MotionY = (bCaptureMotionVectors && Data.MotionVectorData.Num() == NumPixels) ? Data.MotionVectorData[i].Y : 0.0f;
+		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Compare: session_index.json missing in %s or %s (merge first)"), *AbsoluteA, *AbsoluteB);
+		return false;
+	}
 
-		DmvData[i] = FLinearColor(Depth, MotionX, MotionY, 0.0f);
+	if (IndexA != IndexB)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Compare: session indices differ between %s and %s"), *AbsoluteA, *AbsoluteB);
+		return false;
 	}
 
-	// Use shared utility to write RGB+Depth EXR
-	if (!CameraCaptureUtils::WriteEXRFile(FilePath, RgbData, DmvData, Data.Width, Data.Height, true))
+	TSharedPtr<FJsonObject>				  IndexJson;
+	TSharedRef<TJsonReader<>>			  Reader = TJsonReaderFactory<>::Create(IndexA);
+	const TArray<TSharedPtr<FJsonValue>>* Frames = nullptr;
+	if (!FJsonSerializer::Deserialize(Reader, IndexJson) || !IndexJson.IsValid() || !IndexJson->TryGetArrayField(TEXT("frames"), Frames))
 	{
-		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Failed to write RGB+Depth EXR: %s"), *FilePath);
+		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Compare: invalid session index in %s"), *AbsoluteA);
 		return false;
 	}
 
-	// Write motion vectors to separate file if we have them
-	if (bCaptureMotionVectors && Data.MotionVectorData.Num() == NumPixels)
+	// Every file the index lists must exist on both sides with identical bytes
+	int32 FilesCompared = 0;
+	int32 Mismatches = 0;
+	for (const TSharedPtr<FJsonValue>& FrameValue : *Frames)
 	{
-		FString MotionPath = FilePath.Replace(TEXT(".exr"), TEXT("_motion.exr"));
-		if (!CameraCaptureUtils::WriteEXRFile(MotionPath, RgbData, DmvData, Data.Width, Data.Height, false))
+		const TSharedPtr<FJsonObject> FrameJson = FrameValue->AsObject();
+		if (!FrameJson.IsValid())
 		{
-			UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Failed to write motion EXR: %s"), *MotionPath);
+			continue;
+		}
+
+		for (const TCHAR* Field : { TEXT("metadata"), TEXT("exr") })
+		{
+			FString RelativePath;
+			if (!FrameJson->TryGetStringField(Field, RelativePath))
+			{
+				continue;
+			}
+
+			TArray<uint8> BytesA;
+			TArray<uint8> BytesB;
+			const bool	  bLoadedA = FFileHelper::LoadFileToArray(BytesA, *(AbsoluteA / RelativePath), FILEREAD_Silent);
+			const bool	  bLoadedB = FFileHelper::LoadFileToArray(BytesB, *(AbsoluteB / RelativePath), FILEREAD_Silent);
+			FilesCompared++;
+			if (!bLoadedA || !bLoadedB || BytesA != BytesB)
+			{
+				if (Mismatches++ < MaxCompareMismatchesLogged)
+				{
+					UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Compare: %s %s"), *RelativePath,
+						!bLoadedA || !bLoadedB ? TEXT("is missing on one side") : TEXT("differs"));
+				}
+			}
 		}
 	}
 
+	if (Mismatches > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Compare: %d of %d files differ between %s and %s"),
+			Mismatches, FilesCompared, *AbsoluteA, *AbsoluteB);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[CameraCaptureSubsystem] Compare: %d frames (%d files) identical in %s and %s"),
+		Frames->Num(), FilesCompared, *AbsoluteA, *AbsoluteB);
 	return true;
 }
 
-bool UCameraCaptureSubsystem::WriteMetadataFile_Static(const FString& FilePath, const FCaptureData& Data)
-{
-	// Create JSON object
-	TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+// ============================================================================
+// Debug HUD and Console Commands
+// ============================================================================
 
-	JsonObject->SetNumberField(TEXT("frame_number"), Data.FrameNumber);
-	JsonObject->SetNumberField(TEXT("timestamp"), Data.Timestamp);
-	JsonObject->SetStringField(TEXT("camera_id"), Data.CameraID.ToString());
-
-	// Transforms
-	JsonObject->SetObjectField(TEXT("world_transform"),
-		CameraCaptureUtils::TransformToJsonObject(Data.WorldTransform));
-	JsonObject->SetObjectField(TEXT("relative_transform"),
-		CameraCaptureUtils::TransformToJsonObject(Data.RelativeTransform));
-
-	// Intrinsics
-	TSharedPtr<FJsonObject> IntrinsicsJson = MakeShared<FJsonObject>();
-	IntrinsicsJson->SetNumberField(TEXT("focal_length_x"), Data.Intrinsics.FocalLengthX);
-	IntrinsicsJson->SetNumberField(TEXT("focal_length_y"), Data.Intrinsics.FocalLengthY);
-	IntrinsicsJson->SetNumberField(TEXT("principal_point_x"), Data.Intrinsics.PrincipalPointX);
-	IntrinsicsJson->SetNumberField(TEXT("principal_point_y"), Data.Intrinsics.PrincipalPointY);
-	IntrinsicsJson->SetNumberField(TEXT("image_width"), Data.Intrinsics.ImageWidth);
-	IntrinsicsJson->SetNumberField(TEXT("image_height"), Data.Intrinsics.ImageHeight);
-	IntrinsicsJson->SetBoolField(TEXT("maintain_y_axis"), Data.Intrinsics.bMaintainYAxis);
-	JsonObject->SetObjectField(TEXT("intrinsics"), IntrinsicsJson);
-
-	JsonObject->SetStringField(TEXT("actor_path"), Data.ActorPath);
-	JsonObject->SetStringField(TEXT("level_name"), Data.LevelName);
-
-	// Serialize to string
-	FString					  OutputString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+void UCameraCaptureSubsystem::SetDebugHudVisible(bool bVisible)
+{
+	if (bVisible == DebugHudHandle.IsValid())
+	{
+		return;
+	}
 
-	// Write to file
-	if (FFileHelper::SaveStringToFile(OutputString, *FilePath))
+	if (bVisible)
 	{
-		return true;
+		DebugHudRefreshTime = 0.0;
+		DebugHudHandle = UDebugDrawService::Register(TEXT("Game"), FDebugDrawDelegate::CreateUObject(this, &UCameraCaptureSubsystem::DrawDebugHud));
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("[CameraCaptureSubsystem] Failed to write metadata: %s"), *FilePath);
-		return false;
+		UDebugDrawService::Unregister(DebugHudHandle);
+		DebugHudHandle.Reset();
+	}
+}
+
+void UCameraCaptureSubsystem::DrawDebugHud(UCanvas* Canvas, APlayerController* PlayerController)
+{
+	// Draw services are global; only draw over viewports of our own world
+	if (!Canvas || !GEngine || (Canvas->SceneView && Canvas->SceneView->Family && Canvas->SceneView->Family->Scene
+		&& Canvas->SceneView->Family->Scene->GetWorld() != GetWorld()))
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now - DebugHudRefreshTime >= DebugHudRefreshSeconds)
+	{
+		DebugHudStatistics = GetStatistics();
+		DebugHudRefreshTime = Now;
+	}
+	const FCaptureStatistics& Stats = DebugHudStatistics;
+
+	UFont*		Font = GEngine->GetSmallFont();
+	const float LineHeight = Font->GetMaxCharHeight() + 2.0f;
+	const float X = 20.0f;
+	float		Y = 60.0f;
+
+	auto DrawLine = [&](const FString& Text, const FColor& Color) {
+		Canvas->SetDrawColor(Color);
+		Canvas->DrawText(Font, Text, X, Y);
+		Y += LineHeight;
+	};
+
+	// Red once the writer backlog exceeds about two frames per camera
+	const bool bWriterBehind = Stats.SerializationBacklog > FMath::Max(4, Stats.RegisteredCameraCount * 2);
+
+	DrawLine(FString::Printf(TEXT("CameraCapture  %d cameras  %.1f Hz  %.2f ms CPU/kick  %.1f GPU ms/s"),
+				 Stats.RegisteredCameraCount, Stats.AchievedCaptureRateHz, Stats.AverageCaptureTimeMs, Stats.GpuCaptureMsPerSecond),
+		FColor::White);
+	DrawLine(FString::Printf(TEXT("Readbacks in flight %d   Writer backlog %d (max %d)   %.1f fps  %.1f MB/s"),
+				 Stats.PendingReadbackCount, Stats.SerializationBacklog, Stats.MaxSerializationBacklog, Stats.WriteFramesPerSecond, Stats.WriteMegabytesPerSecond),
+		bWriterBehind ? FColor::Red : FColor::White);
+	DrawLine(FString::Printf(TEXT("Dropped %lld   Throttled %lld   Write failures %lld"),
+				 Stats.TotalFramesDropped, Stats.TotalFramesThrottled, Stats.TotalFramesWriteFailed),
+		(Stats.TotalFramesDropped > 0 || Stats.TotalFramesWriteFailed > 0) ? FColor::Yellow : FColor::White);
+
+	for (const FCameraCaptureStatistics& Camera : Stats.PerCamera)
+	{
+		const bool bBehind = Camera.TargetRateHz > 0.0f && Camera.AchievedRateHz < Camera.TargetRateHz * 0.9f;
+		DrawLine(FString::Printf(TEXT("  %s  %.1f/%.1f Hz  in flight %d  dropped %lld  GPU %.2f ms  readback p95 %.1f ms"),
+					 *Camera.CameraID, Camera.AchievedRateHz, Camera.TargetRateHz, Camera.QueueDepth, Camera.FramesDropped,
+					 Camera.AverageGpuTimeMs, Camera.KickToReady.P95Ms),
+			bBehind ? FColor::Yellow : FColor(200, 200, 200));
 	}
 }
 
+namespace CameraCaptureConsole
+{
+	static UCameraCaptureSubsystem* FindSubsystem(UWorld* World, FOutputDevice& Ar)
+	{
+		UCameraCaptureSubsystem* Subsystem = World ? World->GetSubsystem<UCameraCaptureSubsystem>() : nullptr;
+		if (!Subsystem)
+		{
+			Ar.Log(TEXT("CameraCapture: no capture subsystem in this world"));
+		}
+		return Subsystem;
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice StatsCommand(
+		TEXT("CameraCapture.Stats"),
+		TEXT("Print capture statistics with one line per camera"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar) {
+			if (UCameraCaptureSubsystem* Subsystem = FindSubsystem(World, Ar))
+			{
+				UCameraCaptureSubsystem::PrintStatistics(Subsystem->GetStatistics(), Ar, false);
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpCommand(
+		TEXT("CameraCapture.Dump"),
+		TEXT("Print every capture statistic of every camera"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar) {
+			if (UCameraCaptureSubsystem* Subsystem = FindSubsystem(World, Ar))
+			{
+				UCameraCaptureSubsystem::PrintStatistics(Subsystem->GetStatistics(), Ar, true);
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice SetRateCommand(
+		TEXT("CameraCapture.SetRate"),
+		TEXT("CameraCapture.SetRate <CameraID> <Hz>: change a camera's capture rate (0 = every-N scheduling)"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar) {
+			UCameraCaptureSubsystem* Subsystem = FindSubsystem(World, Ar);
+			if (!Subsystem)
+			{
+				return;
+			}
+
+			if (Args.Num() < 2 || !Args[1].IsNumeric())
+			{
+				Ar.Log(TEXT("Usage: CameraCapture.SetRate <CameraID> <Hz>"));
+				return;
+			}
+
+			UIntrinsicSceneCaptureComponent2D* Camera = Subsystem->FindCameraByID(Args[0]);
+			if (!Camera)
+			{
+				Ar.Logf(TEXT("CameraCapture: no camera with ID '%s' (see CameraCapture.Stats)"), *Args[0]);
+				return;
+			}
+
+			Subsystem->SetCameraCaptureRate(Camera, FCString::Atof(*Args[1]));
+		}));
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice HudCommand(
+		TEXT("CameraCapture.HUD"),
+		TEXT("CameraCapture.HUD [0|1]: toggle the on-screen capture performance overlay"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar) {
+			if (UCameraCaptureSubsystem* Subsystem = FindSubsystem(World, Ar))
+			{
+				Subsystem->SetDebugHudVisible(Args.Num() > 0 ? FCString::Atoi(*Args[0]) != 0 : !Subsystem->IsDebugHudVisible());
+			}
+		}));
+} // namespace CameraCaptureConsole
+
 // ============================================================================
 // Helper Functions
 // ============================================================================
 
-FCameraIdentifier UCameraCaptureSubsystem::GenerateCameraID(UIntrinsicSceneCaptureComponent2D* Camera)
+FCameraIdentifier UCameraCaptureSubsystem::GenerateCameraID(UIntrinsicSceneCaptureComponent2D* Camera, FString& OutDisambiguatedFrom)
 {
 	FCameraIdentifier ID = FCameraIdentifier::Generate(Camera);
 
@@ -1016,21 +4876,14 @@ FCameraIdentifier UCameraCaptureSubsystem::GenerateCameraID(UIntrinsicSceneCaptu
 	// an actual component name collision on the same actor
 	FString ProposedUniqueID = FString::Printf(TEXT("%s::%s"), *ID.ActorName, *ID.ComponentName);
 
-	// Check if this unique ID already exists
-	bool bNeedsDisambiguation = false;
-	for (const auto& Pair : CameraIDMap)
-	{
-		if (Pair.Value.UniqueID == ProposedUniqueID && Pair.Key.Get() != Camera)
-		{
-			// Same unique ID exists for a different camera - this is a true collision
-			bNeedsDisambiguation = true;
-			break;
-		}
-	}
+	// Same unique ID registered for a different camera - this is a true collision
+	const int32* ExistingIndex = UniqueIDIndices.Find(ProposedUniqueID);
+	const bool	 bNeedsDisambiguation = ExistingIndex && CameraRegistry[*ExistingIndex].Camera.Get() != Camera;
 
 	if (bNeedsDisambiguation)
 	{
 		// Disambiguate the actor name
+		OutDisambiguatedFrom = ID.ActorName;
 		ID.ActorName = DisambiguateActorName(ID.ActorName);
 		ID.UniqueID = FString::Printf(TEXT("%s::%s"), *ID.ActorName, *ID.ComponentName);
 	}
@@ -1045,32 +4898,19 @@ FCameraIdentifier UCameraCaptureSubsystem::GenerateCameraID(UIntrinsicSceneCaptu
 
 FString UCameraCaptureSubsystem::DisambiguateActorName(const FString& ActorName)
 {
-	// Find a unique suffix
-	int32	Suffix = 1;
+	// Resume from the last suffix handed out for this name, so repeated collisions
+	// (e.g. thousands of spawned copies of one actor) don't rescan from _1 each time.
+	// The entry is dropped in RemoveRegisteredCamera once no suffixed name is in use.
+	FActorNameSuffixes& Suffixes = ActorNameSuffixes.FindOrAdd(ActorName);
+	Suffixes.NumInUse++;
 	FString DisambiguatedName;
 
 	do
 	{
-		DisambiguatedName = FString::Printf(TEXT("%s_%d"), *ActorName, Suffix);
-		Suffix++;
-
-		// Check if this disambiguated name is already in use
-		bool bInUse = false;
-		for (const auto& Pair : CameraIDMap)
-		{
-			if (Pair.Value.ActorName == DisambiguatedName)
-			{
-				bInUse = true;
-				break;
-			}
-		}
-
-		if (!bInUse)
-		{
-			break;
-		}
+		DisambiguatedName = FString::Printf(TEXT("%s_%d"), *ActorName, Suffixes.NextSuffix);
+		Suffixes.NextSuffix++;
 	}
-	while (Suffix < 100); // Safety limit
+	while (ActorNameRefCounts.Contains(DisambiguatedName));
 
 	UE_LOG(LogTemp, Warning, TEXT("[CameraCaptureSubsystem] Actor/component name collision detected, using: %s"), *DisambiguatedName);
 
@@ -0,0 +1,144 @@
+#include "CaptureBufferPool.h"
+#include "CameraCaptureSubsystem.h"
+#include "Misc/ScopeLock.h"
+
+// ============================================================================
+// FCaptureBufferPool Implementation
+// ============================================================================
+
+template <typename ElementType>
+void FCaptureBufferPool::AcquireImpl(TFreeList<ElementType>& FreeList, TArray<ElementType>& Out, int32 Num)
+{
+	const int64 ClassBytes = Align(FMath::Max<int64>(static_cast<int64>(Num) * sizeof(ElementType), 1), SizeClassBytes);
+
+	TArray<ElementType> Plane;
+	{
+		FScopeLock Lock(&Mutex);
+
+		TArray<TArray<ElementType>>* Idle = FreeList.Find(ClassBytes);
+		if (Idle && Idle->Num() > 0)
+		{
+			Plane = Idle->Pop(false);
+			Stats.PooledBytes -= GetPlaneBytes(Plane);
+			Stats.Hits++;
+		}
+		else
+		{
+			Stats.Misses++;
+		}
+	}
+
+	// Allocate outside the lock; reserving the whole class keeps the plane in it on release
+	if (Plane.Max() == 0)
+	{
+		Plane.Reserve(static_cast<int32>(ClassBytes / sizeof(ElementType)));
+	}
+	Plane.SetNumUninitialized(Num, false);
+
+	{
+		FScopeLock Lock(&Mutex);
+		Stats.OutstandingBytes += GetPlaneBytes(Plane);
+		Stats.PeakOutstandingBytes = FMath::Max(Stats.PeakOutstandingBytes, Stats.OutstandingBytes);
+	}
+
+	Out = MoveTemp(Plane);
+}
+
+template <typename ElementType>
+void FCaptureBufferPool::ReleaseImpl(TFreeList<ElementType>& FreeList, TArray<ElementType>& Plane)
+{
+	const int64 PlaneBytes = GetPlaneBytes(Plane);
+	if (PlaneBytes == 0)
+	{
+		return;
+	}
+
+	// A plane is filed under the largest class it can serve
+	const int64 ClassBytes = AlignDown(PlaneBytes, SizeClassBytes);
+
+	FScopeLock Lock(&Mutex);
+
+	Stats.OutstandingBytes = FMath::Max<int64>(Stats.OutstandingBytes - PlaneBytes, 0);
+
+	if (ClassBytes == 0 || Stats.PooledBytes + PlaneBytes > MaxPooledBytes)
+	{
+		Stats.Discards++;
+		return; // Freed by the caller's array going out of scope
+	}
+
+	Plane.Reset();
+	FreeList.FindOrAdd(ClassBytes).Add(MoveTemp(Plane));
+	Stats.PooledBytes += PlaneBytes;
+	Stats.PeakPooledBytes = FMath::Max(Stats.PeakPooledBytes, Stats.PooledBytes);
+}
+
+void FCaptureBufferPool::Acquire(TArray<FColor>& Out, int32 Num)
+{
+	AcquireImpl(FreeImagePlanes, Out, Num);
+}
+
+void FCaptureBufferPool::Acquire(TArray<float>& Out, int32 Num)
+{
+	AcquireImpl(FreeDepthPlanes, Out, Num);
+}
+
+void FCaptureBufferPool::Acquire(TArray<FVector2D>& Out, int32 Num)
+{
+	AcquireImpl(FreeMotionPlanes, Out, Num);
+}
+
+void FCaptureBufferPool::Release(FCaptureData& Data)
+{
+	Release(Data.ImageData, Data.DepthData, Data.MotionVectorData);
+}
+
+void FCaptureBufferPool::Release(TArray<FColor>& ImageData, TArray<float>& DepthData, TArray<FVector2D>& MotionVectorData)
+{
+	ReleaseImpl(FreeImagePlanes, ImageData);
+	ReleaseImpl(FreeDepthPlanes, DepthData);
+	ReleaseImpl(FreeMotionPlanes, MotionVectorData);
+}
+
+void FCaptureBufferPool::SetMaxPooledBytes(int64 InMaxPooledBytes)
+{
+	FScopeLock Lock(&Mutex);
+	MaxPooledBytes = FMath::Max<int64>(InMaxPooledBytes, 0);
+	TrimToBudget();
+}
+
+void FCaptureBufferPool::Empty()
+{
+	FScopeLock Lock(&Mutex);
+	FreeImagePlanes.Empty();
+	FreeDepthPlanes.Empty();
+	FreeMotionPlanes.Empty();
+	Stats.PooledBytes = 0;
+}
+
+FCaptureBufferPool::FStats FCaptureBufferPool::GetStats() const
+{
+	FScopeLock Lock(&Mutex);
+	return Stats;
+}
+
+void FCaptureBufferPool::TrimToBudget()
+{
+	auto TrimFreeList = [this](auto& FreeList) {
+		for (auto It = FreeList.CreateIterator(); It && Stats.PooledBytes > MaxPooledBytes; ++It)
+		{
+			while (It->Value.Num() > 0 && Stats.PooledBytes > MaxPooledBytes)
+			{
+				Stats.PooledBytes -= GetPlaneBytes(It->Value.Last());
+				It->Value.Pop(false);
+			}
+			if (It->Value.Num() == 0)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	};
+
+	TrimFreeList(FreeImagePlanes);
+	TrimFreeList(FreeDepthPlanes);
+	TrimFreeList(FreeMotionPlanes);
+}
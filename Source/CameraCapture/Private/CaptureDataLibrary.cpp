@@ -0,0 +1,26 @@
+#include "CaptureDataLibrary.h"
+
+FCameraIdentifier UCaptureDataLibrary::GetCameraID(const FCaptureData& Data)
+{
+	return Data.GetCameraInfo().CameraID;
+}
+
+FCameraIntrinsics UCaptureDataLibrary::GetIntrinsics(const FCaptureData& Data)
+{
+	return Data.GetCameraInfo().Intrinsics;
+}
+
+bool UCaptureDataLibrary::UsedCustomProjectionMatrix(const FCaptureData& Data)
+{
+	return Data.GetCameraInfo().bUsedCustomProjectionMatrix;
+}
+
+FString UCaptureDataLibrary::GetActorPath(const FCaptureData& Data)
+{
+	return Data.GetCameraInfo().ActorPath;
+}
+
+FString UCaptureDataLibrary::GetLevelName(const FCaptureData& Data)
+{
+	return Data.GetCameraInfo().LevelName;
+}
@@ -0,0 +1,138 @@
+#include "CaptureLatencyHistogram.h"
+
+// ============================================================================
+// FCaptureLatencyHistogram Implementation
+// ============================================================================
+
+int32 FCaptureLatencyHistogram::GetBucketIndex(uint64 ValueUs)
+{
+	if (ValueUs < LinearBuckets)
+	{
+		return static_cast<int32>(ValueUs);
+	}
+
+	// Keep the top 5 bits: Magnitude k covers [16 << k, 32 << k) in 16 buckets of width 1 << k
+	const int32 Magnitude = static_cast<int32>(FPlatformMath::FloorLog2_64(ValueUs)) - 4;
+	const int32 SubBucket = static_cast<int32>(ValueUs >> Magnitude) - SubBuckets;
+	return LinearBuckets + (Magnitude - 1) * SubBuckets + SubBucket;
+}
+
+uint64 FCaptureLatencyHistogram::GetBucketUpperBoundUs(int32 Index)
+{
+	if (Index < LinearBuckets)
+	{
+		return static_cast<uint64>(Index);
+	}
+
+	const int32	 Magnitude = (Index - LinearBuckets) / SubBuckets + 1;
+	const uint64 SubBucket = static_cast<uint64>((Index - LinearBuckets) % SubBuckets + SubBuckets);
+	return ((SubBucket + 1) << Magnitude) - 1;
+}
+
+void FCaptureLatencyHistogram::Record(double ValueMs)
+{
+	const uint64 ValueUs = FMath::Min(static_cast<uint64>(FMath::Max(ValueMs, 0.0) * 1000.0), MaxValueUs);
+
+	Buckets[GetBucketIndex(ValueUs)].fetch_add(1, std::memory_order_relaxed);
+	Count.fetch_add(1, std::memory_order_relaxed);
+	SumUs.fetch_add(ValueUs, std::memory_order_relaxed);
+
+	uint64 Max = MaxUs.load(std::memory_order_relaxed);
+	while (ValueUs > Max && !MaxUs.compare_exchange_weak(Max, ValueUs, std::memory_order_relaxed))
+	{
+	}
+}
+
+double FCaptureLatencyHistogram::GetPercentileMs(double Percentile) const
+{
+	const uint64 Total = Count.load(std::memory_order_relaxed);
+	if (Total == 0)
+	{
+		return 0.0;
+	}
+
+	// Rank of the sample that the percentile lands on (1-based)
+	const uint64 Rank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 100.0) / 100.0 * Total)));
+
+	uint64 Seen = 0;
+	for (int32 Index = 0; Index < NumBuckets; ++Index)
+	{
+		Seen += Buckets[Index].load(std::memory_order_relaxed);
+		if (Seen >= Rank)
+		{
+			// The bucket bound can exceed the largest sample; the max is exact
+			return FMath::Min(GetBucketUpperBoundUs(Index), MaxUs.load(std::memory_order_relaxed)) / 1000.0;
+		}
+	}
+
+	return GetMaxMs();
+}
+
+double FCaptureLatencyHistogram::GetMeanMs() const
+{
+	const uint64 Total = Count.load(std::memory_order_relaxed);
+	return Total > 0 ? static_cast<double>(SumUs.load(std::memory_order_relaxed)) / Total / 1000.0 : 0.0;
+}
+
+void FCaptureLatencyHistogram::GetCumulativeCounts(TConstArrayView<double> UpperBoundsMs, TArray<uint64>& OutCounts, uint64& OutTotal) const
+{
+	OutCounts.Reset(UpperBoundsMs.Num());
+	OutTotal = 0;
+
+	int32 Bound = 0;
+	for (int32 Index = 0; Index < NumBuckets; ++Index)
+	{
+		// Close every bound this bucket does not fit under before adding it
+		const uint64 BucketUpperUs = GetBucketUpperBoundUs(Index);
+		while (Bound < UpperBoundsMs.Num() && static_cast<double>(BucketUpperUs) > UpperBoundsMs[Bound] * 1000.0)
+		{
+			OutCounts.Add(OutTotal);
+			++Bound;
+		}
+		OutTotal += Buckets[Index].load(std::memory_order_relaxed);
+	}
+
+	while (Bound < UpperBoundsMs.Num())
+	{
+		OutCounts.Add(OutTotal);
+		++Bound;
+	}
+}
+
+void FCaptureLatencyHistogram::Reset()
+{
+	for (std::atomic<uint64>& Bucket : Buckets)
+	{
+		Bucket.store(0, std::memory_order_relaxed);
+	}
+	Count.store(0, std::memory_order_relaxed);
+	SumUs.store(0, std::memory_order_relaxed);
+	MaxUs.store(0, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// FCapturePipelineCounters Implementation
+// ============================================================================
+
+void FCapturePipelineCounters::RecordWrite(bool bSucceeded, int64 Bytes, double LatencyMs)
+{
+	if (!bSucceeded)
+	{
+		WriteFailures.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	FramesWritten.fetch_add(1, std::memory_order_relaxed);
+	BytesWritten.fetch_add(Bytes, std::memory_order_relaxed);
+	HarvestToWritten.Record(LatencyMs);
+}
+
+void FCapturePipelineCounters::Reset()
+{
+	KickToReady.Reset();
+	ReadyToHarvest.Reset();
+	HarvestToWritten.Reset();
+	FramesWritten.store(0, std::memory_order_relaxed);
+	BytesWritten.store(0, std::memory_order_relaxed);
+	WriteFailures.store(0, std::memory_order_relaxed);
+}
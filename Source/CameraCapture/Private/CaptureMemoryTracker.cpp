@@ -0,0 +1,71 @@
+#include "CaptureMemoryTracker.h"
+
+// ============================================================================
+// FCaptureMemoryTracker Implementation
+// ============================================================================
+
+FCaptureMemoryTracker::FReservation::FReservation(const TSharedRef<FCaptureMemoryTracker, ESPMode::ThreadSafe>& InTracker, int64 InBytes)
+	: Tracker(InTracker)
+	, Bytes(InBytes)
+{
+}
+
+FCaptureMemoryTracker::FReservation::~FReservation()
+{
+	Tracker->Release(Bytes);
+}
+
+FCaptureMemoryTracker::FReservationPtr FCaptureMemoryTracker::TryReserve(int64 Bytes)
+{
+	Bytes = FMath::Max<int64>(Bytes, 0);
+
+	// Claim the bytes only if they fit, so concurrent reservations can't overshoot together
+	int64 Reserved = ReservedBytes.load(std::memory_order_relaxed);
+	do
+	{
+		const int64 Budget = GetBudgetBytes();
+		if (Budget > 0 && Reserved + Bytes > Budget)
+		{
+			return nullptr;
+		}
+	}
+	while (!ReservedBytes.compare_exchange_weak(Reserved, Reserved + Bytes, std::memory_order_relaxed));
+
+	UpdatePeak(Reserved + Bytes);
+	return MakeShared<FReservation, ESPMode::ThreadSafe>(AsShared(), Bytes);
+}
+
+FCaptureMemoryTracker::FReservationPtr FCaptureMemoryTracker::ForceReserve(int64 Bytes)
+{
+	Bytes = FMath::Max<int64>(Bytes, 0);
+
+	const int64 Reserved = ReservedBytes.fetch_add(Bytes, std::memory_order_relaxed) + Bytes;
+	const int64 Budget = GetBudgetBytes();
+	if (Budget > 0 && Reserved > Budget)
+	{
+		BudgetOverruns.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	UpdatePeak(Reserved);
+	return MakeShared<FReservation, ESPMode::ThreadSafe>(AsShared(), Bytes);
+}
+
+bool FCaptureMemoryTracker::WouldFit(int64 Bytes) const
+{
+	const int64 Budget = GetBudgetBytes();
+	return Budget <= 0 || GetReservedBytes() + Bytes <= Budget;
+}
+
+void FCaptureMemoryTracker::ResetPeaks()
+{
+	PeakReservedBytes.store(GetReservedBytes(), std::memory_order_relaxed);
+	BudgetOverruns.store(0, std::memory_order_relaxed);
+}
+
+void FCaptureMemoryTracker::UpdatePeak(int64 Reserved)
+{
+	int64 Peak = PeakReservedBytes.load(std::memory_order_relaxed);
+	while (Reserved > Peak && !PeakReservedBytes.compare_exchange_weak(Peak, Reserved, std::memory_order_relaxed))
+	{
+	}
+}
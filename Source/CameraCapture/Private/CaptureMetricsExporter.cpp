@@ -0,0 +1,299 @@
+#include "CaptureMetricsExporter.h"
+#include "HAL/FileManager.h"
+#include "Async/Async.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include "Windows/WindowsHWrapper.h"
+#include "Windows/HideWindowsPlatformTypes.h"
+#else
+#include <stdio.h>
+#endif
+
+// ============================================================================
+// Formatting
+// ============================================================================
+
+const double FCaptureMetricsExporter::LatencyBucketSeconds[13] = { 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0 };
+
+namespace
+{
+	/** Appends metric families. In the text format every sample of a family must directly
+	 *  follow its TYPE line, so per-camera families loop over the cameras themselves. */
+	struct FMetricsTextWriter
+	{
+		FAnsiStringBuilderBase& Out;
+		TArray<uint64>			Counts;
+
+		void Family(const ANSICHAR* Name, const ANSICHAR* Type, const ANSICHAR* Help)
+		{
+			Out.Appendf("# HELP %s %s\n# TYPE %s %s\n", Name, Help, Name, Type);
+		}
+
+		/** Append the sample name and, for per-camera samples, the opening of its label set */
+		void BeginSample(const ANSICHAR* Name, const ANSICHAR* Suffix, const FString* CameraID)
+		{
+			Out.Append(Name);
+			Out.Append(Suffix);
+			if (CameraID)
+			{
+				Out.Append("{camera=\"");
+				AppendLabelValue(*CameraID);
+				Out.Append("\"");
+			}
+		}
+
+		void Sample(const ANSICHAR* Name, const FString* CameraID, int64 Value)
+		{
+			BeginSample(Name, "", CameraID);
+			Out.Appendf("%s %lld\n", CameraID ? "}" : "", Value);
+		}
+
+		void Sample(const ANSICHAR* Name, const FString* CameraID, double Value)
+		{
+			BeginSample(Name, "", CameraID);
+			Out.Appendf("%s %.9g\n", CameraID ? "}" : "", Value);
+		}
+
+		void Histogram(const ANSICHAR* Name, const FString* CameraID, const FCaptureLatencyHistogram& Histogram)
+		{
+			double BoundsMs[UE_ARRAY_COUNT(FCaptureMetricsExporter::LatencyBucketSeconds)];
+			for (int32 i = 0; i < UE_ARRAY_COUNT(BoundsMs); ++i)
+			{
+				BoundsMs[i] = FCaptureMetricsExporter::LatencyBucketSeconds[i] * 1000.0;
+			}
+
+			uint64 Total = 0;
+			Histogram.GetCumulativeCounts(BoundsMs, Counts, Total);
+
+			for (int32 i = 0; i < Counts.Num(); ++i)
+			{
+				BeginSample(Name, "_bucket", CameraID);
+				Out.Appendf("%sle=\"%g\"} %llu\n", CameraID ? "," : "{", FCaptureMetricsExporter::LatencyBucketSeconds[i], Counts[i]);
+			}
+			BeginSample(Name, "_bucket", CameraID);
+			Out.Appendf("%sle=\"+Inf\"} %llu\n", CameraID ? "," : "{", Total);
+
+			BeginSample(Name, "_sum", CameraID);
+			Out.Appendf("%s %.9g\n", CameraID ? "}" : "", Histogram.GetSumMs() / 1000.0);
+			BeginSample(Name, "_count", CameraID);
+			Out.Appendf("%s %llu\n", CameraID ? "}" : "", Total);
+		}
+
+		/** Camera IDs are user-controlled: escape per the text format and emit as UTF-8 */
+		void AppendLabelValue(const FString& Value)
+		{
+			FString Escaped = Value.Replace(TEXT("\\"), TEXT("\\\\"));
+			Escaped.ReplaceInline(TEXT("\""), TEXT("\\\""));
+			Escaped.ReplaceInline(TEXT("\n"), TEXT("\\n"));
+
+			const FTCHARToUTF8 Converted(*Escaped);
+			Out.Append(reinterpret_cast<const ANSICHAR*>(Converted.Get()), Converted.Length());
+		}
+	};
+}
+
+void FCaptureMetricsExporter::FormatMetrics(const FSnapshot& Snapshot, FAnsiStringBuilderBase& Out)
+{
+	const FCaptureStatistics& Stats = Snapshot.Stats;
+	FMetricsTextWriter		  Writer { Out };
+
+	// Session
+	Writer.Family("camera_capture_session_seconds", "gauge", "Seconds since the statistics were last reset.");
+	Writer.Sample("camera_capture_session_seconds", nullptr, static_cast<double>(Stats.SessionSeconds));
+	Writer.Family("camera_capture_registered_cameras", "gauge", "Cameras registered with the capture subsystem.");
+	Writer.Sample("camera_capture_registered_cameras", nullptr, static_cast<int64>(Stats.RegisteredCameraCount));
+	Writer.Family("camera_capture_rate_hertz", "gauge", "Frames captured per second across all cameras.");
+	Writer.Sample("camera_capture_rate_hertz", nullptr, static_cast<double>(Stats.AchievedCaptureRateHz));
+
+	Writer.Family("camera_capture_frames_captured_total", "counter", "Frames harvested from the GPU.");
+	Writer.Sample("camera_capture_frames_captured_total", nullptr, Stats.TotalFramesCaptured);
+	Writer.Family("camera_capture_frames_dropped_total", "counter", "Readbacks abandoned after the readback timeout.");
+	Writer.Sample("camera_capture_frames_dropped_total", nullptr, Stats.TotalFramesDropped);
+	Writer.Family("camera_capture_frames_throttled_total", "counter", "Captures skipped because the pipeline was saturated.");
+	Writer.Sample("camera_capture_frames_throttled_total", nullptr, Stats.TotalFramesThrottled);
+	Writer.Family("camera_capture_frames_written_total", "counter", "Frames whose files are all on disk.");
+	Writer.Sample("camera_capture_frames_written_total", nullptr, Stats.TotalFramesWritten);
+	Writer.Family("camera_capture_frame_write_failures_total", "counter", "Frames with at least one file that failed to write.");
+	Writer.Sample("camera_capture_frame_write_failures_total", nullptr, Stats.TotalFramesWriteFailed);
+	Writer.Family("camera_capture_written_bytes_total", "counter", "Bytes of capture files written.");
+	Writer.Sample("camera_capture_written_bytes_total", nullptr, Stats.TotalBytesWritten);
+
+	Writer.Family("camera_capture_pending_readbacks", "gauge", "Captures waiting on GPU readback.");
+	Writer.Sample("camera_capture_pending_readbacks", nullptr, static_cast<int64>(Stats.PendingReadbackCount));
+	Writer.Family("camera_capture_pending_readbacks_max", "gauge", "Most captures waiting on GPU readback this session.");
+	Writer.Sample("camera_capture_pending_readbacks_max", nullptr, static_cast<int64>(Stats.MaxPendingReadbackCount));
+	Writer.Family("camera_capture_serialization_backlog", "gauge", "Frames waiting to be written.");
+	Writer.Sample("camera_capture_serialization_backlog", nullptr, static_cast<int64>(Stats.SerializationBacklog));
+	Writer.Family("camera_capture_serialization_backlog_max", "gauge", "Most frames waiting to be written this session.");
+	Writer.Sample("camera_capture_serialization_backlog_max", nullptr, static_cast<int64>(Stats.MaxSerializationBacklog));
+
+	Writer.Family("camera_capture_gpu_milliseconds_per_second", "gauge", "GPU time spent on captures per second of wall time.");
+	Writer.Sample("camera_capture_gpu_milliseconds_per_second", nullptr, static_cast<double>(Stats.GpuCaptureMsPerSecond));
+	Writer.Family("camera_capture_gpu_timers_unresolved_total", "counter", "GPU timers discarded before their timestamps were available.");
+	Writer.Sample("camera_capture_gpu_timers_unresolved_total", nullptr, Stats.TotalGpuTimersUnresolved);
+	Writer.Family("camera_capture_pooled_render_target_bytes", "gauge", "Render target memory held by the pool.");
+	Writer.Sample("camera_capture_pooled_render_target_bytes", nullptr, Stats.PooledRenderTargetBytes);
+	Writer.Family("camera_capture_pooled_pixel_buffer_bytes", "gauge", "Idle pixel buffer memory held by the pool.");
+	Writer.Sample("camera_capture_pooled_pixel_buffer_bytes", nullptr, Stats.PooledPixelBufferBytes);
+	Writer.Family("camera_capture_outstanding_pixel_buffer_bytes", "gauge", "Pixel buffer memory held by frames in flight.");
+	Writer.Sample("camera_capture_outstanding_pixel_buffer_bytes", nullptr, Stats.OutstandingPixelBufferBytes);
+
+	Writer.Family("camera_capture_memory_budget_bytes", "gauge", "Capture memory budget (0 when unlimited).");
+	Writer.Sample("camera_capture_memory_budget_bytes", nullptr, Stats.MemoryBudgetBytes);
+	Writer.Family("camera_capture_memory_reserved_bytes", "gauge", "Worst-case memory of captures in flight, counted against the budget.");
+	Writer.Sample("camera_capture_memory_reserved_bytes", nullptr, Stats.ReservedMemoryBytes);
+	Writer.Family("camera_capture_memory_reserved_bytes_max", "gauge", "Most memory reserved by captures this session.");
+	Writer.Sample("camera_capture_memory_reserved_bytes_max", nullptr, Stats.PeakReservedMemoryBytes);
+	Writer.Family("camera_capture_memory_readback_bytes", "gauge", "Pixel planes kicked captures will need once their readbacks land.");
+	Writer.Sample("camera_capture_memory_readback_bytes", nullptr, Stats.ReadbackMemoryBytes);
+	Writer.Family("camera_capture_memory_awaiting_emit_bytes", "gauge", "Pixels copied out of readbacks and waiting for the game thread.");
+	Writer.Sample("camera_capture_memory_awaiting_emit_bytes", nullptr, Stats.AwaitingEmitMemoryBytes);
+	Writer.Family("camera_capture_memory_frame_bytes", "gauge", "Pixel planes of frames held by listeners, frame sets and the writer.");
+	Writer.Sample("camera_capture_memory_frame_bytes", nullptr, Stats.FrameMemoryBytes);
+	Writer.Family("camera_capture_memory_queued_for_write_bytes", "gauge", "Pixel planes of frames waiting on or being written by the writer.");
+	Writer.Sample("camera_capture_memory_queued_for_write_bytes", nullptr, Stats.QueuedForWriteMemoryBytes);
+	Writer.Family("camera_capture_memory_encoding_bytes", "gauge", "EXR staging arrays and copies queued on the image write queue.");
+	Writer.Sample("camera_capture_memory_encoding_bytes", nullptr, Stats.EncodingMemoryBytes);
+	Writer.Family("camera_capture_frames_over_budget_total", "counter", "Captures skipped or dropped to stay within the memory budget.");
+	Writer.Sample("camera_capture_frames_over_budget_total", nullptr, Stats.TotalFramesOverBudget);
+	Writer.Family("camera_capture_memory_budget_overruns_total", "counter", "Captures that could not be skipped and went over the memory budget.");
+	Writer.Sample("camera_capture_memory_budget_overruns_total", nullptr, Stats.MemoryBudgetOverruns);
+
+	if (Snapshot.SessionCounters.IsValid())
+	{
+		Writer.Family("camera_capture_kick_to_ready_seconds", "histogram", "Capture kick until its readbacks were ready.");
+		Writer.Histogram("camera_capture_kick_to_ready_seconds", nullptr, Snapshot.SessionCounters->KickToReady);
+		Writer.Family("camera_capture_ready_to_harvest_seconds", "histogram", "Readback ready until the frame was handed to listeners.");
+		Writer.Histogram("camera_capture_ready_to_harvest_seconds", nullptr, Snapshot.SessionCounters->ReadyToHarvest);
+		Writer.Family("camera_capture_harvest_to_written_seconds", "histogram", "Frame handed to the writer until its files were on disk.");
+		Writer.Histogram("camera_capture_harvest_to_written_seconds", nullptr, Snapshot.SessionCounters->HarvestToWritten);
+	}
+
+	// Per camera
+	const TArray<FCameraCaptureStatistics>& Cameras = Stats.PerCamera;
+
+	auto CameraFamily = [&Writer, &Cameras](const ANSICHAR* Name, const ANSICHAR* Type, const ANSICHAR* Help, auto GetValue) {
+		Writer.Family(Name, Type, Help);
+		for (const FCameraCaptureStatistics& Camera : Cameras)
+		{
+			Writer.Sample(Name, &Camera.CameraID, GetValue(Camera));
+		}
+	};
+
+	CameraFamily("camera_capture_camera_target_rate_hertz", "gauge", "Configured capture rate (0 when driven by frame count).",
+		[](const FCameraCaptureStatistics& Camera) { return static_cast<double>(Camera.TargetRateHz); });
+	CameraFamily("camera_capture_camera_rate_hertz", "gauge", "Frames captured per second.",
+		[](const FCameraCaptureStatistics& Camera) { return static_cast<double>(Camera.AchievedRateHz); });
+	CameraFamily("camera_capture_camera_frames_kicked_total", "counter", "Captures submitted to the GPU.",
+		[](const FCameraCaptureStatistics& Camera) { return Camera.FramesKicked; });
+	CameraFamily("camera_capture_camera_frames_captured_total", "counter", "Frames harvested from the GPU.",
+		[](const FCameraCaptureStatistics& Camera) { return Camera.FramesHarvested; });
+	CameraFamily("camera_capture_camera_frames_dropped_total", "counter", "Readbacks abandoned after the readback timeout.",
+		[](const FCameraCaptureStatistics& Camera) { return Camera.FramesDropped; });
+	CameraFamily("camera_capture_camera_frames_throttled_total", "counter", "Captures skipped because the pipeline was saturated.",
+		[](const FCameraCaptureStatistics& Camera) { return Camera.FramesThrottled; });
+	CameraFamily("camera_capture_camera_frames_over_budget_total", "counter", "Captures skipped or dropped to stay within the memory budget.",
+		[](const FCameraCaptureStatistics& Camera) { return Camera.FramesOverBudget; });
+	CameraFamily("camera_capture_camera_frames_unchanged_total", "counter", "Captures skipped because nothing in view changed.",
+		[](const FCameraCaptureStatistics& Camera) { return Camera.FramesUnchanged; });
+	CameraFamily("camera_capture_camera_frames_written_total", "counter", "Frames whose files are all on disk.",
+		[](const FCameraCaptureStatistics& Camera) { return Camera.FramesWritten; });
+	CameraFamily("camera_capture_camera_frame_write_failures_total", "counter", "Frames with at least one file that failed to write.",
+		[](const FCameraCaptureStatistics& Camera) { return Camera.FramesWriteFailed; });
+	CameraFamily("camera_capture_camera_written_bytes_total", "counter", "Bytes of capture files written.",
+		[](const FCameraCaptureStatistics& Camera) { return Camera.BytesWritten; });
+	CameraFamily("camera_capture_camera_queue_depth", "gauge", "Captures waiting on GPU readback.",
+		[](const FCameraCaptureStatistics& Camera) { return static_cast<int64>(Camera.QueueDepth); });
+	CameraFamily("camera_capture_camera_queue_depth_max", "gauge", "Most captures waiting on GPU readback this session.",
+		[](const FCameraCaptureStatistics& Camera) { return static_cast<int64>(Camera.MaxQueueDepth); });
+	CameraFamily("camera_capture_camera_gpu_milliseconds", "gauge", "Running average GPU time of one capture.",
+		[](const FCameraCaptureStatistics& Camera) { return static_cast<double>(Camera.AverageGpuTimeMs); });
+
+	auto CameraHistogram = [&Writer, &Cameras, &Snapshot](const ANSICHAR* Name, const ANSICHAR* Help, FCaptureLatencyHistogram FCapturePipelineCounters::*Member) {
+		Writer.Family(Name, "histogram", Help);
+		for (int32 i = 0; i < Cameras.Num(); ++i)
+		{
+			if (Snapshot.CameraCounters.IsValidIndex(i) && Snapshot.CameraCounters[i].IsValid())
+			{
+				Writer.Histogram(Name, &Cameras[i].CameraID, (*Snapshot.CameraCounters[i]).*Member);
+			}
+		}
+	};
+
+	CameraHistogram("camera_capture_camera_kick_to_ready_seconds", "Capture kick until its readbacks were ready.", &FCapturePipelineCounters::KickToReady);
+	CameraHistogram("camera_capture_camera_ready_to_harvest_seconds", "Readback ready until the frame was handed to listeners.", &FCapturePipelineCounters::ReadyToHarvest);
+	CameraHistogram("camera_capture_camera_harvest_to_written_seconds", "Frame handed to the writer until its files were on disk.", &FCapturePipelineCounters::HarvestToWritten);
+}
+
+namespace
+{
+	/** Replace Destination with Source in a single rename, so readers see either the old file or
+	 *  the new one. IFileManager::Move deletes the destination first (and may fall back to a copy). */
+	bool ReplaceFileAtomically(const FString& Destination, const FString& Source)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		const FString DestinationPath = FileManager.ConvertToAbsolutePathForExternalAppForWrite(*Destination);
+		const FString SourcePath = FileManager.ConvertToAbsolutePathForExternalAppForWrite(*Source);
+
+#if PLATFORM_WINDOWS
+		return ::MoveFileExW(*SourcePath, *DestinationPath, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+		return ::rename(TCHAR_TO_UTF8(*SourcePath), TCHAR_TO_UTF8(*DestinationPath)) == 0;
+#endif
+	}
+}
+
+// ============================================================================
+// FCaptureMetricsExporter Implementation
+// ============================================================================
+
+FCaptureMetricsExporter::FCaptureMetricsExporter(const FString& InFilePath)
+	: FilePath(InFilePath)
+{
+}
+
+bool FCaptureMetricsExporter::ExportAsync(FSnapshot&& Snapshot)
+{
+	if (PendingExport.IsValid() && !PendingExport.IsReady())
+	{
+		return false;
+	}
+
+	PendingExport = Async(EAsyncExecution::ThreadPool, [This = AsShared(), Snapshot = MoveTemp(Snapshot)]() {
+		This->Export(Snapshot);
+	});
+	return true;
+}
+
+void FCaptureMetricsExporter::Wait()
+{
+	if (PendingExport.IsValid())
+	{
+		PendingExport.Wait();
+	}
+}
+
+void FCaptureMetricsExporter::Export(const FSnapshot& Snapshot)
+{
+	Buffer.Reset();
+	FormatMetrics(Snapshot, Buffer);
+
+	// The textfile collector only reads *.prom, so the temporary file is never scraped
+	const FString TempPath = FilePath + TEXT(".tmp");
+	IFileManager& FileManager = IFileManager::Get();
+
+	bool bSucceeded = false;
+	if (TUniquePtr<FArchive> Writer = TUniquePtr<FArchive>(FileManager.CreateFileWriter(*TempPath)))
+	{
+		Writer->Serialize(const_cast<ANSICHAR*>(Buffer.GetData()), Buffer.Len());
+		bSucceeded = Writer->Close();
+	}
+	bSucceeded = bSucceeded && ReplaceFileAtomically(FilePath, TempPath);
+
+	if (!bSucceeded && !bLastExportFailed)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[CaptureMetricsExporter] Failed to write metrics to %s"), *FilePath);
+	}
+	bLastExportFailed = !bSucceeded;
+}
@@ -0,0 +1,276 @@
+#include "CaptureTimeline.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/ThreadManager.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/StringBuilder.h"
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+std::atomic<bool>										FCaptureTimeline::bRecording { false };
+std::atomic<uint32>										FCaptureTimeline::Generation { 0 };
+std::atomic<int64>										FCaptureTimeline::NumEvents { 0 };
+std::atomic<int64>										FCaptureTimeline::NumDropped { 0 };
+std::atomic<int64>										FCaptureTimeline::MaxEvents { 0 };
+double													FCaptureTimeline::StartSeconds = 0.0;
+TArray<TSharedPtr<FCaptureTimeline::FThreadBuffer, ESPMode::ThreadSafe>> FCaptureTimeline::Buffers;
+FCriticalSection										FCaptureTimeline::BuffersMutex;
+
+FCaptureTimeline::FThreadBuffer::~FThreadBuffer()
+{
+	FChunk* Chunk = Head.Next.load(std::memory_order_acquire);
+	while (Chunk)
+	{
+		FChunk* Next = Chunk->Next.load(std::memory_order_acquire);
+		delete Chunk;
+		Chunk = Next;
+	}
+}
+
+void FCaptureTimeline::Start(int64 InMaxEvents)
+{
+	FScopeLock Lock(&BuffersMutex);
+
+	// Threads notice the new generation on their next event and register a fresh buffer
+	Generation.fetch_add(1, std::memory_order_acq_rel);
+	Buffers.Reset();
+	NumEvents.store(0, std::memory_order_relaxed);
+	NumDropped.store(0, std::memory_order_relaxed);
+	MaxEvents.store(FMath::Max<int64>(InMaxEvents, 0), std::memory_order_relaxed);
+	StartSeconds = FPlatformTime::Seconds();
+	bRecording.store(true, std::memory_order_release);
+}
+
+FCaptureTimeline::FThreadBuffer* FCaptureTimeline::GetThreadBuffer()
+{
+	static thread_local TSharedPtr<FThreadBuffer, ESPMode::ThreadSafe> ThreadBuffer;
+	static thread_local uint32										   ThreadGeneration = 0;
+
+	const uint32 CurrentGeneration = Generation.load(std::memory_order_acquire);
+	if (ThreadBuffer.IsValid() && ThreadGeneration == CurrentGeneration)
+	{
+		return ThreadBuffer.Get();
+	}
+
+	TSharedPtr<FThreadBuffer, ESPMode::ThreadSafe> NewBuffer = MakeShared<FThreadBuffer, ESPMode::ThreadSafe>();
+	NewBuffer->ThreadId = FPlatformTLS::GetCurrentThreadId();
+
+	FScopeLock Lock(&BuffersMutex);
+
+	// Recording stopped or restarted while the buffer was being allocated
+	if (!bRecording.load(std::memory_order_relaxed) || Generation.load(std::memory_order_relaxed) != CurrentGeneration)
+	{
+		return nullptr;
+	}
+
+	Buffers.Add(NewBuffer);
+	ThreadBuffer = MoveTemp(NewBuffer);
+	ThreadGeneration = CurrentGeneration;
+	return ThreadBuffer.Get();
+}
+
+void FCaptureTimeline::Record(const TCHAR* Stage, FName CameraID, int64 FrameNumber, double BeginSeconds, double EndSeconds, ETrack Track)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	if (NumEvents.fetch_add(1, std::memory_order_relaxed) >= MaxEvents.load(std::memory_order_relaxed))
+	{
+		NumDropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	FThreadBuffer* Buffer = GetThreadBuffer();
+	if (!Buffer)
+	{
+		return;
+	}
+
+	FChunk* Chunk = Buffer->Tail;
+	int32	Index = Chunk->Num.load(std::memory_order_relaxed);
+	if (Index == FChunk::Capacity)
+	{
+		FChunk* NewChunk = new FChunk();
+		Chunk->Next.store(NewChunk, std::memory_order_release);
+		Buffer->Tail = NewChunk;
+		Chunk = NewChunk;
+		Index = 0;
+	}
+
+	Chunk->Events[Index] = FEvent { Stage, CameraID, FrameNumber, BeginSeconds, EndSeconds, Track };
+	Chunk->Num.store(Index + 1, std::memory_order_release);
+}
+
+// ============================================================================
+// Chrome Trace Event JSON
+// ============================================================================
+
+namespace
+{
+	/** JSON-escaped UTF-8 of the few distinct stage and camera names, converted once each */
+	struct FJsonNameCache
+	{
+		TMap<const TCHAR*, TArray<ANSICHAR>> Stages;
+		TMap<FName, TArray<ANSICHAR>>		 Cameras;
+
+		static TArray<ANSICHAR> Escape(const FString& Value)
+		{
+			FString Escaped;
+			Escaped.Reserve(Value.Len());
+			for (TCHAR Char : Value)
+			{
+				if (Char == TEXT('"') || Char == TEXT('\\'))
+				{
+					Escaped.AppendChar(TEXT('\\'));
+					Escaped.AppendChar(Char);
+				}
+				else if (Char < 0x20)
+				{
+					Escaped.Appendf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+				}
+				else
+				{
+					Escaped.AppendChar(Char);
+				}
+			}
+
+			const FTCHARToUTF8 Converted(*Escaped);
+			return TArray<ANSICHAR>(reinterpret_cast<const ANSICHAR*>(Converted.Get()), Converted.Length());
+		}
+
+		void AppendStage(FAnsiStringBuilderBase& Out, const TCHAR* Stage)
+		{
+			const TArray<ANSICHAR>* Cached = Stages.Find(Stage);
+			if (!Cached)
+			{
+				Cached = &Stages.Add(Stage, Escape(Stage));
+			}
+			Out.Append(Cached->GetData(), Cached->Num());
+		}
+
+		void AppendCamera(FAnsiStringBuilderBase& Out, FName CameraID)
+		{
+			const TArray<ANSICHAR>* Cached = Cameras.Find(CameraID);
+			if (!Cached)
+			{
+				Cached = &Cameras.Add(CameraID, Escape(CameraID.ToString()));
+			}
+			Out.Append(Cached->GetData(), Cached->Num());
+		}
+	};
+}
+
+bool FCaptureTimeline::StopAndWrite(const FString& FilePath)
+{
+	bRecording.store(false, std::memory_order_release);
+
+	TArray<TSharedPtr<FThreadBuffer, ESPMode::ThreadSafe>> Recorded;
+	{
+		FScopeLock Lock(&BuffersMutex);
+		Recorded = MoveTemp(Buffers);
+		Buffers.Reset();
+		Generation.fetch_add(1, std::memory_order_acq_rel);
+	}
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CaptureTimeline] Failed to open %s"), *FilePath);
+		return false;
+	}
+
+	TAnsiStringBuilder<64 * 1024> Out;
+	FJsonNameCache				  Names;
+	bool						  bFirstEvent = true;
+	uint64						  NextAsyncId = 1;
+	int64						  NumWritten = 0;
+
+	auto BeginEvent = [&Out, &Writer, &bFirstEvent]() {
+		// Stream to disk well before the inline buffer would spill to the heap
+		if (Out.Len() > 60 * 1024)
+		{
+			Writer->Serialize(Out.GetData(), Out.Len());
+			Out.Reset();
+		}
+		Out.Append(bFirstEvent ? "\n" : ",\n");
+		bFirstEvent = false;
+	};
+
+	auto ToMicroseconds = [](double Seconds) { return (Seconds - StartSeconds) * 1000000.0; };
+
+	Out.Append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+	BeginEvent();
+	Out.Append("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"CameraCapture\"}}");
+
+	for (const TSharedPtr<FThreadBuffer, ESPMode::ThreadSafe>& Buffer : Recorded)
+	{
+		BeginEvent();
+		Out.Appendf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", Buffer->ThreadId);
+		const TArray<ANSICHAR> ThreadName = FJsonNameCache::Escape(FThreadManager::GetThreadName(Buffer->ThreadId));
+		Out.Append(ThreadName.GetData(), ThreadName.Num());
+		Out.Append("\"}}");
+
+		for (const FChunk* Chunk = &Buffer->Head; Chunk; Chunk = Chunk->Next.load(std::memory_order_acquire))
+		{
+			const int32 Num = Chunk->Num.load(std::memory_order_acquire);
+			for (int32 i = 0; i < Num; ++i)
+			{
+				const FEvent& Event = Chunk->Events[i];
+				const double  BeginUs = ToMicroseconds(Event.BeginSeconds);
+				const double  EndUs = ToMicroseconds(Event.EndSeconds);
+
+				if (Event.Track == ETrack::Thread)
+				{
+					BeginEvent();
+					Out.Append("{\"name\":\"");
+					Names.AppendStage(Out, Event.Stage);
+					Out.Appendf("\",\"cat\":\"CameraCapture\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"camera\":\"",
+						Buffer->ThreadId, BeginUs, FMath::Max(EndUs - BeginUs, 0.0));
+					Names.AppendCamera(Out, Event.CameraID);
+					Out.Appendf("\",\"frame\":%lld}}", Event.FrameNumber);
+				}
+				else
+				{
+					// Async begin/end pair on a per-camera track; frames of one camera overlap there
+					const ANSICHAR* TrackName = Event.Track == ETrack::Readback ? "Readback " : "Write ";
+					const uint64	AsyncId = NextAsyncId++;
+					for (int32 Phase = 0; Phase < 2; ++Phase)
+					{
+						BeginEvent();
+						Out.Append("{\"name\":\"");
+						Out.Append(TrackName);
+						Names.AppendCamera(Out, Event.CameraID);
+						Out.Appendf("\",\"cat\":\"CameraCapture\",\"ph\":\"%s\",\"id\":%llu,\"pid\":1,\"tid\":%u,\"ts\":%.3f",
+							Phase == 0 ? "b" : "e", AsyncId, Buffer->ThreadId, Phase == 0 ? BeginUs : EndUs);
+						if (Phase == 0)
+						{
+							Out.Append(",\"args\":{\"stage\":\"");
+							Names.AppendStage(Out, Event.Stage);
+							Out.Appendf("\",\"frame\":%lld}", Event.FrameNumber);
+						}
+						Out.Append("}");
+					}
+				}
+				++NumWritten;
+			}
+		}
+	}
+
+	const int64 Dropped = NumDropped.load(std::memory_order_relaxed);
+	Out.Appendf("\n],\"otherData\":{\"droppedEvents\":%lld}}\n", Dropped);
+	Writer->Serialize(Out.GetData(), Out.Len());
+
+	if (!Writer->Close())
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CaptureTimeline] Failed to write %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[CaptureTimeline] Wrote %lld events (%lld dropped) from %d threads to %s"), NumWritten, Dropped, Recorded.Num(), *FilePath);
+	return true;
+}
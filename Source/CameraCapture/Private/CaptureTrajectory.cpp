@@ -0,0 +1,457 @@
+#include "CaptureTrajectory.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+#include "Misc/FileHelper.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+// ============================================================================
+// FCaptureTrajectory Implementation
+// ============================================================================
+
+void FCaptureTrajectory::SerializePose(FArchive& Ar, FTransform& Transform)
+{
+	// Locations keep double precision (large worlds); rotation and scale do not need it
+	FVector Location = Transform.GetLocation();
+	FQuat4f Rotation = FQuat4f(Transform.GetRotation());
+	FVector3f Scale = FVector3f(Transform.GetScale3D());
+
+	Ar << Location.X << Location.Y << Location.Z;
+	Ar << Rotation.X << Rotation.Y << Rotation.Z << Rotation.W;
+	Ar << Scale.X << Scale.Y << Scale.Z;
+
+	if (Ar.IsLoading())
+	{
+		Transform = FTransform(FQuat(Rotation), Location, FVector(Scale));
+	}
+}
+
+bool FCaptureTrajectory::LoadFromFile(const FString& FilePath)
+{
+	CameraIDs.Reset();
+	ActorPaths.Reset();
+	SkeletalMeshPaths.Reset();
+	Frames.Reset();
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CaptureTrajectory] Failed to open trajectory: %s"), *FilePath);
+		return false;
+	}
+
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	*Reader << FileMagic << FileVersion;
+	if (FileMagic != Magic || FileVersion == 0 || FileVersion > Version)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CaptureTrajectory] Not a trajectory file (or unsupported version %u): %s"), FileVersion, *FilePath);
+		return false;
+	}
+
+	while (!Reader->AtEnd() && !Reader->IsError())
+	{
+		uint8 RecordType = 0;
+		*Reader << RecordType;
+
+		switch (static_cast<ERecordType>(RecordType))
+		{
+			case ERecordType::CameraDef:
+			{
+				FString CameraID;
+				*Reader << CameraID;
+				CameraIDs.Add(MoveTemp(CameraID));
+				break;
+			}
+
+			case ERecordType::ActorDef:
+			{
+				FString ActorPath;
+				*Reader << ActorPath;
+				ActorPaths.Add(MoveTemp(ActorPath));
+				break;
+			}
+
+			case ERecordType::SkeletalMeshDef:
+			{
+				FString ComponentPath;
+				*Reader << ComponentPath;
+				SkeletalMeshPaths.Add(MoveTemp(ComponentPath));
+				break;
+			}
+
+			case ERecordType::Frame:
+			{
+				FCaptureTrajectoryFrame& Frame = Frames.AddDefaulted_GetRef();
+				*Reader << Frame.FrameNumber << Frame.Timestamp;
+
+				int32 NumCameraPoses = 0;
+				*Reader << NumCameraPoses;
+				Frame.CameraPoses.SetNum(FMath::Max(0, NumCameraPoses));
+				for (FCaptureTrajectoryPose& Pose : Frame.CameraPoses)
+				{
+					*Reader << Pose.Index;
+					SerializePose(*Reader, Pose.Transform);
+				}
+
+				int32 NumActorPoses = 0;
+				*Reader << NumActorPoses;
+				Frame.ActorPoses.SetNum(FMath::Max(0, NumActorPoses));
+				for (FCaptureTrajectoryPose& Pose : Frame.ActorPoses)
+				{
+					*Reader << Pose.Index;
+					SerializePose(*Reader, Pose.Transform);
+				}
+
+				// Version 1 files have no skeletal poses
+				if (FileVersion >= 2)
+				{
+					int32 NumSkeletalPoses = 0;
+					*Reader << NumSkeletalPoses;
+					Frame.SkeletalPoses.SetNum(FMath::Max(0, NumSkeletalPoses));
+					for (FCaptureTrajectorySkeletalPose& Pose : Frame.SkeletalPoses)
+					{
+						int32 NumBones = 0;
+						*Reader << Pose.Index << NumBones;
+						if (Reader->IsError() || NumBones < 0 || NumBones > MaxBonesPerPose)
+						{
+							Reader->SetError();
+							break;
+						}
+						Pose.BoneTransforms.SetNum(NumBones);
+						for (FTransform& Bone : Pose.BoneTransforms)
+						{
+							SerializePose(*Reader, Bone);
+						}
+					}
+				}
+				break;
+			}
+
+			default:
+				UE_LOG(LogTemp, Error, TEXT("[CaptureTrajectory] Corrupt record (type %u) in %s after %d frames"),
+					RecordType, *FilePath, Frames.Num());
+				return false;
+		}
+	}
+
+	if (Reader->IsError())
+	{
+		// A truncated final frame (e.g., the live run was killed) is dropped; the rest is usable
+		UE_LOG(LogTemp, Warning, TEXT("[CaptureTrajectory] Trajectory truncated, dropping last frame: %s"), *FilePath);
+		if (Frames.Num() > 0)
+		{
+			Frames.Pop();
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[CaptureTrajectory] Loaded %d frames (%d cameras, %d actors, %d skeletal meshes) from %s"),
+		Frames.Num(), CameraIDs.Num(), ActorPaths.Num(), SkeletalMeshPaths.Num(), *FilePath);
+
+	return true;
+}
+
+// ============================================================================
+// FCaptureTrajectoryWriter Implementation
+// ============================================================================
+
+FCaptureTrajectoryWriter::~FCaptureTrajectoryWriter()
+{
+	Close();
+}
+
+bool FCaptureTrajectoryWriter::Open(const FString& FilePath)
+{
+	Close();
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+
+	Archive.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Archive)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CaptureTrajectory] Failed to create trajectory: %s"), *FilePath);
+		return false;
+	}
+
+	uint32 Magic = FCaptureTrajectory::Magic;
+	uint32 Version = FCaptureTrajectory::Version;
+	*Archive << Magic << Version;
+
+	CameraIndices.Reset();
+	ActorIndices.Reset();
+	SkeletalMeshIndices.Reset();
+	FramesWritten = 0;
+
+	UE_LOG(LogTemp, Log, TEXT("[CaptureTrajectory] Recording poses to %s"), *FilePath);
+	return true;
+}
+
+void FCaptureTrajectoryWriter::Close()
+{
+	if (!Archive)
+	{
+		return;
+	}
+
+	Archive->Close();
+	Archive.Reset();
+
+	UE_LOG(LogTemp, Log, TEXT("[CaptureTrajectory] Closed trajectory after %lld frames"), FramesWritten);
+}
+
+void FCaptureTrajectoryWriter::BeginFrame(int64 FrameNumber, double Timestamp)
+{
+	CurrentFrame.FrameNumber = FrameNumber;
+	CurrentFrame.Timestamp = Timestamp;
+	CurrentFrame.CameraPoses.Reset();
+	CurrentFrame.ActorPoses.Reset();
+	CurrentFrame.SkeletalPoses.Reset();
+}
+
+void FCaptureTrajectoryWriter::AddCameraPose(const FString& CameraID, const FTransform& Transform)
+{
+	if (!Archive)
+	{
+		return;
+	}
+
+	const int32 Index = FindOrAddDefinition(CameraIndices, CameraID, FCaptureTrajectory::ERecordType::CameraDef);
+	CurrentFrame.CameraPoses.Add({ Index, Transform });
+}
+
+void FCaptureTrajectoryWriter::AddActorPose(const FString& ActorPath, const FTransform& Transform)
+{
+	if (!Archive)
+	{
+		return;
+	}
+
+	const int32 Index = FindOrAddDefinition(ActorIndices, ActorPath, FCaptureTrajectory::ERecordType::ActorDef);
+	CurrentFrame.ActorPoses.Add({ Index, Transform });
+}
+
+void FCaptureTrajectoryWriter::AddSkeletalPose(const FString& ComponentPath, const TArray<FTransform>& BoneTransforms)
+{
+	if (!Archive || BoneTransforms.Num() > FCaptureTrajectory::MaxBonesPerPose)
+	{
+		return;
+	}
+
+	const int32 Index = FindOrAddDefinition(SkeletalMeshIndices, ComponentPath, FCaptureTrajectory::ERecordType::SkeletalMeshDef);
+	CurrentFrame.SkeletalPoses.Add({ Index, BoneTransforms });
+}
+
+void FCaptureTrajectoryWriter::EndFrame()
+{
+	if (!Archive || CurrentFrame.CameraPoses.Num() == 0)
+	{
+		return;
+	}
+
+	uint8 RecordType = static_cast<uint8>(FCaptureTrajectory::ERecordType::Frame);
+	*Archive << RecordType << CurrentFrame.FrameNumber << CurrentFrame.Timestamp;
+
+	int32 NumCameraPoses = CurrentFrame.CameraPoses.Num();
+	*Archive << NumCameraPoses;
+	for (FCaptureTrajectoryPose& Pose : CurrentFrame.CameraPoses)
+	{
+		*Archive << Pose.Index;
+		FCaptureTrajectory::SerializePose(*Archive, Pose.Transform);
+	}
+
+	int32 NumActorPoses = CurrentFrame.ActorPoses.Num();
+	*Archive << NumActorPoses;
+	for (FCaptureTrajectoryPose& Pose : CurrentFrame.ActorPoses)
+	{
+		*Archive << Pose.Index;
+		FCaptureTrajectory::SerializePose(*Archive, Pose.Transform);
+	}
+
+	int32 NumSkeletalPoses = CurrentFrame.SkeletalPoses.Num();
+	*Archive << NumSkeletalPoses;
+	for (FCaptureTrajectorySkeletalPose& Pose : CurrentFrame.SkeletalPoses)
+	{
+		int32 NumBones = Pose.BoneTransforms.Num();
+		*Archive << Pose.Index << NumBones;
+		for (FTransform& Bone : Pose.BoneTransforms)
+		{
+			FCaptureTrajectory::SerializePose(*Archive, Bone);
+		}
+	}
+
+	FramesWritten++;
+}
+
+int32 FCaptureTrajectoryWriter::FindOrAddDefinition(TMap<FString, int32>& Indices, const FString& Key, FCaptureTrajectory::ERecordType RecordType)
+{
+	if (const int32* Existing = Indices.Find(Key))
+	{
+		return *Existing;
+	}
+
+	// Definitions are written immediately, so they always precede the frame that uses them
+	uint8	RecordTypeByte = static_cast<uint8>(RecordType);
+	FString KeyCopy = Key;
+	*Archive << RecordTypeByte << KeyCopy;
+
+	const int32 Index = Indices.Num();
+	Indices.Add(Key, Index);
+	return Index;
+}
+
+// ============================================================================
+// FCapturePoseList Implementation
+// ============================================================================
+
+bool FCapturePoseList::LoadFromFile(const FString& FilePath)
+{
+	Poses.Reset();
+
+	const bool bLoaded = FPaths::GetExtension(FilePath).Equals(TEXT("json"), ESearchCase::IgnoreCase)
+		? LoadFromJson(FilePath)
+		: LoadFromCsv(FilePath);
+
+	if (bLoaded)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[CaptureTrajectory] Loaded %d poses from %s"), Poses.Num(), *FilePath);
+	}
+
+	return bLoaded;
+}
+
+bool FCapturePoseList::LoadFromCsv(const FString& FilePath)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath) || Lines.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CaptureTrajectory] Failed to read pose list: %s"), *FilePath);
+		return false;
+	}
+
+	// Map column names to indices so columns may appear in any order
+	TArray<FString> Header;
+	Lines[0].ParseIntoArray(Header, TEXT(","), false);
+
+	TMap<FString, int32> Columns;
+	for (int32 i = 0; i < Header.Num(); ++i)
+	{
+		Columns.Add(Header[i].TrimStartAndEnd().ToLower(), i);
+	}
+
+	for (const TCHAR* Required : { TEXT("x"), TEXT("y"), TEXT("z"), TEXT("pitch"), TEXT("yaw"), TEXT("roll") })
+	{
+		if (!Columns.Contains(Required))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[CaptureTrajectory] Pose list %s is missing column '%s'"), *FilePath, Required);
+			return false;
+		}
+	}
+
+	const bool bHasIntrinsics = Columns.Contains(TEXT("fx")) && Columns.Contains(TEXT("fy")) && Columns.Contains(TEXT("cx"))
+		&& Columns.Contains(TEXT("cy")) && Columns.Contains(TEXT("width")) && Columns.Contains(TEXT("height"));
+
+	for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		TArray<FString> Fields;
+		Lines[LineIndex].ParseIntoArray(Fields, TEXT(","), false);
+		if (Fields.Num() == 0 || Lines[LineIndex].TrimStartAndEnd().IsEmpty())
+		{
+			continue;
+		}
+
+		auto Field = [&Fields, &Columns](const TCHAR* Name) -> FString {
+			const int32* Index = Columns.Find(Name);
+			return Index && Fields.IsValidIndex(*Index) ? Fields[*Index].TrimStartAndEnd() : FString();
+		};
+		auto Number = [&Field](const TCHAR* Name) { return FCString::Atod(*Field(Name)); };
+
+		FCapturePoseListEntry& Entry = Poses.AddDefaulted_GetRef();
+		Entry.CameraID = Field(TEXT("camera"));
+		Entry.Transform = FTransform(
+			FRotator(Number(TEXT("pitch")), Number(TEXT("yaw")), Number(TEXT("roll"))),
+			FVector(Number(TEXT("x")), Number(TEXT("y")), Number(TEXT("z"))));
+
+		const FString Timestamp = Field(TEXT("timestamp"));
+		if (!Timestamp.IsEmpty())
+		{
+			Entry.Timestamp = FCString::Atod(*Timestamp);
+		}
+
+		// Rows may leave the intrinsics columns empty to keep the camera's own intrinsics
+		if (bHasIntrinsics && !Field(TEXT("fx")).IsEmpty())
+		{
+			Entry.bHasIntrinsics = true;
+			Entry.Intrinsics.FocalLengthX = static_cast<float>(Number(TEXT("fx")));
+			Entry.Intrinsics.FocalLengthY = static_cast<float>(Number(TEXT("fy")));
+			Entry.Intrinsics.PrincipalPointX = static_cast<float>(Number(TEXT("cx")));
+			Entry.Intrinsics.PrincipalPointY = static_cast<float>(Number(TEXT("cy")));
+			Entry.Intrinsics.ImageWidth = FCString::Atoi(*Field(TEXT("width")));
+			Entry.Intrinsics.ImageHeight = FCString::Atoi(*Field(TEXT("height")));
+		}
+	}
+
+	return true;
+}
+
+bool FCapturePoseList::LoadFromJson(const FString& FilePath)
+{
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CaptureTrajectory] Failed to read pose list: %s"), *FilePath);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject>	  RootObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	const TArray<TSharedPtr<FJsonValue>>* PoseValues = nullptr;
+	if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid() || !RootObject->TryGetArrayField(TEXT("poses"), PoseValues))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[CaptureTrajectory] Pose list %s is not a JSON object with a \"poses\" array"), *FilePath);
+		return false;
+	}
+
+	auto ReadVector = [](const TSharedPtr<FJsonObject>& Object, const TCHAR* Name, FVector& Out) {
+		const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+		if (!Object->TryGetArrayField(Name, Values) || Values->Num() != 3)
+		{
+			return false;
+		}
+		Out = FVector((*Values)[0]->AsNumber(), (*Values)[1]->AsNumber(), (*Values)[2]->AsNumber());
+		return true;
+	};
+
+	for (int32 PoseIndex = 0; PoseIndex < PoseValues->Num(); ++PoseIndex)
+	{
+		const TSharedPtr<FJsonObject> PoseObject = (*PoseValues)[PoseIndex]->AsObject();
+
+		FVector Location;
+		FVector Rotation;
+		if (!PoseObject.IsValid() || !ReadVector(PoseObject, TEXT("location"), Location) || !ReadVector(PoseObject, TEXT("rotation"), Rotation))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[CaptureTrajectory] Skipping pose %d in %s (needs location and rotation arrays)"), PoseIndex, *FilePath);
+			continue;
+		}
+
+		FCapturePoseListEntry& Entry = Poses.AddDefaulted_GetRef();
+		PoseObject->TryGetStringField(TEXT("camera"), Entry.CameraID);
+		PoseObject->TryGetNumberField(TEXT("timestamp"), Entry.Timestamp);
+		Entry.Transform = FTransform(FRotator(Rotation.X, Rotation.Y, Rotation.Z), Location);
+
+		const TSharedPtr<FJsonObject>* IntrinsicsObject = nullptr;
+		if (PoseObject->TryGetObjectField(TEXT("intrinsics"), IntrinsicsObject))
+		{
+			Entry.bHasIntrinsics = true;
+			Entry.Intrinsics.FocalLengthX = static_cast<float>((*IntrinsicsObject)->GetNumberField(TEXT("fx")));
+			Entry.Intrinsics.FocalLengthY = static_cast<float>((*IntrinsicsObject)->GetNumberField(TEXT("fy")));
+			Entry.Intrinsics.PrincipalPointX = static_cast<float>((*IntrinsicsObject)->GetNumberField(TEXT("cx")));
+			Entry.Intrinsics.PrincipalPointY = static_cast<float>((*IntrinsicsObject)->GetNumberField(TEXT("cy")));
+			Entry.Intrinsics.ImageWidth = static_cast<int32>((*IntrinsicsObject)->GetNumberField(TEXT("width")));
+			Entry.Intrinsics.ImageHeight = static_cast<int32>((*IntrinsicsObject)->GetNumberField(TEXT("height")));
+		}
+	}
+
+	return true;
+}
@@ -8,6 +8,9 @@
 	#include "UObject/UObjectGlobals.h"
 #endif
 
+FOnIntrinsicCameraRegistrationChanged UIntrinsicSceneCaptureComponent2D::OnCameraRegistered;
+FOnIntrinsicCameraRegistrationChanged UIntrinsicSceneCaptureComponent2D::OnCameraUnregistered;
+
 UIntrinsicSceneCaptureComponent2D::UIntrinsicSceneCaptureComponent2D()
 {
 	PrimaryComponentTick.bCanEverTick = true;
@@ -40,6 +43,46 @@ void UIntrinsicSceneCaptureComponent2D::BeginPlay()
 	}
 }
 
+void UIntrinsicSceneCaptureComponent2D::OnRegister()
+{
+	Super::OnRegister();
+
+#if WITH_EDITOR
+	// Register delegate to listen for property changes on any object
+	if (!OnObjectPropertyChangedHandle.IsValid())
+	{
+		OnObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(
+			this, &UIntrinsicSceneCaptureComponent2D::OnObjectPropertyChanged);
+	}
+#endif
+
+	UWorld* World = GetWorld();
+	if (World && World->IsGameWorld() && !bIsCaptureHelper && !IsTemplate())
+	{
+		OnCameraRegistered.Broadcast(this);
+	}
+}
+
+void UIntrinsicSceneCaptureComponent2D::OnUnregister()
+{
+	UWorld* World = GetWorld();
+	if (World && World->IsGameWorld() && !bIsCaptureHelper && !IsTemplate())
+	{
+		OnCameraUnregistered.Broadcast(this);
+	}
+
+#if WITH_EDITOR
+	// Unregister delegate
+	if (OnObjectPropertyChangedHandle.IsValid())
+	{
+		FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(OnObjectPropertyChangedHandle);
+		OnObjectPropertyChangedHandle.Reset();
+	}
+#endif
+
+	Super::OnUnregister();
+}
+
 void UIntrinsicSceneCaptureComponent2D::BeginDestroy()
 {
 #if WITH_EDITOR
@@ -115,30 +158,6 @@ void UIntrinsicSceneCaptureComponent2D::PostEditChangeProperty(FPropertyChangedE
 	}
 }
 
-void UIntrinsicSceneCaptureComponent2D::OnRegister()
-{
-	Super::OnRegister();
-
-	// Register delegate to listen for property changes on any object
-	if (!OnObjectPropertyChangedHandle.IsValid())
-	{
-		OnObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(
-			this, &UIntrinsicSceneCaptureComponent2D::OnObjectPropertyChanged);
-	}
-}
-
-void UIntrinsicSceneCaptureComponent2D::OnUnregister()
-{
-	// Unregister delegate
-	if (OnObjectPropertyChangedHandle.IsValid())
-	{
-		FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(OnObjectPropertyChangedHandle);
-		OnObjectPropertyChangedHandle.Reset();
-	}
-
-	Super::OnUnregister();
-}
-
 void UIntrinsicSceneCaptureComponent2D::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
 {
 	// Check if the changed object is our IntrinsicsAsset
@@ -280,6 +299,28 @@ FMatrix UIntrinsicSceneCaptureComponent2D::BuildProjectionMatrixFromIntrinsics(c
 	return ProjectionMatrix;
 }
 
+uint32 UIntrinsicSceneCaptureComponent2D::GetProjectionHash() const
+{
+	const FCameraIntrinsics& Intrinsics = (bUseIntrinsicsAsset && IntrinsicsAsset) ? IntrinsicsAsset->Intrinsics : InlineIntrinsics;
+
+	uint32 Hash = GetTypeHash(bUseCustomIntrinsics);
+	Hash = HashCombine(Hash, GetTypeHash(Intrinsics.FocalLengthX));
+	Hash = HashCombine(Hash, GetTypeHash(Intrinsics.FocalLengthY));
+	Hash = HashCombine(Hash, GetTypeHash(Intrinsics.PrincipalPointX));
+	Hash = HashCombine(Hash, GetTypeHash(Intrinsics.PrincipalPointY));
+	Hash = HashCombine(Hash, GetTypeHash(Intrinsics.ImageWidth));
+	Hash = HashCombine(Hash, GetTypeHash(Intrinsics.ImageHeight));
+	Hash = HashCombine(Hash, GetTypeHash(Intrinsics.bMaintainYAxis));
+	Hash = HashCombine(Hash, GetTypeHash(FOVAngle));
+	Hash = HashCombine(Hash, GetTypeHash(bUseCustomProjectionMatrix));
+	if (bUseCustomProjectionMatrix)
+	{
+		// The matrix itself, so editing it rebuilds the shared camera info
+		Hash = HashCombine(Hash, FCrc::MemCrc32(&CustomProjectionMatrix, sizeof(CustomProjectionMatrix)));
+	}
+	return Hash;
+}
+
 void UIntrinsicSceneCaptureComponent2D::DrawCameraFrustum()
 {
 	UWorld* World = GetWorld();
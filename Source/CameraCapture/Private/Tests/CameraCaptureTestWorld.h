@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "CameraCaptureSubsystem.h"
+#include "IntrinsicSceneCaptureComponent2D.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+/**
+ * Transient game world with a capture subsystem, for automation tests and benchmarks.
+ * Cameras are created unregistered (no render state), which is enough to exercise
+ * the registry and scheduling code without rendering.
+ */
+class FCameraCaptureTestWorld
+{
+public:
+	FCameraCaptureTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+		FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+		Context.SetCurrentWorld(World);
+		World->InitializeActorsForPlay(FURL());
+	}
+
+	~FCameraCaptureTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	UCameraCaptureSubsystem* GetSubsystem() const { return World->GetSubsystem<UCameraCaptureSubsystem>(); }
+
+	/** Create NumCameras cameras, CamerasPerActor on each spawned actor */
+	TArray<UIntrinsicSceneCaptureComponent2D*> CreateCameras(int32 NumCameras, int32 CamerasPerActor = 10)
+	{
+		TArray<UIntrinsicSceneCaptureComponent2D*> Cameras;
+		Cameras.Reserve(NumCameras);
+
+		AActor* Owner = nullptr;
+		for (int32 Index = 0; Index < NumCameras; ++Index)
+		{
+			if (Index % CamerasPerActor == 0)
+			{
+				Owner = World->SpawnActor<AActor>();
+			}
+			Cameras.Add(NewObject<UIntrinsicSceneCaptureComponent2D>(Owner, *FString::Printf(TEXT("TestCamera%d"), Index % CamerasPerActor)));
+		}
+		return Cameras;
+	}
+
+	UWorld* World = nullptr;
+};
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,79 @@
+#include "CameraCaptureTestWorld.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraCaptureKickListBenchmark, "CameraCapture.Performance.KickList",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FCameraCaptureKickListBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumTicks = 100;
+
+	for (const int32 NumCameras : { 10, 100, 1000, 10000 })
+	{
+		FCameraCaptureTestWorld TestWorld;
+		UCameraCaptureSubsystem* Subsystem = TestWorld.GetSubsystem();
+		if (!TestNotNull(TEXT("Capture subsystem"), Subsystem))
+		{
+			return false;
+		}
+
+		// Dedicated targets without RHI resources: only the CPU-side bookkeeping is timed
+		for (UIntrinsicSceneCaptureComponent2D* Camera : TestWorld.CreateCameras(NumCameras))
+		{
+			UTextureRenderTarget2D* Target = NewObject<UTextureRenderTarget2D>(Camera);
+			Target->SizeX = 640;
+			Target->SizeY = 480;
+			Camera->TextureTarget = Target;
+			Subsystem->RegisterCamera(Camera);
+		}
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			Subsystem->RebuildKickList();
+		}
+		const double RebuildSeconds = (FPlatformTime::Seconds() - StartTime) / NumTicks;
+
+		// Per-tick resolution through the kick list, as the kick loop does it
+		int32 Resolved = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			for (const UCameraCaptureSubsystem::FCaptureKickRecord& Record : Subsystem->KickList)
+			{
+				const UIntrinsicSceneCaptureComponent2D* Camera = Record.Camera;
+				Resolved += IsValid(Camera) && Record.RgbTarget && Subsystem->CameraRegistry[Record.RegistryIndex].Serial != 0 && !Record.DmvCamera;
+			}
+		}
+		const double KickListSeconds = (FPlatformTime::Seconds() - StartTime) / NumTicks;
+
+		// The same resolution through per-camera map lookups (what the list replaces)
+		int32 LookedUp = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			for (const UCameraCaptureSubsystem::FRegisteredCamera& Entry : Subsystem->CameraRegistry)
+			{
+				const UIntrinsicSceneCaptureComponent2D* Camera = Entry.Camera.Get();
+				const UCameraCaptureSubsystem::FRegisteredCamera* Registered = Subsystem->FindRegisteredCamera(Camera);
+				const bool bHasDmv = Subsystem->DmvCameras.Contains(Entry.Camera);
+				LookedUp += Registered && Camera->TextureTarget && Camera->TextureTarget->SizeX > 0 && !bHasDmv;
+			}
+		}
+		const double LookupSeconds = (FPlatformTime::Seconds() - StartTime) / NumTicks;
+
+		TestEqual(FString::Printf(TEXT("%d kick records resolve"), NumCameras), Resolved, NumCameras * NumTicks);
+		TestEqual(FString::Printf(TEXT("%d cameras found by lookup"), NumCameras), LookedUp, NumCameras * NumTicks);
+
+		const double ToNanoseconds = 1e9 / NumCameras;
+		AddInfo(FString::Printf(TEXT("%5d cameras: rebuild %.1f ns, kick list %.1f ns, map lookups %.1f ns per camera per tick"),
+			NumCameras, RebuildSeconds * ToNanoseconds, KickListSeconds * ToNanoseconds, LookupSeconds * ToNanoseconds));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
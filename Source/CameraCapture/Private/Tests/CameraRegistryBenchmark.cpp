@@ -0,0 +1,59 @@
+#include "CameraCaptureTestWorld.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraRegistryBenchmark, "CameraCapture.Performance.CameraRegistry",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FCameraRegistryBenchmark::RunTest(const FString& Parameters)
+{
+	// Registration, lookup and removal should cost the same per camera at every scale
+	for (const int32 NumCameras : { 10, 100, 1000, 10000 })
+	{
+		FCameraCaptureTestWorld TestWorld;
+		UCameraCaptureSubsystem* Subsystem = TestWorld.GetSubsystem();
+		if (!TestNotNull(TEXT("Capture subsystem"), Subsystem))
+		{
+			return false;
+		}
+
+		const TArray<UIntrinsicSceneCaptureComponent2D*> Cameras = TestWorld.CreateCameras(NumCameras);
+		TArray<FString>									 UniqueIDs;
+		UniqueIDs.Reserve(NumCameras);
+
+		double StartTime = FPlatformTime::Seconds();
+		for (UIntrinsicSceneCaptureComponent2D* Camera : Cameras)
+		{
+			const FCameraHandle Handle = Subsystem->RegisterCamera(Camera);
+			UniqueIDs.Add(Subsystem->GetCameraIdentifier(Handle)->UniqueID);
+		}
+		const double RegisterSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		int32 Found = 0;
+		for (int32 Index = 0; Index < NumCameras; ++Index)
+		{
+			Found += Subsystem->GetCameraHandle(Cameras[Index]).IsValid() && Subsystem->FindCameraByID(UniqueIDs[Index]) == Cameras[Index];
+		}
+		const double LookupSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (UIntrinsicSceneCaptureComponent2D* Camera : Cameras)
+		{
+			Subsystem->UnregisterCamera(Camera);
+		}
+		const double UnregisterSeconds = FPlatformTime::Seconds() - StartTime;
+
+		TestEqual(FString::Printf(TEXT("%d cameras found by pointer and ID"), NumCameras), Found, NumCameras);
+		TestEqual(FString::Printf(TEXT("%d cameras all unregistered"), NumCameras), Subsystem->GetRegisteredCameras().Num(), 0);
+
+		const double ToMicroseconds = 1e6 / NumCameras;
+		AddInfo(FString::Printf(TEXT("%5d cameras: register %.2f us, lookup %.3f us, unregister %.2f us per camera"),
+			NumCameras, RegisterSeconds * ToMicroseconds, LookupSeconds * ToMicroseconds, UnregisterSeconds * ToMicroseconds));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
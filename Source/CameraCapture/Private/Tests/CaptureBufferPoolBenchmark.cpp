@@ -0,0 +1,112 @@
+#include "CaptureBufferPool.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CaptureBufferPoolBenchmark
+{
+	static constexpr int32 Width = 1280;
+	static constexpr int32 Height = 720;
+	static constexpr int32 NumFrames = 300;
+	static constexpr int32 FramesInFlight = 8; // Frames held by listeners and the serializer at once
+
+	struct FPlanes
+	{
+		TArray<FColor>	  ImageData;
+		TArray<float>	  DepthData;
+		TArray<FVector2D> MotionVectorData;
+	};
+
+	struct FResult
+	{
+		double AllocatorMs = 0.0;  // Acquiring and releasing planes, summed over all frames
+		double PeakRssDeltaMB = 0.0; // Highest resident set growth seen while running
+		double EndRssDeltaMB = 0.0;
+	};
+
+	/** Write one byte per page, as the harvest copy would, so the planes become resident */
+	template <typename ElementType>
+	static void TouchPages(TArray<ElementType>& Plane)
+	{
+		uint8*		Bytes = reinterpret_cast<uint8*>(Plane.GetData());
+		const int64 NumBytes = Plane.Num() * static_cast<int64>(sizeof(ElementType));
+		for (int64 Offset = 0; Offset < NumBytes; Offset += 4096)
+		{
+			Bytes[Offset] = 1;
+		}
+	}
+
+	/** Cycle NumFrames frames through FramesInFlight slots, with the pool (if given) or plain allocations */
+	static FResult Run(FCaptureBufferPool* Pool)
+	{
+		const double ToMB = 1.0 / (1024.0 * 1024.0);
+		const int64	 BaseRss = FPlatformMemory::GetStats().UsedPhysical;
+
+		FResult		   Result;
+		TArray<FPlanes> Slots;
+		Slots.SetNum(FramesInFlight);
+
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			FPlanes& Planes = Slots[Frame % FramesInFlight];
+
+			// The oldest frame's last reference goes, then the next harvest takes planes
+			const double StartTime = FPlatformTime::Seconds();
+			if (Pool)
+			{
+				Pool->Release(Planes.ImageData, Planes.DepthData, Planes.MotionVectorData);
+			}
+			Planes = FPlanes();
+
+			if (Pool)
+			{
+				Pool->Acquire(Planes.ImageData, Width * Height);
+				Pool->Acquire(Planes.DepthData, Width * Height);
+				Pool->Acquire(Planes.MotionVectorData, Width * Height);
+			}
+			else
+			{
+				Planes.ImageData.SetNumUninitialized(Width * Height);
+				Planes.DepthData.SetNumUninitialized(Width * Height);
+				Planes.MotionVectorData.SetNumUninitialized(Width * Height);
+			}
+			Result.AllocatorMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			TouchPages(Planes.ImageData);
+			TouchPages(Planes.DepthData);
+			TouchPages(Planes.MotionVectorData);
+
+			Result.PeakRssDeltaMB = FMath::Max(Result.PeakRssDeltaMB, (FPlatformMemory::GetStats().UsedPhysical - BaseRss) * ToMB);
+		}
+
+		Result.EndRssDeltaMB = (FPlatformMemory::GetStats().UsedPhysical - BaseRss) * ToMB;
+		return Result;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCaptureBufferPoolBenchmark, "CameraCapture.Performance.PixelBufferPool",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FCaptureBufferPoolBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace CaptureBufferPoolBenchmark;
+
+	const FResult Direct = Run(nullptr);
+
+	FCaptureBufferPool Pool;
+	const FResult	   Pooled = Run(&Pool);
+	const FCaptureBufferPool::FStats Stats = Pool.GetStats();
+
+	TestTrue(TEXT("Pool serves steady-state frames from idle planes"), Stats.Hits > Stats.Misses);
+
+	AddInfo(FString::Printf(TEXT("%d frames of %dx%d planes, %d in flight"), NumFrames, Width, Height, FramesInFlight));
+	AddInfo(FString::Printf(TEXT("Direct allocation: allocator %.2f ms (%.1f us/frame), RSS peak +%.1f MB, end +%.1f MB"),
+		Direct.AllocatorMs, Direct.AllocatorMs * 1000.0 / NumFrames, Direct.PeakRssDeltaMB, Direct.EndRssDeltaMB));
+	AddInfo(FString::Printf(TEXT("Pixel buffer pool: allocator %.2f ms (%.1f us/frame), RSS peak +%.1f MB, end +%.1f MB, %lld hits / %lld misses"),
+		Pooled.AllocatorMs, Pooled.AllocatorMs * 1000.0 / NumFrames, Pooled.PeakRssDeltaMB, Pooled.EndRssDeltaMB, Stats.Hits, Stats.Misses));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,59 @@
+#include "CameraCaptureSubsystem.h"
+#include "CaptureBufferPool.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCaptureBufferPoolTest, "CameraCapture.BufferPool.Accounting",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCaptureBufferPoolTest::RunTest(const FString& Parameters)
+{
+	using FCompletion = UCameraCaptureSubsystem::FReadbackCompletion;
+
+	constexpr int32 Width = 256;
+	constexpr int32 Height = 128;
+
+	TSharedRef<FCaptureBufferPool, ESPMode::ThreadSafe> Pool = MakeShared<FCaptureBufferPool, ESPMode::ThreadSafe>();
+	TArray<FColor>										 RgbSource;
+	RgbSource.Init(FColor::White, Width * Height);
+
+	auto MakeHarvestedCompletion = [&]() {
+		TSharedRef<FCompletion, ESPMode::ThreadSafe> Completion = MakeShared<FCompletion, ESPMode::ThreadSafe>();
+		Completion->BufferPool = Pool;
+		Completion->bHasRgb = true;
+		Completion->RgbReadback.Width = Width;
+		Completion->RgbReadback.Height = Height;
+		Completion->RgbReadback.MappedData = RgbSource.GetData();
+		Completion->RgbReadback.MappedRowPitch = Width;
+		Completion->Harvest();
+		return Completion;
+	};
+
+	// An emitted frame returns its planes when its last reference goes
+	{
+		TSharedRef<FCompletion, ESPMode::ThreadSafe> Completion = MakeHarvestedCompletion();
+		TestTrue(TEXT("Harvest takes a plane from the pool"), Pool->GetStats().OutstandingBytes > 0);
+
+		FCaptureData Data;
+		Data.ImageData = MoveTemp(Completion->ImageData);
+		TSharedRef<const FCaptureData> Frame = UCameraCaptureSubsystem::MakeSharedCaptureData(MoveTemp(Data), Pool);
+	}
+	TestEqual(TEXT("Emitted frame gave its plane back"), Pool->GetStats().OutstandingBytes, 0ll);
+	TestTrue(TEXT("Returned plane is kept for reuse"), Pool->GetStats().PooledBytes > 0);
+
+	// A capture dropped after its harvest (never emitted) returns them from the completion
+	{
+		TSharedRef<FCompletion, ESPMode::ThreadSafe> Completion = MakeHarvestedCompletion();
+		TestEqual(TEXT("Second harvest reuses the pooled plane"), Pool->GetStats().Hits, 1ll);
+	}
+	TestEqual(TEXT("Dropped capture gave its plane back"), Pool->GetStats().OutstandingBytes, 0ll);
+
+	// Planes beyond the idle budget are freed, not kept
+	Pool->SetMaxPooledBytes(0);
+	TestEqual(TEXT("Shrinking the budget trims idle planes"), Pool->GetStats().PooledBytes, 0ll);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
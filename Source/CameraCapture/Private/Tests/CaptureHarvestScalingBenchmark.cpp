@@ -0,0 +1,78 @@
+#include "CameraCaptureSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CaptureHarvestScalingBenchmark
+{
+	static constexpr int32 Width = 640;
+	static constexpr int32 Height = 480;
+	static constexpr int32 Repetitions = 5;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCaptureHarvestScalingBenchmark, "CameraCapture.Performance.HarvestScaling",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FCaptureHarvestScalingBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace CaptureHarvestScalingBenchmark;
+	using FCompletionRef = TSharedRef<UCameraCaptureSubsystem::FReadbackCompletion, ESPMode::ThreadSafe>;
+
+	// Every capture "maps" the same host memory, so only the copies are timed (no GPU needed)
+	TArray<FColor>		  RgbSource;
+	TArray<FLinearColor> DmvSource;
+	RgbSource.Init(FColor(10, 20, 30, 255), Width * Height);
+	DmvSource.Init(FLinearColor(100.0f, 0.5f, -0.5f, 1.0f), Width * Height);
+
+	// A copy task's wall time should fall with parallel copies as more cameras complete together
+	for (const int32 NumCaptures : { 1, 2, 4, 8, 16, 32 })
+	{
+		TArray<FCompletionRef> Completions;
+		for (int32 Index = 0; Index < NumCaptures; ++Index)
+		{
+			FCompletionRef Completion = MakeShared<UCameraCaptureSubsystem::FReadbackCompletion, ESPMode::ThreadSafe>();
+			Completion->bHasRgb = true;
+			Completion->RgbReadback.Width = Width;
+			Completion->RgbReadback.Height = Height;
+			Completion->RgbReadback.MappedData = RgbSource.GetData();
+			Completion->RgbReadback.MappedRowPitch = Width;
+			Completion->bHasDmv = true;
+			Completion->DmvReadback.Width = Width;
+			Completion->DmvReadback.Height = Height;
+			Completion->DmvReadback.bIsFloat = true;
+			Completion->DmvReadback.MappedData = DmvSource.GetData();
+			Completion->DmvReadback.MappedRowPitch = Width;
+			Completions.Add(Completion);
+		}
+
+		double WallMs[2] = { 0.0, 0.0 };
+		for (const bool bParallel : { false, true })
+		{
+			double Best = TNumericLimits<double>::Max();
+			for (int32 Repetition = 0; Repetition < Repetitions; ++Repetition)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				ParallelFor(
+					NumCaptures,
+					[&Completions](int32 Index) {
+						Completions[Index]->Harvest();
+					},
+					bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+				Best = FMath::Min(Best, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+			}
+			WallMs[bParallel] = Best;
+		}
+
+		const UCameraCaptureSubsystem::FReadbackCompletion& Last = *Completions.Last();
+		TestEqual(FString::Printf(TEXT("%d captures: RGB copied"), NumCaptures), Last.ImageData.Num(), Width * Height);
+		TestEqual(FString::Printf(TEXT("%d captures: depth split out"), NumCaptures), Last.DepthData.Num() > 0 ? Last.DepthData[0] : 0.0f, 100.0f);
+
+		AddInfo(FString::Printf(TEXT("%2d captures (%dx%d RGB + DMV): serial %.2f ms, parallel %.2f ms, speedup %.1fx"),
+			NumCaptures, Width, Height, WallMs[0], WallMs[1], WallMs[1] > 0.0 ? WallMs[0] / WallMs[1] : 0.0));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,87 @@
+#include "CaptureMemoryTracker.h"
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCaptureMemoryTrackerTest, "CameraCapture.MemoryTracker.Accounting",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCaptureMemoryTrackerTest::RunTest(const FString& Parameters)
+{
+	using FReservationPtr = FCaptureMemoryTracker::FReservationPtr;
+
+	TSharedRef<FCaptureMemoryTracker, ESPMode::ThreadSafe> Tracker = MakeShared<FCaptureMemoryTracker, ESPMode::ThreadSafe>();
+
+	// Unlimited: everything fits and is still counted
+	{
+		FReservationPtr Reservation = Tracker->TryReserve(1000);
+		TestTrue(TEXT("Unlimited budget admits any reservation"), Reservation.IsValid());
+		TestEqual(TEXT("Unlimited budget still counts reserved bytes"), Tracker->GetReservedBytes(), 1000ll);
+		TestTrue(TEXT("Unlimited budget fits anything"), Tracker->WouldFit(TNumericLimits<int64>::Max() / 2));
+	}
+	TestEqual(TEXT("Dropping the last reference releases the bytes"), Tracker->GetReservedBytes(), 0ll);
+
+	// Admission against the budget
+	Tracker->SetBudgetBytes(1000);
+	{
+		FReservationPtr First = Tracker->TryReserve(600);
+		TestTrue(TEXT("Reservation within the budget is admitted"), First.IsValid());
+		TestFalse(TEXT("Reservation past the budget is refused"), Tracker->TryReserve(500).IsValid());
+		TestEqual(TEXT("Refused reservation holds nothing"), Tracker->GetReservedBytes(), 600ll);
+		TestTrue(TEXT("Exactly filling the budget fits"), Tracker->WouldFit(400));
+		TestFalse(TEXT("One byte more does not"), Tracker->WouldFit(401));
+
+		// Shared by the frame and its encode copies: released only when both are gone
+		FReservationPtr Copy = First;
+		First.Reset();
+		TestEqual(TEXT("Reservation is kept while referenced"), Tracker->GetReservedBytes(), 600ll);
+	}
+	TestEqual(TEXT("Reservation is released with its last reference"), Tracker->GetReservedBytes(), 0ll);
+	TestEqual(TEXT("Negative sizes reserve nothing"), Tracker->TryReserve(-50)->GetBytes(), 0ll);
+
+	// Captures that must not be skipped go over and are counted
+	{
+		FReservationPtr Held = Tracker->TryReserve(800);
+		FReservationPtr Forced = Tracker->ForceReserve(500);
+		TestTrue(TEXT("Forced reservation is always granted"), Forced.IsValid());
+		TestEqual(TEXT("Forced reservation counts against the budget"), Tracker->GetReservedBytes(), 1300ll);
+		TestEqual(TEXT("Going over the budget is an overrun"), Tracker->GetBudgetOverruns(), 1ll);
+		TestEqual(TEXT("Peak includes the overrun"), Tracker->GetPeakReservedBytes(), 1300ll);
+
+		Forced.Reset();
+		Tracker->ForceReserve(100);
+		TestEqual(TEXT("Forced reservation within the budget is no overrun"), Tracker->GetBudgetOverruns(), 1ll);
+	}
+
+	Tracker->ResetPeaks();
+	TestEqual(TEXT("Reset restarts the peak from what is reserved now"), Tracker->GetPeakReservedBytes(), 0ll);
+	TestEqual(TEXT("Reset clears overruns"), Tracker->GetBudgetOverruns(), 0ll);
+
+	// Stage bytes are plain counters, independent of reservations
+	Tracker->AddStageBytes(ECaptureMemoryStage::Readback, 300);
+	Tracker->AddStageBytes(ECaptureMemoryStage::Readback, -300);
+	Tracker->AddStageBytes(ECaptureMemoryStage::AwaitingEmit, 300);
+	TestEqual(TEXT("Stage moves out of readback"), Tracker->GetStageBytes(ECaptureMemoryStage::Readback), 0ll);
+	TestEqual(TEXT("Stage moves into awaiting emit"), Tracker->GetStageBytes(ECaptureMemoryStage::AwaitingEmit), 300ll);
+	TestEqual(TEXT("Stage bytes don't reserve"), Tracker->GetReservedBytes(), 0ll);
+
+	// Concurrent admission never overshoots the budget
+	constexpr int32 NumReservations = 1000;
+	Tracker->SetBudgetBytes(100 * 64);
+	TArray<FReservationPtr> Reservations;
+	Reservations.SetNum(NumReservations);
+	ParallelFor(NumReservations, [&Tracker, &Reservations](int32 Index) {
+		Reservations[Index] = Tracker->TryReserve(64);
+	});
+	const int32 Admitted = Reservations.FilterByPredicate([](const FReservationPtr& Reservation) { return Reservation.IsValid(); }).Num();
+	TestEqual(TEXT("Concurrent reservations fill the budget exactly"), Admitted, 100);
+	TestEqual(TEXT("Concurrent reservations stay within the budget"), Tracker->GetPeakReservedBytes(), 100ll * 64);
+
+	Reservations.Empty();
+	TestEqual(TEXT("Every concurrent reservation was released"), Tracker->GetReservedBytes(), 0ll);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
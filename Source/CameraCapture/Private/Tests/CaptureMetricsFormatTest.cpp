@@ -0,0 +1,218 @@
+#include "CaptureMetricsExporter.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CaptureMetricsFormatTest
+{
+	struct FSample
+	{
+		FString Name;
+		FString CameraID; // Unescaped camera label (empty for session samples)
+		FString Le;		  // Histogram bucket bound (empty for other samples)
+		double	Value = 0.0;
+	};
+
+	/** Split one sample line into name, labels and value. Only the labels the exporter writes are accepted. */
+	static bool ParseSample(const FString& Line, FSample& Out)
+	{
+		int32 Index = 0;
+		while (Index < Line.Len() && (FChar::IsAlnum(Line[Index]) || Line[Index] == TEXT('_')))
+		{
+			++Index;
+		}
+		Out.Name = Line.Left(Index);
+
+		if (Index < Line.Len() && Line[Index] == TEXT('{'))
+		{
+			++Index;
+			while (Index < Line.Len() && Line[Index] != TEXT('}'))
+			{
+				const int32 EqualsIndex = Line.Find(TEXT("=\""), ESearchCase::CaseSensitive, ESearchDir::FromStart, Index);
+				if (EqualsIndex == INDEX_NONE)
+				{
+					return false;
+				}
+				const FString LabelName = Line.Mid(Index, EqualsIndex - Index);
+
+				FString Value;
+				for (Index = EqualsIndex + 2; Index < Line.Len() && Line[Index] != TEXT('"'); ++Index)
+				{
+					if (Line[Index] == TEXT('\\') && Index + 1 < Line.Len())
+					{
+						++Index;
+						Value.AppendChar(Line[Index] == TEXT('n') ? TEXT('\n') : Line[Index]);
+					}
+					else
+					{
+						Value.AppendChar(Line[Index]);
+					}
+				}
+				if (Index++ >= Line.Len())
+				{
+					return false;
+				}
+
+				if (LabelName == TEXT("camera"))
+				{
+					Out.CameraID = Value;
+				}
+				else if (LabelName == TEXT("le"))
+				{
+					Out.Le = Value;
+				}
+				else
+				{
+					return false;
+				}
+
+				if (Index < Line.Len() && Line[Index] == TEXT(','))
+				{
+					++Index;
+				}
+			}
+			if (Index++ >= Line.Len())
+			{
+				return false;
+			}
+		}
+
+		if (Index >= Line.Len() || Line[Index] != TEXT(' '))
+		{
+			return false;
+		}
+		return LexTryParseString(Out.Value, *Line.Mid(Index + 1));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCaptureMetricsFormatTest, "CameraCapture.Metrics.TextFormat",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCaptureMetricsFormatTest::RunTest(const FString& Parameters)
+{
+	using namespace CaptureMetricsFormatTest;
+
+	// A camera ID that needs every escape, plus one that needs UTF-8
+	const FString AwkwardID = TEXT("Robot \"A\"\\Head\nCamera");
+	const FString UnicodeID = TEXT("Kamera_\u00C4");
+
+	FCaptureMetricsExporter::FSnapshot Snapshot;
+	Snapshot.Stats.TotalFramesCaptured = 42;
+	Snapshot.Stats.AchievedCaptureRateHz = 29.5f;
+	Snapshot.Stats.PerCamera.AddDefaulted(2);
+	Snapshot.Stats.PerCamera[0].CameraID = AwkwardID;
+	Snapshot.Stats.PerCamera[0].FramesHarvested = 40;
+	Snapshot.Stats.PerCamera[1].CameraID = UnicodeID;
+	Snapshot.Stats.PerCamera[1].FramesHarvested = 2;
+
+	Snapshot.SessionCounters = MakeShared<FCapturePipelineCounters, ESPMode::ThreadSafe>();
+	for (const double LatencyMs : { 0.5, 3.0, 3.0, 40.0, 700.0, 60000.0 })
+	{
+		Snapshot.SessionCounters->KickToReady.Record(LatencyMs);
+	}
+	Snapshot.CameraCounters.Add(MakeShared<FCapturePipelineCounters, ESPMode::ThreadSafe>());
+	Snapshot.CameraCounters.Add(nullptr); // Camera went away: no histogram samples
+	Snapshot.CameraCounters[0]->HarvestToWritten.Record(12.0);
+
+	TAnsiStringBuilder<16 * 1024> Buffer;
+	FCaptureMetricsExporter::FormatMetrics(Snapshot, Buffer);
+
+	const FUTF8ToTCHAR Converted(Buffer.GetData(), Buffer.Len());
+	const FString	   Text(Converted.Length(), Converted.Get());
+	TestTrue(TEXT("Output ends with a newline"), Text.EndsWith(TEXT("\n")));
+
+	TArray<FString> Lines;
+	Text.ParseIntoArray(Lines, TEXT("\n"), false);
+	if (Lines.Num() > 0 && Lines.Last().IsEmpty())
+	{
+		Lines.Pop();
+	}
+
+	TSet<FString>		  Families;
+	FString				  FamilyName;
+	FString				  FamilyType;
+	TMap<FString, FSample> Samples; // Keyed by name and camera, last bucket wins
+	FString				  BucketSeries; // Name and camera of the buckets being read
+	double				  LastBucketCount = 0.0;
+
+	for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		const FString& Line = Lines[LineIndex];
+		if (Line.StartsWith(TEXT("# HELP ")))
+		{
+			// HELP is followed by the TYPE of the same family, and each family appears once
+			FString Name, Help;
+			TestTrue(TEXT("HELP has a name and text"), Line.Mid(7).Split(TEXT(" "), &Name, &Help) && !Help.IsEmpty());
+			if (!TestTrue(TEXT("HELP is followed by TYPE"), Lines.IsValidIndex(LineIndex + 1) && Lines[LineIndex + 1].StartsWith(TEXT("# TYPE ") + Name + TEXT(" "))))
+			{
+				return false;
+			}
+			TestFalse(FString::Printf(TEXT("%s is declared once"), *Name), Families.Contains(Name));
+			Families.Add(Name);
+
+			FamilyName = Name;
+			FamilyType = Lines[++LineIndex].Mid(8 + Name.Len());
+			TestTrue(FString::Printf(TEXT("%s has a known type"), *Name), FamilyType == TEXT("gauge") || FamilyType == TEXT("counter") || FamilyType == TEXT("histogram"));
+			continue;
+		}
+		TestFalse(TEXT("Only HELP and TYPE comments are written"), Line.StartsWith(TEXT("#")));
+
+		FSample Sample;
+		if (!TestTrue(FString::Printf(TEXT("Line %d parses: %s"), LineIndex + 1, *Line), ParseSample(Line, Sample)))
+		{
+			continue;
+		}
+
+		// Every sample belongs to the family declared directly above it
+		if (FamilyType == TEXT("histogram"))
+		{
+			TestTrue(FString::Printf(TEXT("%s belongs to %s"), *Sample.Name, *FamilyName),
+				Sample.Name == FamilyName + TEXT("_bucket") || Sample.Name == FamilyName + TEXT("_sum") || Sample.Name == FamilyName + TEXT("_count"));
+
+			if (Sample.Name.EndsWith(TEXT("_bucket")))
+			{
+				if (BucketSeries != Sample.Name + Sample.CameraID)
+				{
+					BucketSeries = Sample.Name + Sample.CameraID;
+					LastBucketCount = 0.0;
+				}
+				TestTrue(FString::Printf(TEXT("%s buckets are cumulative"), *FamilyName), Sample.Value >= LastBucketCount);
+				TestFalse(FString::Printf(TEXT("%s bucket has a bound"), *FamilyName), Sample.Le.IsEmpty());
+				LastBucketCount = Sample.Value;
+			}
+			else if (Sample.Name.EndsWith(TEXT("_count")))
+			{
+				const FSample* InfBucket = Samples.Find(FamilyName + TEXT("_bucket") + Sample.CameraID);
+				TestTrue(FString::Printf(TEXT("%s ends with a +Inf bucket"), *FamilyName), InfBucket && InfBucket->Le == TEXT("+Inf"));
+				TestEqual(FString::Printf(TEXT("%s +Inf bucket equals _count"), *FamilyName), InfBucket ? InfBucket->Value : -1.0, Sample.Value);
+			}
+		}
+		else
+		{
+			TestEqual(TEXT("Sample belongs to the family declared above it"), Sample.Name, FamilyName);
+		}
+
+		Samples.Add(Sample.Name + Sample.CameraID, Sample);
+	}
+
+	// Values and labels survive the round trip
+	const FSample* Captured = Samples.Find(TEXT("camera_capture_frames_captured_total"));
+	TestEqual(TEXT("Session counter value"), Captured ? Captured->Value : -1.0, 42.0);
+	const FSample* Rate = Samples.Find(TEXT("camera_capture_rate_hertz"));
+	TestEqual(TEXT("Session gauge value"), Rate ? Rate->Value : -1.0, 29.5);
+
+	const FSample* Awkward = Samples.Find(FString(TEXT("camera_capture_camera_frames_captured_total")) + AwkwardID);
+	TestEqual(TEXT("Escaped camera label round-trips"), Awkward ? Awkward->Value : -1.0, 40.0);
+	const FSample* Unicode = Samples.Find(FString(TEXT("camera_capture_camera_frames_captured_total")) + UnicodeID);
+	TestEqual(TEXT("UTF-8 camera label round-trips"), Unicode ? Unicode->Value : -1.0, 2.0);
+
+	const FSample* SessionCount = Samples.Find(TEXT("camera_capture_kick_to_ready_seconds_count"));
+	TestEqual(TEXT("Session histogram counts every sample"), SessionCount ? SessionCount->Value : -1.0, 6.0);
+	const FSample* CameraCount = Samples.Find(FString(TEXT("camera_capture_camera_harvest_to_written_seconds_count")) + AwkwardID);
+	TestEqual(TEXT("Camera histogram counts its sample"), CameraCount ? CameraCount->Value : -1.0, 1.0);
+	TestFalse(TEXT("Cameras without counters have no histogram"), Samples.Contains(FString(TEXT("camera_capture_camera_harvest_to_written_seconds_count")) + UnicodeID));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,78 @@
+#include "CameraCaptureTestWorld.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CaptureReadbackLatencyBenchmark
+{
+	static constexpr int32 NumCameras = 8;
+	static constexpr int32 TicksPerMode = 120;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCaptureReadbackLatencyBenchmark, "CameraCapture.Performance.ReadbackLatency",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FCaptureReadbackLatencyBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace CaptureReadbackLatencyBenchmark;
+
+	// Readbacks only complete on a real RHI
+	if (!FApp::CanEverRender())
+	{
+		AddInfo(TEXT("Skipped: needs a rendering RHI (run without -nullrhi)"));
+		return true;
+	}
+
+	TSharedRef<FCameraCaptureTestWorld> TestWorld = MakeShared<FCameraCaptureTestWorld>();
+	UCameraCaptureSubsystem*			Subsystem = TestWorld->GetSubsystem();
+	if (!TestNotNull(TEXT("Capture subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	for (UIntrinsicSceneCaptureComponent2D* Camera : TestWorld->CreateCameras(NumCameras))
+	{
+		Camera->RegisterComponent();
+		Subsystem->RegisterCamera(Camera);
+	}
+	Subsystem->SetSerializationEnabled(false);
+	Subsystem->PrewarmCapture();
+	Subsystem->StartCapture();
+
+	// Game-thread polling (the behavior before render-thread completion) first, then the watcher.
+	// The subsystem ticks once per editor frame, so the render thread ends frames in between.
+	for (const bool bRenderThreadHarvest : { false, true })
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Subsystem, bRenderThreadHarvest]() {
+			Subsystem->SetRenderThreadHarvest(bRenderThreadHarvest);
+			Subsystem->ResetStatistics();
+			return true;
+		}));
+
+		TSharedRef<int32> TicksLeft = MakeShared<int32>(TicksPerMode);
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Subsystem, TicksLeft]() {
+			Subsystem->Tick(FApp::GetDeltaTime());
+			return --*TicksLeft <= 0;
+		}));
+
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Subsystem, bRenderThreadHarvest]() {
+			const FCaptureStatistics Stats = Subsystem->GetStatistics();
+			AddInfo(FString::Printf(TEXT("%-20s kick to pixels %.2f ms, pixels to broadcast %.2f ms, harvest task %.3f ms (%lld frames)"),
+				bRenderThreadHarvest ? TEXT("Render-thread watch:") : TEXT("Game-thread poll:"),
+				Stats.AverageReadbackLatencyMs, Stats.AverageEmitDelayMs, Stats.AverageHarvestWallMs, Stats.TotalFramesCaptured));
+			TestTrue(TEXT("Frames were captured"), Stats.TotalFramesCaptured > 0);
+			return true;
+		}));
+	}
+
+	// Keeps the world alive until the last measurement
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([TestWorld, Subsystem]() {
+		Subsystem->StopCapture();
+		return true;
+	}));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
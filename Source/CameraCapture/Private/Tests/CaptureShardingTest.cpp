@@ -0,0 +1,92 @@
+#include "CameraCaptureSubsystem.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CaptureShardingTest
+{
+	static const TCHAR* CameraIDs[] = { TEXT("CamA"), TEXT("CamB"), TEXT("CamC") };
+	static constexpr int32 NumFrames = 6;
+
+	/** Write the frame files of the synthetic session, plus one manifest per shard.
+	 *  Cameras are partitioned round-robin, and shards are written last-to-first so
+	 *  the merge cannot rely on file order. */
+	static void WriteSession(const FString& Directory, int32 ShardCount)
+	{
+		TArray<TArray<TSharedPtr<FJsonValue>>> ShardFrames;
+		ShardFrames.SetNum(ShardCount);
+
+		for (int32 CameraIndex = 0; CameraIndex < UE_ARRAY_COUNT(CameraIDs); ++CameraIndex)
+		{
+			for (int32 FrameNumber = 0; FrameNumber < NumFrames; ++FrameNumber)
+			{
+				const FString FrameName = FString::Printf(TEXT("%s/frame_%07d"), CameraIDs[CameraIndex], FrameNumber);
+				FFileHelper::SaveStringToFile(FString::Printf(TEXT("{\"frame_number\":%d}"), FrameNumber), *(Directory / FrameName + TEXT(".json")));
+				FFileHelper::SaveStringToFile(FString::Printf(TEXT("exr %s %d"), CameraIDs[CameraIndex], FrameNumber), *(Directory / FrameName + TEXT(".exr")));
+
+				TSharedPtr<FJsonObject> FrameJson = MakeShared<FJsonObject>();
+				FrameJson->SetStringField(TEXT("camera_id"), CameraIDs[CameraIndex]);
+				FrameJson->SetNumberField(TEXT("frame_number"), FrameNumber);
+				FrameJson->SetNumberField(TEXT("timestamp"), FrameNumber / 30.0);
+				FrameJson->SetStringField(TEXT("metadata"), FrameName + TEXT(".json"));
+				FrameJson->SetStringField(TEXT("exr"), FrameName + TEXT(".exr"));
+				ShardFrames[CameraIndex % ShardCount].Add(MakeShared<FJsonValueObject>(FrameJson));
+			}
+		}
+
+		for (int32 ShardIndex = ShardCount - 1; ShardIndex >= 0; --ShardIndex)
+		{
+			TSharedPtr<FJsonObject> ManifestJson = MakeShared<FJsonObject>();
+			ManifestJson->SetNumberField(TEXT("shard_index"), ShardIndex);
+			ManifestJson->SetNumberField(TEXT("shard_count"), ShardCount);
+			ManifestJson->SetStringField(TEXT("shard_mode"), TEXT("cameras"));
+			ManifestJson->SetStringField(TEXT("level_name"), TEXT("TestLevel"));
+			ManifestJson->SetArrayField(TEXT("frames"), ShardFrames[ShardIndex]);
+
+			FString					  OutputString;
+			TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+			FJsonSerializer::Serialize(ManifestJson.ToSharedRef(), Writer);
+			FFileHelper::SaveStringToFile(OutputString, *(Directory / FString::Printf(TEXT("shard_%d_of_%d.json"), ShardIndex, ShardCount)));
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraCaptureShardMergeTest, "CameraCapture.Sharding.MergeAndCompare",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCameraCaptureShardMergeTest::RunTest(const FString& Parameters)
+{
+	using namespace CaptureShardingTest;
+
+	const FString Root = FPaths::AutomationTransientDir() / TEXT("CameraCaptureSharding") / FGuid::NewGuid().ToString();
+	const FString SingleDirectory = Root / TEXT("Single");
+	const FString ShardedDirectory = Root / TEXT("Sharded");
+
+	WriteSession(SingleDirectory, 1);
+	WriteSession(ShardedDirectory, 3);
+
+	TestTrue(TEXT("Single-process session merges"), UCameraCaptureSubsystem::MergeShardManifests(SingleDirectory));
+	TestTrue(TEXT("Three-process session merges"), UCameraCaptureSubsystem::MergeShardManifests(ShardedDirectory));
+	TestTrue(TEXT("Sharded and single-process outputs are identical"), UCameraCaptureSubsystem::CompareSessionOutputs(SingleDirectory, ShardedDirectory));
+
+	// A differing frame must be reported
+	FFileHelper::SaveStringToFile(FString(TEXT("corrupt")), *(ShardedDirectory / TEXT("CamB/frame_0000003.exr")));
+	AddExpectedError(TEXT("Compare:"), EAutomationExpectedErrorFlags::Contains, 0);
+	TestFalse(TEXT("A differing EXR fails the comparison"), UCameraCaptureSubsystem::CompareSessionOutputs(SingleDirectory, ShardedDirectory));
+
+	// So must a missing shard
+	IFileManager::Get().Delete(*(ShardedDirectory / TEXT("shard_1_of_3.json")));
+	AddExpectedError(TEXT("shard manifests missing"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Merge fails when a shard manifest is missing"), UCameraCaptureSubsystem::MergeShardManifests(ShardedDirectory));
+
+	IFileManager::Get().DeleteDirectory(*Root, false, true);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -55,7 +55,8 @@ namespace CameraCaptureUtils
 		const TArray<FLinearColor>&	 DmvData,
 		int32						 Width,
 		int32						 Height,
-		bool						 bIncludeDepth)
+		bool						 bIncludeDepth,
+		TFunction<void(bool)>		 OnCompleted)
 	{
 		IImageWriteQueueModule* ImageWriteQueueModule = FModuleManager::Get().GetModulePtr<IImageWriteQueueModule>("ImageWriteQueue");
 		if (!ImageWriteQueueModule)
@@ -111,7 +112,13 @@ namespace CameraCaptureUtils
 		ImageTask->CompressionQuality = (int32)EImageCompressionQuality::Default;
 		ImageTask->bOverwriteFile = true;
 
+		// FImageWriteTask::OnCompleted is dispatched to the game thread; the future is fulfilled
+		// on the writer thread right after the write, so completion work stays off the game thread
 		TFuture<bool> CompletionFuture = ImageWriteQueueModule->GetWriteQueue().Enqueue(MoveTemp(ImageTask));
+		if (OnCompleted)
+		{
+			CompletionFuture.Next(MoveTemp(OnCompleted));
+		}
 
 		return true;
 	}
@@ -2,10 +2,14 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "CaptureTrajectory.h"
+#include "CameraCaptureSubsystem.h"
 #include "CameraCaptureManager.generated.h"
 
 class UIntrinsicSceneCaptureComponent2D;
 class UCameraCaptureSubsystem;
+class USkeletalMeshComponent;
+class UPrimitiveComponent;
 
 /**
  * Camera registration mode for determining which cameras to capture
@@ -20,6 +24,25 @@ enum class ECameraRegistrationMode : uint8
 	Manual UMETA(DisplayName = "Manual Selection")
 };
 
+/**
+ * What a capture session produces
+ */
+UENUM(BlueprintType)
+enum class ECaptureDriveMode : uint8
+{
+	/** Render and read back the registered cameras while the simulation runs */
+	Live UMETA(DisplayName = "Live Capture"),
+
+	/** Record camera and moving-actor poses only (no rendering) to TrajectoryFile */
+	RecordPoses UMETA(DisplayName = "Record Poses"),
+
+	/** Re-render the poses stored in TrajectoryFile, one recorded frame per tick */
+	ReplayTrajectory UMETA(DisplayName = "Replay Trajectory"),
+
+	/** Capture every pose listed in PoseListFile (CSV or JSON), pipelined */
+	PoseList UMETA(DisplayName = "Pose List")
+};
+
 /**
  * Manager actor for centralized camera capture control
  * Place one of these in your level to configure and control multi-camera capture
@@ -44,10 +67,155 @@ public:
 	// Capture Configuration
 	// ============================================================================
 
-	/** How often to capture (1 = every frame, 2 = every other frame, etc.) */
+	/** How often to capture (1 = every frame, 2 = every other frame, etc.).
+	 *  Cameras with their own CaptureRateHz / CaptureEveryNFrames override this. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = "1", DisplayName = "Capture Every N Frames"))
 	int32 CaptureEveryNFrames = 1;
 
+	/** Pending GPU readbacks allowed per camera before lower-priority cameras are throttled */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Throttling", meta = (ClampMin = "1", DisplayName = "Max In-Flight Frames Per Camera"))
+	int32 MaxInFlightFramesPerCamera = 3;
+
+	/** Frames allowed to wait on the serializer before lower-priority cameras are throttled */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Throttling", meta = (ClampMin = "1", DisplayName = "Max Serialization Backlog"))
+	int32 MaxSerializationBacklog = 64;
+
+	/** Automatically lower the capture rate of lower-priority cameras to hold TargetFrameTimeMs */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Throttling", meta = (DisplayName = "Enable GPU Governor"))
+	bool bEnableGpuGovernor = false;
+
+	/** Frame time the GPU governor tries to hold (milliseconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Throttling", meta = (ClampMin = "1.0", Units = "ms", EditCondition = "bEnableGpuGovernor", DisplayName = "Target Frame Time"))
+	float TargetFrameTimeMs = 33.3f;
+
+	/** Deterministic "as fast as possible" capture: the simulation advances on a fixed
+	 *  timestep without frame pacing, every step is captured and timestamps are simulation time */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Offline", meta = (DisplayName = "Offline Fixed Step Mode"))
+	bool bOfflineFixedStep = false;
+
+	/** Simulation time advanced per step in offline mode (seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Offline", meta = (ClampMin = "0.0001", Units = "s", EditCondition = "bOfflineFixedStep", DisplayName = "Fixed Time Step"))
+	float FixedTimeStepSeconds = 1.0f / 30.0f;
+
+	/** Frames allowed in flight (readback + serialization) before a step (or pose) waits */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Offline", meta = (ClampMin = "1", EditCondition = "bOfflineFixedStep || CaptureMode == ECaptureDriveMode::PoseList", DisplayName = "Max Queued Frames"))
+	int32 MaxQueuedFrames = 16;
+
+	/** Seed for FMath::Rand / FMath::FRand at capture start (for reproducible runs) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Offline", meta = (EditCondition = "bOfflineFixedStep", DisplayName = "Random Seed"))
+	int32 RandomSeed = 0;
+
+	/** Live capture, pose-only recording, or offline re-render of a recorded trajectory */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Trajectory", meta = (DisplayName = "Capture Mode"))
+	ECaptureDriveMode CaptureMode = ECaptureDriveMode::Live;
+
+	/** Trajectory file written in Record Poses mode and read in Replay Trajectory mode
+	 *  (empty = <Output Directory>/trajectory.cctraj) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Trajectory", meta = (EditCondition = "CaptureMode != ECaptureDriveMode::Live", DisplayName = "Trajectory File"))
+	FString TrajectoryFile;
+
+	/** CSV or JSON list of poses (and optional intrinsics) captured in Pose List mode */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Trajectory", meta = (EditCondition = "CaptureMode == ECaptureDriveMode::PoseList", DisplayName = "Pose List File"))
+	FString PoseListFile;
+
+	/** Actor teleported by pose list entries that do not name a camera; every registered camera is captured */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Trajectory", meta = (EditCondition = "CaptureMode == ECaptureDriveMode::PoseList", DisplayName = "Pose List Rig"))
+	AActor* PoseListRig = nullptr;
+
+	/** Poses kicked per tick in Pose List mode (captures of one tick are pipelined on the GPU) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Trajectory", meta = (ClampMin = "1", EditCondition = "CaptureMode == ECaptureDriveMode::PoseList", DisplayName = "Poses Per Tick"))
+	int32 PosesPerTick = 1;
+
+	/** Game-thread time per tick spent creating render targets / DMV cameras for newly registered cameras */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = "0.0", Units = "ms", DisplayName = "Resource Setup Budget"))
+	float ResourceSetupBudgetMs = 2.0f;
+
+	/** Share render targets between cameras of the same resolution instead of giving each
+	 *  camera its own. Each capture borrows a pooled target and returns it once its readback
+	 *  is enqueued, so GPU memory scales with the number of distinct resolutions. Cameras
+	 *  with a TextureTarget of their own keep it and are not pooled. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (DisplayName = "Pool Render Targets"))
+	bool bPoolRenderTargets = false;
+
+	/** Reuse the pixel arrays of released frames for new frames instead of allocating them */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (DisplayName = "Pool Pixel Buffers"))
+	bool bPoolPixelBuffers = true;
+
+	/** Most idle pixel-buffer memory the pool keeps (MB) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = "0", EditCondition = "bPoolPixelBuffers", DisplayName = "Max Pooled Pixel Buffers (MB)"))
+	int32 MaxPooledPixelBufferMB = 512;
+
+	/** Most CPU memory captures in flight may hold, from kick until written (MB, 0 = unlimited) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = "0", DisplayName = "Memory Budget (MB)"))
+	int32 MemoryBudgetMB = 0;
+
+	/** What a capture that would exceed the memory budget does */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (DisplayName = "Memory Overflow Policy"))
+	ECaptureMemoryOverflowPolicy MemoryOverflowPolicy = ECaptureMemoryOverflowPolicy::SkipKick;
+
+	/** Wall-clock time a capture may wait for its GPU readback before it is dropped (milliseconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = "1.0", Units = "ms", DisplayName = "Readback Timeout"))
+	float ReadbackTimeoutMs = 500.0f;
+
+	/** Block when capture stops until the final frames have been read back, so they are not lost */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (DisplayName = "Wait For Readbacks On Stop"))
+	bool bWaitForReadbacksOnStop = false;
+
+	/** Detect finished readbacks on the render thread and copy their pixels on a worker thread,
+	 *  instead of polling them once per game tick */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (DisplayName = "Harvest On Render Thread"))
+	bool bHarvestOnRenderThread = true;
+
+	/** Copy the pixels of captures that complete together on worker threads in parallel */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (DisplayName = "Parallel Harvest"))
+	bool bParallelHarvest = true;
+
+	/** Also broadcast the metadata-only records of cameras skipped by Skip Unchanged Frames
+	 *  (FCaptureData::bUnchanged, no pixels) to OnFrameCaptured listeners */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (DisplayName = "Broadcast Unchanged Frames"))
+	bool bBroadcastUnchangedFrames = false;
+
+	/** Group every camera's data for a frame into one FCaptureFrameSet (OnFrameSetCaptured) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Frame Sets", meta = (DisplayName = "Assemble Frame Sets"))
+	bool bAssembleFrameSets = false;
+
+	/** Whether frame sets missing cameras are emitted or only complete sets */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Frame Sets", meta = (EditCondition = "bAssembleFrameSets", DisplayName = "Frame Set Policy"))
+	ECaptureFrameSetPolicy FrameSetPolicy = ECaptureFrameSetPolicy::EmitPartial;
+
+	/** Frame sets not resolved this long after their first kick are finalized (milliseconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Frame Sets", meta = (ClampMin = "1.0", Units = "ms", EditCondition = "bAssembleFrameSets", DisplayName = "Frame Set Timeout"))
+	float FrameSetTimeoutMs = 1000.0f;
+
+	/** Write each frame set in a single serializer job */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Frame Sets", meta = (EditCondition = "bAssembleFrameSets", DisplayName = "Batch Frame Set Serialization"))
+	bool bBatchFrameSetSerialization = false;
+
+	/** Periodically write capture telemetry to a Prometheus text file (node-exporter textfile collector) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Metrics", meta = (DisplayName = "Export Metrics"))
+	bool bExportMetrics = false;
+
+	/** Metrics file (empty: <Saved>/Metrics/camera_capture.prom) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Metrics", meta = (EditCondition = "bExportMetrics", DisplayName = "Metrics File"))
+	FString MetricsFilePath;
+
+	/** Time between metrics exports (seconds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Metrics", meta = (ClampMin = "0.1", Units = "s", EditCondition = "bExportMetrics", DisplayName = "Metrics Interval"))
+	float MetricsExportIntervalSeconds = 15.0f;
+
+	/** Record every pipeline stage per camera and frame, written as a Chrome trace (Perfetto) when capture stops */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Metrics", meta = (DisplayName = "Record Timeline"))
+	bool bRecordTimeline = false;
+
+	/** Trace file (empty: <Output Directory>/capture_timeline.json) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Metrics", meta = (EditCondition = "bRecordTimeline", DisplayName = "Timeline File"))
+	FString TimelineFilePath;
+
+	/** Finish all resource creation and shader warm-up before capture starts, so the first
+	 *  frame has steady-state latency (blocks the game thread once) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (DisplayName = "Prewarm Before Capture"))
+	bool bPrewarmBeforeCapture = true;
+
 	/** Automatically configure cameras on BeginPlay (registers cameras based on mode) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (DisplayName = "Auto Configure Cameras On Begin Play"))
 	bool bAutoConfigureCamerasOnBeginPlay = true;
@@ -84,6 +252,15 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cameras", meta = (EditCondition = "RegistrationMode == ECameraRegistrationMode::Manual", DisplayName = "Cameras To Capture"))
 	TArray<UIntrinsicSceneCaptureComponent2D*> CamerasToCapture;
 
+	/** Keep registering cameras that appear after BeginPlay (spawned actors, streamed-in levels)
+	 *  and unregistering those that go away (only used in All In Level mode) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cameras", meta = (EditCondition = "RegistrationMode == ECameraRegistrationMode::AllInLevel", DisplayName = "Discover Cameras At Runtime"))
+	bool bDiscoverCamerasAtRuntime = false;
+
+	/** Cameras registered per tick when many appear at once, so a level-streaming burst is spread over several frames */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cameras", meta = (ClampMin = "1", EditCondition = "RegistrationMode == ECameraRegistrationMode::AllInLevel && bDiscoverCamerasAtRuntime", DisplayName = "Max Camera Registrations Per Tick"))
+	int32 MaxCameraRegistrationsPerTick = 8;
+
 	// ============================================================================
 	// Runtime Control (Blueprint API)
 	// ============================================================================
@@ -120,10 +297,29 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Camera Capture", meta = (DisplayName = "Is Serialization Enabled"))
 	bool IsSerializationEnabled() const;
 
+	/** Load TrajectoryFile and start re-rendering it (one recorded frame per tick).
+	 *  Cameras are matched by unique ID and must be registered; moving actors are
+	 *  matched by path. Returns false if the trajectory could not be loaded. */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture", meta = (DisplayName = "Start Trajectory Replay"))
+	bool StartReplay();
+
+	/** Stop an in-progress trajectory replay */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture", meta = (DisplayName = "Stop Trajectory Replay"))
+	void StopReplay();
+
+	/** Load PoseListFile and start capturing its poses. Returns false if it could not be loaded. */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture", meta = (DisplayName = "Start Pose List"))
+	bool StartPoseList();
+
+	/** Check if a trajectory replay is in progress */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture", meta = (DisplayName = "Is Replaying"))
+	bool IsReplaying() const { return bReplaying; }
+
 protected:
 	// AActor interface
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Tick(float DeltaSeconds) override;
 
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
@@ -151,4 +347,100 @@ private:
 
 	/** Has this manager been initialized */
 	bool bInitialized = false;
+
+	/** Enable ticking while a replay, pose list or registration batch needs it */
+	void UpdateTickEnabled();
+
+	// ============================================================================
+	// Runtime Discovery
+	// ============================================================================
+
+	/** Start / stop listening for camera components registering with the world */
+	void StartCameraDiscovery();
+	void StopCameraDiscovery();
+
+	/** Whether a camera belongs to this manager's world and should be captured */
+	bool ShouldDiscoverCamera(const UIntrinsicSceneCaptureComponent2D* Camera) const;
+
+	/** Queue a newly registered camera for registration with the subsystem (or keep the
+	 *  existing registration if the component was only being re-registered) */
+	void OnCameraComponentRegistered(UIntrinsicSceneCaptureComponent2D* Camera);
+
+	/** Queue a camera that left the world for unregistering on the next tick */
+	void OnCameraComponentUnregistered(UIntrinsicSceneCaptureComponent2D* Camera);
+
+	/** Unregister cameras that stayed unregistered, then register up to
+	 *  MaxCameraRegistrationsPerTick queued cameras */
+	void ProcessPendingRegistrations();
+
+	/** Cameras waiting to be registered, in discovery order (entries not in the set were cancelled) */
+	TArray<TWeakObjectPtr<UIntrinsicSceneCaptureComponent2D>> PendingRegistrations;
+	TSet<TWeakObjectPtr<UIntrinsicSceneCaptureComponent2D>>	  PendingRegistrationSet;
+
+	/** Registered cameras whose component was unregistered this frame. ReregisterComponent
+	 *  unregisters and registers again in the same call, so the unregister is deferred to
+	 *  keep the camera's schedule, counters and DMV camera across it. */
+	TSet<TWeakObjectPtr<UIntrinsicSceneCaptureComponent2D>> PendingUnregistrations;
+
+	FDelegateHandle CameraRegisteredHandle;
+	FDelegateHandle CameraUnregisteredHandle;
+
+	/** Resolve TrajectoryFile against the output directory */
+	FString GetTrajectoryFilePath() const;
+
+	/** Apply the next recorded frame and capture it */
+	void ReplayNextFrame();
+
+	/** Apply a recorded frame's actor, bone and camera poses; OutCameras receives the cameras it captured */
+	void ApplyReplayFrame(const FCaptureTrajectoryFrame& Frame, TArray<UIntrinsicSceneCaptureComponent2D*>& OutCameras);
+
+	/** Disable the tick, component ticks and physics of a replayed actor (and its AI controller) */
+	void FreezeReplayedActor(AActor* Actor);
+
+	/** Restore everything FreezeReplayedActor disabled */
+	void UnfreezeReplayedActors();
+
+	/** Trajectory being replayed */
+	FCaptureTrajectory ReplayTrajectory;
+
+	/** Cameras / actors resolved for each trajectory index (null if not found) */
+	TArray<TWeakObjectPtr<UIntrinsicSceneCaptureComponent2D>> ReplayCameras;
+	TArray<TWeakObjectPtr<AActor>>							  ReplayActors;
+	TArray<TWeakObjectPtr<USkeletalMeshComponent>>			  ReplaySkeletalMeshes;
+
+	/** Actors frozen for the replay, and the ticks / physics simulation to re-enable when it stops */
+	TSet<TWeakObjectPtr<AActor>>				 FrozenReplayActors;
+	TArray<TWeakObjectPtr<AActor>>				 FrozenTickActors;
+	TArray<TWeakObjectPtr<UActorComponent>>		 FrozenTickComponents;
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> FrozenPhysicsComponents;
+
+	/** Next trajectory frame to replay, and the end of this process's range */
+	int32 ReplayFrameIndex = 0;
+	int32 ReplayEndIndex = 0;
+
+	/** Is a trajectory replay in progress */
+	bool bReplaying = false;
+
+	/** Kick the next PosesPerTick poses of the pose list */
+	void CaptureNextPoses();
+
+	/** Stop the pose list, waiting for its captures to be written */
+	void FinishPoseList();
+
+	/** Move the rig or camera to a pose (and apply its intrinsics); OutCameras receives the cameras to capture */
+	bool ApplyPose(int32 PoseIndex, TArray<UIntrinsicSceneCaptureComponent2D*>& OutCameras);
+
+	/** Pose list being captured */
+	FCapturePoseList PoseList;
+
+	/** This process's range of the pose list, and the next entry to capture */
+	int32 PoseListBeginIndex = 0;
+	int32 PoseListIndex = 0;
+	int32 PoseListEndIndex = 0;
+
+	/** Is a pose list in progress */
+	bool bRunningPoseList = false;
+
+	/** Wall time the pose list started (for the throughput log) */
+	double PoseListStartTime = 0.0;
 };
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CameraCaptureMergeCommandlet.generated.h"
+
+/**
+ * Merges the shard manifests of a multi-process capture session into a single
+ * session_index.json, and optionally checks it against another run of the session.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=CameraCaptureMerge [-OutputDir=<Dir>] [-CompareDir=<Dir>]
+ * (OutputDir defaults to Saved/CameraCaptures). With CompareDir, both directories are
+ * merged and must contain byte-identical frames (see CompareSessionOutputs); the exit
+ * code is 0 on success, 1 if a merge failed and 2 if the outputs differ.
+ */
+UCLASS()
+class CAMERACAPTURE_API UCameraCaptureMergeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCameraCaptureMergeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -3,12 +3,21 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "CameraIntrinsics.h"
+#include "IntrinsicSceneCaptureComponent2D.h"
+#include "CaptureTrajectory.h"
+#include "CaptureBufferPool.h"
+#include "CaptureLatencyHistogram.h"
+#include "CaptureMemoryTracker.h"
 #include "RHIGPUReadback.h"
 #include "Async/Async.h"
+#include "Containers/Deque.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "RHIResources.h"
+#include "UObject/ObjectKey.h"
+#include <atomic>
 #include "CameraCaptureSubsystem.generated.h"
 
-class UIntrinsicSceneCaptureComponent2D;
-
 /**
  * Fired on the game thread after a frame has been harvested.
  * The payload is wrapped in a TSharedRef so listeners may safely hold a copy
@@ -16,6 +25,49 @@ class UIntrinsicSceneCaptureComponent2D;
  */
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnFrameCaptured, TSharedRef<const FCaptureData> /*Data*/);
 
+/**
+ * How work is partitioned across capture processes
+ */
+UENUM(BlueprintType)
+enum class ECaptureShardMode : uint8
+{
+	/** Each process captures the cameras whose UniqueID hashes to its shard */
+	Cameras UMETA(DisplayName = "Cameras"),
+
+	/** Each process captures a contiguous block of a replayed trajectory / pose list */
+	TimeRange UMETA(DisplayName = "Time Range")
+};
+
+/**
+ * What to do with a frame set that is missing cameras (dropped readback or timeout)
+ */
+UENUM(BlueprintType)
+enum class ECaptureFrameSetPolicy : uint8
+{
+	/** Emit the views that did arrive */
+	EmitPartial UMETA(DisplayName = "Emit Partial"),
+
+	/** Only emit sets holding every kicked camera (views that arrived are still serialized) */
+	RequireComplete UMETA(DisplayName = "Require Complete")
+};
+
+/**
+ * What a capture does when its memory would not fit the capture memory budget
+ */
+UENUM(BlueprintType)
+enum class ECaptureMemoryOverflowPolicy : uint8
+{
+	/** Skip the camera this tick (counted as over budget) */
+	SkipKick UMETA(DisplayName = "Skip Kick"),
+
+	/** Drop the oldest captures still waiting on readback to make room, then skip if that is not enough */
+	DropOldest UMETA(DisplayName = "Drop Oldest"),
+
+	/** Block the game thread until readbacks are harvested and the writer has flushed frames to
+	 *  disk. Nothing is spilled early: frames held by listeners are simply waited out. */
+	Block UMETA(DisplayName = "Block")
+};
+
 /**
  * Unique identifier for a camera component within the capture system
  */
@@ -66,6 +118,37 @@ struct CAMERACAPTURE_API FCameraIdentifier
 	}
 };
 
+/**
+ * Metadata of a camera that does not change from frame to frame. Built once per
+ * camera (and again only if its projection changes) and shared by every capture.
+ */
+struct CAMERACAPTURE_API FCaptureCameraInfo
+{
+	/** Camera identity */
+	FCameraIdentifier CameraID;
+
+	/** CameraID.UniqueID as an FName, interned once per camera for trace spans and the timeline */
+	FName TraceName;
+
+	/** Actor path in world */
+	FString ActorPath;
+
+	/** Level name */
+	FString LevelName;
+
+	/** Camera intrinsics used for captures */
+	FCameraIntrinsics Intrinsics;
+
+	/** Whether custom projection matrix was used */
+	bool bUsedCustomProjectionMatrix = false;
+
+	/** Projection matrix used (if custom) */
+	FMatrix ProjectionMatrix = FMatrix::Identity;
+
+	/** UIntrinsicSceneCaptureComponent2D::GetProjectionHash() this info was built from */
+	uint32 ProjectionHash = 0;
+};
+
 /**
  * Data captured from a single camera in a single frame
  */
@@ -74,9 +157,15 @@ struct CAMERACAPTURE_API FCaptureData
 {
 	GENERATED_BODY()
 
-	/** Camera identity */
-	UPROPERTY(BlueprintReadOnly, Category = "Capture Data")
-	FCameraIdentifier CameraID;
+	/** Static camera metadata (identity, intrinsics, actor path, level), shared across frames.
+	 *  Blueprints read it through UCaptureDataLibrary. */
+	TSharedPtr<const FCaptureCameraInfo, ESPMode::ThreadSafe> CameraInfo;
+
+	/** The capture's share of the memory budget, held until its pixels and encode copies are freed */
+	FCaptureMemoryTracker::FReservationPtr MemoryReservation;
+
+	/** CameraInfo, or an empty info if it was never set */
+	const FCaptureCameraInfo& GetCameraInfo() const;
 
 	/** Frame number in capture session */
 	UPROPERTY(BlueprintReadOnly, Category = "Capture Data")
@@ -86,24 +175,23 @@ struct CAMERACAPTURE_API FCaptureData
 	UPROPERTY(BlueprintReadOnly, Category = "Capture Data")
 	double Timestamp = 0.0;
 
-	/** World transform of the camera */
+	/** True if the camera was skipped because nothing it sees changed. The record
+	 *  then carries metadata only; the pixels are those of ReferenceFrameNumber.
+	 *  OnFrameCaptured only receives such records after SetBroadcastUnchangedFrames(true). */
 	UPROPERTY(BlueprintReadOnly, Category = "Capture Data")
-	FTransform WorldTransform;
+	bool bUnchanged = false;
 
-	/** Transform relative to the owning actor's root */
+	/** Frame whose pixels this record refers to (only meaningful when bUnchanged) */
 	UPROPERTY(BlueprintReadOnly, Category = "Capture Data")
-	FTransform RelativeTransform;
+	int64 ReferenceFrameNumber = -1;
 
-	/** Camera intrinsics used for this capture */
+	/** World transform of the camera */
 	UPROPERTY(BlueprintReadOnly, Category = "Capture Data")
-	FCameraIntrinsics Intrinsics;
+	FTransform WorldTransform;
 
-	/** Whether custom projection matrix was used */
+	/** Transform relative to the owning actor's root */
 	UPROPERTY(BlueprintReadOnly, Category = "Capture Data")
-	bool bUsedCustomProjectionMatrix = false;
-
-	/** Projection matrix used (if custom) */
-	FMatrix ProjectionMatrix;
+	FTransform RelativeTransform;
 
 	/** Image pixel data (RGBA) */
 	TArray<FColor> ImageData;
@@ -121,226 +209,1594 @@ struct CAMERACAPTURE_API FCaptureData
 	/** Image height in pixels */
 	UPROPERTY(BlueprintReadOnly, Category = "Capture Data")
 	int32 Height = 0;
+};
 
-	/** Actor path in world */
-	UPROPERTY(BlueprintReadOnly, Category = "Capture Data")
-	FString ActorPath;
+/**
+ * Every camera's data for one frame number, assembled as the readbacks land
+ */
+struct CAMERACAPTURE_API FCaptureFrameSet
+{
+	/** Frame number shared by all views */
+	int64 FrameNumber = 0;
 
-	/** Level name */
-	UPROPERTY(BlueprintReadOnly, Category = "Capture Data")
-	FString LevelName;
+	/** Timestamp of the first view kicked for this frame */
+	double Timestamp = 0.0;
+
+	/** Views that arrived, ordered by camera unique ID */
+	TArray<TSharedRef<const FCaptureData>> Frames;
+
+	/** Number of cameras kicked for this frame */
+	int32 ExpectedCount = 0;
+
+	/** Whether every kicked camera arrived */
+	bool IsComplete() const { return Frames.Num() == ExpectedCount; }
+
+	/** View of a camera by unique ID (null if it is not in the set) */
+	const FCaptureData* FindFrame(const FString& UniqueID) const;
 };
 
 /**
- * Capture statistics for monitoring performance
+ * Fired on the game thread when a frame set is complete (or, with
+ * ECaptureFrameSetPolicy::EmitPartial, when it was finalized with views missing).
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnFrameSetCaptured, TSharedRef<const FCaptureFrameSet> /*FrameSet*/);
+
+/**
+ * Percentiles of one pipeline stage's latency, from an FCaptureLatencyHistogram
  */
 USTRUCT(BlueprintType)
-struct CAMERACAPTURE_API FCaptureStatistics
+struct CAMERACAPTURE_API FCaptureLatencyPercentiles
 {
 	GENERATED_BODY()
 
-	/** Total frames captured across all cameras */
+	/** Samples recorded this session */
 	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
-	int64 TotalFramesCaptured = 0;
+	int64 Count = 0;
 
-	/** Number of currently registered cameras */
-	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
-	int32 RegisteredCameraCount = 0;
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics", meta = (Units = "ms"))
+	float MeanMs = 0.0f;
 
-	/** Average capture time per frame (milliseconds) */
-	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
-	float AverageCaptureTimeMs = 0.0f;
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics", meta = (Units = "ms"))
+	float P50Ms = 0.0f;
 
-	/** Last capture time (milliseconds) */
-	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
-	float LastCaptureTimeMs = 0.0f;
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics", meta = (Units = "ms"))
+	float P95Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics", meta = (Units = "ms"))
+	float P99Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics", meta = (Units = "ms"))
+	float MaxMs = 0.0f;
 };
 
 /**
- * World subsystem for centralized camera capture management
- * Handles registration, synchronized capture, and serialization of multiple cameras
+ * Per-camera scheduling statistics
  */
-UCLASS()
-class CAMERACAPTURE_API UCameraCaptureSubsystem : public UTickableWorldSubsystem
+USTRUCT(BlueprintType)
+struct CAMERACAPTURE_API FCameraCaptureStatistics
 {
 	GENERATED_BODY()
 
-public:
-	UCameraCaptureSubsystem();
+	/** Unique ID of the camera (e.g., "Robot_BP_C_0::HeadCamera") */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	FString CameraID;
 
-	// USubsystem interface
-	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
-	virtual void Deinitialize() override;
+	/** Priority class of the camera */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	ECameraCapturePriority Priority = ECameraCapturePriority::Normal;
 
-	// FTickableGameObject interface
-	virtual void			  Tick(float DeltaTime) override;
-	virtual TStatId			  GetStatId() const override;
-	virtual bool			  IsTickable() const override;
-	virtual bool			  IsTickableInEditor() const override { return false; }
-	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Always; }
-	virtual void			  OnWorldBeginPlay(UWorld& InWorld) override;
+	/** Configured capture rate in Hz (0 if the camera is scheduled every N frames) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float TargetRateHz = 0.0f;
 
-	// ============================================================================
-	// Camera Registration
-	// ============================================================================
+	/** Effective every-N divider (0 if the camera is scheduled by rate) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int32 CaptureEveryNFrames = 0;
 
-	/** Register a camera component for centralized capture */
-	void RegisterCamera(UIntrinsicSceneCaptureComponent2D* Camera);
+	/** Measured capture rate over the last rate window (Hz) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float AchievedRateHz = 0.0f;
 
-	/** Unregister a camera component */
-	void UnregisterCamera(UIntrinsicSceneCaptureComponent2D* Camera);
+	/** Captures kicked for this camera this session */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 FramesKicked = 0;
 
-	/** Get number of registered cameras */
-	UFUNCTION(BlueprintPure, Category = "Camera Capture")
-	int32 GetRegisteredCameraCount() const { return RegisteredCameras.Num(); }
+	/** Captures that were due but skipped because of throttling */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 FramesThrottled = 0;
 
-	/** Get all registered cameras */
-	TArray<UIntrinsicSceneCaptureComponent2D*> GetRegisteredCameras() const;
+	/** Captures that were due but skipped or dropped to stay within the memory budget */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 FramesOverBudget = 0;
 
-	// ============================================================================
-	// Capture Control
-	// ============================================================================
+	/** Captures replaced by an "unchanged" metadata record (change-driven capture) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 FramesUnchanged = 0;
 
-	/** Start capturing from all registered cameras */
-	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
-	void StartCapture();
+	/** GPU time of the most recent resolved scene capture (milliseconds, RGB + DMV) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float LastGpuTimeMs = 0.0f;
 
-	/** Stop capturing */
-	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
-	void StopCapture();
+	/** Running average GPU time per capture (milliseconds) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float AverageGpuTimeMs = 0.0f;
 
-	/** Capture a single frame from all cameras */
-	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
-	void CaptureFrame();
+	/** Captures whose GPU timestamps never became available and were left out of the GPU time */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 GpuTimersUnresolved = 0;
 
-	/** Check if currently capturing */
-	UFUNCTION(BlueprintPure, Category = "Camera Capture")
-	bool IsCapturing() const { return bIsCapturing; }
+	/** Rate multiplier applied by the GPU governor (1 = full configured rate) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float GovernorRateScale = 1.0f;
 
-	// ============================================================================
-	// Configuration
-	// ============================================================================
+	/** Rendered captures read back and handed to listeners / the serializer */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 FramesHarvested = 0;
 
-	/** Set how often to capture (1 = every frame, 2 = every other frame, etc.) */
-	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
-	void SetCaptureRate(int32 InCaptureEveryNFrames);
+	/** Captures discarded because their readback exceeded the readback timeout */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 FramesDropped = 0;
 
-	/** Set output directory for captured data */
-	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
-	void SetOutputDirectory(const FString& Directory);
+	/** Captures harvested after the readback timeout had passed (kept by offline mode
+	 *  or by the drain at StopCapture instead of being dropped) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 FramesLate = 0;
 
-	/** Get current output directory */
-	UFUNCTION(BlueprintPure, Category = "Camera Capture")
-	FString GetOutputDirectory() const { return OutputDirectory; }
+	/** Kick-to-ready latency of the most recent harvested capture (milliseconds) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float LastReadbackLatencyMs = 0.0f;
 
-	/** Set which channels to capture (RGB, Depth, Motion Vectors) */
-	void SetCaptureChannels(bool bRGB, bool bDepth, bool bMotionVectors);
+	/** Running average kick-to-ready latency (milliseconds) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float AverageReadbackLatencyMs = 0.0f;
 
-	/** Set the depth+motion capture material (M_DmvCapture) */
-	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
-	void SetDmvMaterial(UMaterial* Material);
+	/** Largest kick-to-ready latency this session (milliseconds) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float MaxReadbackLatencyMs = 0.0f;
 
-	/** Enable/disable automatic serialization of captured data */
-	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
-	void SetSerializationEnabled(bool bEnabled);
+	/** Kick until the readbacks were seen ready */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	FCaptureLatencyPercentiles KickToReady;
 
-	/** Check if serialization is enabled */
-	UFUNCTION(BlueprintPure, Category = "Camera Capture")
-	bool IsSerializationEnabled() const { return bSerializationEnabled; }
+	/** Readbacks ready until the frame was handed to listeners */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	FCaptureLatencyPercentiles ReadyToHarvest;
 
-	// ============================================================================
-	// Statistics
-	// ============================================================================
+	/** Frame handed to the serializer until its files were on disk */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	FCaptureLatencyPercentiles HarvestToWritten;
 
-	/** Get capture statistics */
-	UFUNCTION(BlueprintPure, Category = "Camera Capture")
-	FCaptureStatistics GetStatistics() const;
+	/** Captures of this camera waiting for their readbacks */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int32 QueueDepth = 0;
 
-	/** Delegate fired after a frame has been harvested (game thread). */
-	FOnFrameCaptured OnFrameCaptured;
+	/** Largest QueueDepth this session */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int32 MaxQueueDepth = 0;
 
-protected:
-	/** Execute synchronized capture across all cameras */
-	void ExecuteSynchronizedCapture();
+	/** Frames whose files were written completely */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 FramesWritten = 0;
 
-	/** Phase 1: Kick all scene captures and enqueue async GPU readbacks */
-	void KickAllCaptures();
+	/** Bytes written to disk for this camera (EXR + JSON) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 BytesWritten = 0;
 
-	/** Phase 2: Poll pending readbacks and harvest any that are ready */
-	void HarvestReadyReadbacks();
+	/** Frames with at least one file that failed to write */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 FramesWriteFailed = 0;
+};
 
-	/** Enqueue an async GPU readback for a render target */
-	void EnqueueAsyncReadback(UTextureRenderTarget2D* RenderTarget, TUniquePtr<FRHIGPUTextureReadback>& OutReadback);
+/**
+ * Capture statistics for monitoring performance
+ */
+USTRUCT(BlueprintType)
+struct CAMERACAPTURE_API FCaptureStatistics
+{
+	GENERATED_BODY()
 
-	/** Build FCaptureData metadata (transform, intrinsics, etc.) without pixel data */
-	FCaptureData BuildCaptureMetadata(UIntrinsicSceneCaptureComponent2D* Camera);
+	/** Total frames captured across all cameras */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 TotalFramesCaptured = 0;
 
-	/** Serialize capture data to disk (takes shared ownership, safe for async). */
-	void SerializeCaptureData(TSharedRef<const FCaptureData> Data);
+	/** Total captures dropped on readback timeout across all cameras */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 TotalFramesDropped = 0;
 
-	/** Write EXR file with 6 channels (RGB + Depth + Motion) — called from background thread */
-	static bool WriteEXRFile_Static(const FString& FilePath, const FCaptureData& Data, bool bCaptureRGB, bool bCaptureDepth, bool bCaptureMotionVectors);
+	/** Running average kick-to-ready readback latency across all cameras (milliseconds) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float AverageReadbackLatencyMs = 0.0f;
 
-	/** Write metadata JSON file — called from background thread */
-	static bool WriteMetadataFile_Static(const FString& FilePath, const FCaptureData& Data);
+	/** Running average time harvested pixels waited for the game thread to emit them (milliseconds) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float AverageEmitDelayMs = 0.0f;
 
-	/** Generate unique camera ID, handling collisions */
-	FCameraIdentifier GenerateCameraID(UIntrinsicSceneCaptureComponent2D* Camera);
+	/** Running average wall time of one harvest task over the captures found ready together (milliseconds) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float AverageHarvestWallMs = 0.0f;
 
-	/** Check if actor name already exists and needs disambiguation */
-	FString DisambiguateActorName(const FString& ActorName);
+	/** Number of currently registered cameras */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int32 RegisteredCameraCount = 0;
 
-	/** Set up depth+motion capture camera for a registered RGB camera */
-	void SetupDmvCamera(UIntrinsicSceneCaptureComponent2D* RgbCamera);
+	/** Average CPU time to issue the captures of one kick (milliseconds) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float AverageCaptureTimeMs = 0.0f;
 
-	/** Ensure camera has a render target assigned */
-	void EnsureCameraRenderTarget(UIntrinsicSceneCaptureComponent2D* Camera);
+	/** CPU time to issue the captures of the last kick (milliseconds) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float LastCaptureTimeMs = 0.0f;
 
-	// ============================================================================
-	// Async Readback State
-	// ============================================================================
+	/** Estimated GPU milliseconds spent on scene captures per second of wall time
+	 *  (sum over cameras of average GPU time x achieved rate) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float GpuCaptureMsPerSecond = 0.0f;
 
-	/** Pending readback for a single camera's single channel (RGB or DMV) */
-	struct FPendingReadback
-	{
-		TUniquePtr<FRHIGPUTextureReadback> Readback;
-		int32							   Width = 0;
-		int32							   Height = 0;
-		bool							   bIsFloat = false; // true for RGBA32f (DMV), false for RGBA8 (RGB)
-	};
+	/** Frame time last measured by the GPU governor (milliseconds, 0 if governor disabled) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float GovernorFrameTimeMs = 0.0f;
 
-	/** All pending state for a single camera in a single frame */
-	struct FPendingCameraCapture
-	{
-		FCaptureData	 Metadata; // Pre-built metadata (no pixel data yet)
-		FPendingReadback RgbReadback;
-		FPendingReadback DmvReadback;
-		bool			 bHasRgb = false;
-		bool			 bHasDmv = false;
-		int32			 FramesWaiting = 0; // Safety: drop after too many frames
-	};
+	/** Captures kicked but not yet read back from the GPU */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int32 PendingReadbackCount = 0;
 
-	/** Queue of pending captures awaiting GPU completion */
-	TArray<FPendingCameraCapture> PendingCaptures;
+	/** Frames handed to the serializer that have not finished writing */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int32 SerializationBacklog = 0;
 
-	/** Maximum frames to wait for a readback before discarding */
-	static constexpr int32 MaxReadbackWaitFrames = 10;
+	/** Number of priority classes currently throttled, starting from Low (0 = none) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int32 ThrottledPriorityClasses = 0;
 
-	/** Extract pixel data from a completed RGB readback into FCaptureData */
-	void HarvestRgbReadback(FPendingReadback& Readback, FCaptureData& OutData);
+	/** Frame sets emitted with every kicked camera */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 FrameSetsCompleted = 0;
 
-	/** Extract pixel data from a completed DMV readback into FCaptureData */
-	void HarvestDmvReadback(FPendingReadback& Readback, FCaptureData& OutData);
+	/** Frame sets finalized with views missing (emitted or discarded depending on policy) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 FrameSetsIncomplete = 0;
 
-private:
-	/** Registered cameras (weak pointers to handle component destruction) */
-	TArray<TWeakObjectPtr<UIntrinsicSceneCaptureComponent2D>> RegisteredCameras;
+	/** GPU memory held by pooled render targets (bytes, 0 unless pooling is enabled) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 PooledRenderTargetBytes = 0;
 
-	/** Map of camera to identifier (for fast lookup) */
-	TMap<TWeakObjectPtr<UIntrinsicSceneCaptureComponent2D>, FCameraIdentifier> CameraIDMap;
+	/** Highest PooledRenderTargetBytes reached this session (bytes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 PeakPooledRenderTargetBytes = 0;
+
+	/** GPU memory dedicated per-camera render targets need for the registered cameras (bytes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 DedicatedRenderTargetBytes = 0;
+
+	/** Idle pixel planes held by the pixel buffer pool (bytes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 PooledPixelBufferBytes = 0;
+
+	/** Highest PooledPixelBufferBytes reached (bytes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 PeakPooledPixelBufferBytes = 0;
+
+	/** Pixel planes held by frames that are still alive (bytes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 OutstandingPixelBufferBytes = 0;
+
+	/** Pixel planes served from the pool instead of being allocated */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 PixelBufferPoolHits = 0;
+
+	/** Pixel planes the pool had to allocate */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 PixelBufferPoolMisses = 0;
+
+	/** Capture memory budget (bytes, 0 = unlimited) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 MemoryBudgetBytes = 0;
+
+	/** Worst-case footprint of every capture still holding memory, counted against the budget (bytes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 ReservedMemoryBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 PeakReservedMemoryBytes = 0;
+
+	/** Pixel planes kicked captures will need once their readbacks land (bytes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 ReadbackMemoryBytes = 0;
+
+	/** Pixels copied out of readbacks and waiting for the game thread (bytes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 AwaitingEmitMemoryBytes = 0;
+
+	/** Pixel planes of frames held by listeners, frame sets and the writer (bytes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 FrameMemoryBytes = 0;
+
+	/** Of FrameMemoryBytes: frames waiting on or being written by the serializer (bytes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 QueuedForWriteMemoryBytes = 0;
+
+	/** EXR staging arrays and copies queued on the ImageWriteQueue (bytes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 EncodingMemoryBytes = 0;
+
+	/** Captures skipped or dropped to stay within the memory budget */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 TotalFramesOverBudget = 0;
+
+	/** Captures that could not be skipped (offline / explicit) and went over the budget */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 MemoryBudgetOverruns = 0;
+
+	/** Seconds since the statistics were last reset (StartCapture or ResetStatistics) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float SessionSeconds = 0.0f;
+
+	/** Sum of the cameras' achieved capture rates (Hz) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float AchievedCaptureRateHz = 0.0f;
+
+	/** Kick until the readbacks were seen ready, all cameras */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	FCaptureLatencyPercentiles KickToReady;
+
+	/** Readbacks ready until the frame was handed to listeners, all cameras */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	FCaptureLatencyPercentiles ReadyToHarvest;
+
+	/** Frame handed to the serializer until its files were on disk, all cameras */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	FCaptureLatencyPercentiles HarvestToWritten;
+
+	/** Largest PendingReadbackCount this session */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int32 MaxPendingReadbackCount = 0;
+
+	/** Largest SerializationBacklog this session */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int32 MaxSerializationBacklog = 0;
+
+	/** Due captures skipped by throttling, all cameras */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 TotalFramesThrottled = 0;
+
+	/** GPU timers discarded unresolved, all cameras (GPU times only average the resolved ones) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 TotalGpuTimersUnresolved = 0;
+
+	/** Frames whose files were written completely */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 TotalFramesWritten = 0;
+
+	/** Frames with at least one file that failed to write */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 TotalFramesWriteFailed = 0;
+
+	/** Bytes written to disk (EXR + JSON) */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	int64 TotalBytesWritten = 0;
+
+	/** Frames written per second over the session */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float WriteFramesPerSecond = 0.0f;
+
+	/** Megabytes written per second over the session */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	float WriteMegabytesPerSecond = 0.0f;
+
+	/** Per-camera scheduling statistics */
+	UPROPERTY(BlueprintReadOnly, Category = "Statistics")
+	TArray<FCameraCaptureStatistics> PerCamera;
+};
+
+/**
+ * Handle to a registered camera: a registry slot plus a serial number, so a handle
+ * kept past UnregisterCamera never resolves to a camera registered later in the same slot
+ */
+struct FCameraHandle
+{
+	int32  Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	bool operator==(const FCameraHandle& Other) const
+	{
+		return Index == Other.Index && Serial == Other.Serial;
+	}
+
+	friend uint32 GetTypeHash(const FCameraHandle& Handle)
+	{
+		return HashCombine(GetTypeHash(Handle.Index), GetTypeHash(Handle.Serial));
+	}
+};
+
+class UCanvas;
+class USkeletalMeshComponent;
+class FCaptureMetricsExporter;
+class APlayerController;
+
+/**
+ * World subsystem for centralized camera capture management
+ * Handles registration, synchronized capture, and serialization of multiple cameras
+ */
+UCLASS()
+class CAMERACAPTURE_API UCameraCaptureSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	// Benchmarks in Private/Tests time internal passes directly
+	friend class FCameraCaptureKickListBenchmark;
+	friend class FCaptureHarvestScalingBenchmark;
+	friend class FCaptureBufferPoolTest;
+
+public:
+	UCameraCaptureSubsystem();
+
+	// USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Keeps the objects in the kick list alive between rebuilds */
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+	// FTickableGameObject interface
+	virtual void			  Tick(float DeltaTime) override;
+	virtual TStatId			  GetStatId() const override;
+	virtual bool			  IsTickable() const override;
+	virtual bool			  IsTickableInEditor() const override { return false; }
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Always; }
+	virtual void			  OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// ============================================================================
+	// Camera Registration
+	// ============================================================================
+
+	/** Register a camera component for centralized capture. Returns its handle
+	 *  (the existing handle if the camera is already registered). */
+	FCameraHandle RegisterCamera(UIntrinsicSceneCaptureComponent2D* Camera);
+
+	/** Unregister a camera component */
+	void UnregisterCamera(UIntrinsicSceneCaptureComponent2D* Camera);
+
+	/** Unregister a camera by handle */
+	void UnregisterCamera(FCameraHandle Handle);
+
+	/** Handle of a registered camera (invalid if not registered) */
+	FCameraHandle GetCameraHandle(const UIntrinsicSceneCaptureComponent2D* Camera) const;
+
+	/** Camera for a handle (null if the handle is stale or the camera was destroyed) */
+	UIntrinsicSceneCaptureComponent2D* GetCamera(FCameraHandle Handle) const;
+
+	/** Identifier of a registered camera (null if the handle is stale) */
+	const FCameraIdentifier* GetCameraIdentifier(FCameraHandle Handle) const;
+
+	/** Get number of registered cameras */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	int32 GetRegisteredCameraCount() const { return CameraRegistry.Num(); }
+
+	/** Get all registered cameras */
+	TArray<UIntrinsicSceneCaptureComponent2D*> GetRegisteredCameras() const;
+
+	/** Switch a registered camera to the given inline intrinsics, resizing its RGB (and,
+	 *  unless it has separate depth intrinsics, its DMV) render target to match */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetCameraIntrinsics(UIntrinsicSceneCaptureComponent2D* Camera, const FCameraIntrinsics& Intrinsics);
+
+	/** Pick up a render target assigned to or resized on a registered camera directly (the kick
+	 *  list caches targets and sizes; SetCameraIntrinsics and the subsystem's own changes do this) */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void NotifyCameraTargetChanged(UIntrinsicSceneCaptureComponent2D* Camera);
+
+	/** Change a registered camera's capture rate (Hz; 0 to fall back to every-N scheduling).
+	 *  The new rate applies from the next tick. */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetCameraCaptureRate(UIntrinsicSceneCaptureComponent2D* Camera, float RateHz);
+
+	/** Find a registered camera by its unique ID (e.g., "Robot_BP_C_0::HeadCamera") */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	UIntrinsicSceneCaptureComponent2D* FindCameraByID(const FString& UniqueID) const;
+
+	// ============================================================================
+	// Capture Control
+	// ============================================================================
+
+	/** Start capturing from all registered cameras */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void StartCapture();
+
+	/** Stop capturing */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void StopCapture();
+
+	/** Capture a single frame from all cameras */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void CaptureFrame();
+
+	/** Capture the given cameras with an explicit frame number and timestamp, ignoring
+	 *  schedules and throttling. Used to re-render a recorded trajectory so the output
+	 *  carries the frame numbers and timestamps of the live run. Waits for queue
+	 *  capacity first when offline mode is enabled. */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void CaptureFrameAt(const TArray<UIntrinsicSceneCaptureComponent2D*>& Cameras, int64 FrameNumber, double Timestamp);
+
+	/** Render the given cameras without reading them back, so that the next capture
+	 *  has the same previous-frame history (motion vectors, temporal effects) as an
+	 *  uninterrupted run. Used when a batch starts in the middle of a trajectory. */
+	void PrimeCaptureHistory(const TArray<UIntrinsicSceneCaptureComponent2D*>& Cameras);
+
+	/** Finish every queued render target / DMV camera creation and render each camera
+	 *  once (waiting for shader compilation) so the first captured frame runs at
+	 *  steady-state latency. Call before StartCapture; blocks the game thread. */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void PrewarmCapture();
+
+	/** Number of registered cameras whose capture resources have not been created yet */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	int32 GetPendingResourceSetupCount() const { return PendingResourceSetupCount; }
+
+	/** Check if currently capturing */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	bool IsCapturing() const { return bIsCapturing; }
+
+	/** Block (flushing rendering) until every pending readback has been harvested.
+	 *  Readbacks are not dropped on timeout while draining. Returns false if some were
+	 *  still pending after PipelineWaitTimeoutSeconds. */
+	bool DrainPendingReadbacks();
+
+	/** Frames waiting on readback, the serializer or the image write queue */
+	int32 GetQueuedFrameCount() const;
+
+	/** Block (flushing rendering and harvesting) until fewer than MaxQueuedFrames
+	 *  frames are in flight. Used by batch drivers to pipeline captures without
+	 *  unbounded memory growth; pass 1 to wait until everything has been written.
+	 *  Returns false if the queue was still full after PipelineWaitTimeoutSeconds. */
+	bool WaitForQueueCapacity(int32 MaxQueuedFrames);
+
+	/** Longest the game thread blocks on the capture pipeline before giving up (seconds) */
+	static constexpr double PipelineWaitTimeoutSeconds = 30.0;
+
+	// ============================================================================
+	// Configuration
+	// ============================================================================
+
+	/** Set how often to capture (1 = every frame, 2 = every other frame, etc.).
+	 *  Applies to cameras that do not define their own CaptureRateHz / CaptureEveryNFrames. */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetCaptureRate(int32 InCaptureEveryNFrames);
+
+	/** Set the limits used to detect GPU / serialization pressure. When either limit
+	 *  is exceeded, cameras are throttled starting with the lowest priority class.
+	 *  @param InMaxInFlightFramesPerCamera - Pending GPU readbacks allowed per registered camera
+	 *  @param InMaxSerializationBacklog - Frames allowed to be waiting on the serializer */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetThrottleLimits(int32 InMaxInFlightFramesPerCamera, int32 InMaxSerializationBacklog);
+
+	/** Detect readback completion on the render thread at the end of each rendered frame
+	 *  and copy pixels on a worker thread as soon as they land (default), or poll for
+	 *  completed readbacks on the game thread every tick. Frames are emitted on the game
+	 *  thread either way; compare AverageReadbackLatencyMs between the two modes. */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetRenderThreadHarvest(bool bEnabled);
+
+	/** Copy the pixels of captures that complete in the same tick on worker threads in
+	 *  parallel (default), or one after another on a single worker. Applies whenever the
+	 *  game thread harvests. Each camera's frames are still emitted oldest first; there is
+	 *  no fixed order between cameras. */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetParallelHarvest(bool bEnabled);
+
+	/** Whether OnFrameCaptured also receives the metadata-only records of cameras skipped by
+	 *  change-driven capture (bUnchanged set, no pixels). Off by default so listeners only see
+	 *  frames with pixels; the records are written to disk and added to frame sets either way. */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetBroadcastUnchangedFrames(bool bEnabled);
+
+	/** Set how long a capture may wait for its GPU readback before it is dropped
+	 *  (milliseconds, wall-clock; never applied in offline mode) */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetReadbackTimeout(float TimeoutMs);
+
+	/** Enable/disable blocking in StopCapture until the readbacks of the final kicked
+	 *  frames have been harvested, so they are not lost */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetWaitForReadbacksOnStop(bool bEnabled);
+
+	/** Enable/disable the GPU-time governor. When enabled, the capture rate of
+	 *  lower-priority cameras is reduced while the measured frame time exceeds
+	 *  TargetFrameTimeMs, and restored when there is headroom again.
+	 *  @param bEnabled - Whether the governor is active
+	 *  @param TargetFrameTimeMs - Frame time to hold (milliseconds) */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetGpuGovernor(bool bEnabled, float TargetFrameTimeMs);
+
+	/** Enable/disable deterministic offline capture. While capturing in offline mode
+	 *  the engine advances on a fixed timestep without frame pacing, every registered
+	 *  camera is captured on every step (per-camera rates and every-N schedules are
+	 *  ignored), timestamps are simulation time, and instead of dropping or
+	 *  throttling, each step waits until fewer than MaxQueuedFrames frames are
+	 *  waiting on readback or serialization. If the pipeline makes no progress for
+	 *  PipelineWaitTimeoutSeconds, capture is stopped rather than overrunning the bound.
+	 *  @param bEnabled - Whether offline mode is active
+	 *  @param FixedDeltaSeconds - Simulation time advanced per step
+	 *  @param MaxQueuedFrames - Bound on frames in flight (readback + serialization)
+	 *  @param RandomSeed - Seed applied to FMath::Rand / FMath::FRand at StartCapture */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetOfflineMode(bool bEnabled, float FixedDeltaSeconds = 0.0333333f, int32 MaxQueuedFrames = 16, int32 RandomSeed = 0);
+
+	/** Check if offline (fixed-step) capture is enabled */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	bool IsOfflineMode() const { return bOfflineMode; }
+
+	/** Enable/disable pose-only recording. While capturing with pose recording
+	 *  enabled nothing is rendered or read back: each due camera's world transform,
+	 *  plus the transforms of movable actors that moved, is appended to a compact
+	 *  binary trajectory (see FCaptureTrajectory) that can be re-rendered later with
+	 *  ACameraCaptureManager's trajectory replay.
+	 *  @param bEnabled - Whether pose recording is active
+	 *  @param InTrajectoryFilePath - File written between StartCapture and StopCapture
+	 *         (empty = OutputDirectory/trajectory.cctraj) */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetPoseRecording(bool bEnabled, const FString& InTrajectoryFilePath);
+
+	/** Check if pose-only recording is enabled */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	bool IsPoseRecording() const { return bPoseRecording; }
+
+	/** Set output directory for captured data */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetOutputDirectory(const FString& Directory);
+
+	/** Get current output directory */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	FString GetOutputDirectory() const { return OutputDirectory; }
+
+	/** Set which channels to capture (RGB, Depth, Motion Vectors) */
+	void SetCaptureChannels(bool bRGB, bool bDepth, bool bMotionVectors);
+
+	/** Set the depth+motion capture material (M_DmvCapture) */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetDmvMaterial(UMaterial* Material);
+
+	/** Game-thread time per tick spent creating render targets and DMV cameras for newly
+	 *  registered cameras (at least one camera is set up per tick) */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetResourceSetupBudget(float BudgetMs);
+
+	/** Enable/disable render target pooling. With pooling, cameras do not own render
+	 *  targets: each capture borrows a pooled target of matching size and format and
+	 *  returns it as soon as its readback copy is enqueued, so cameras with the same
+	 *  resolution share one physical target. Camera TextureTargets are only bound for
+	 *  the duration of a capture; enabling pooling drops the dedicated targets the
+	 *  subsystem created. Cameras with a TextureTarget assigned by their owner keep it
+	 *  and are never pooled. */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetRenderTargetPooling(bool bEnabled);
+
+	/** Check if render target pooling is enabled */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	bool IsRenderTargetPoolingEnabled() const { return bPoolRenderTargets; }
+
+	/** Enable/disable pooling of harvested pixel planes (default on). Frames take their
+	 *  RGB, depth and motion vector arrays from a size-classed pool and return them when
+	 *  the last reference to the frame is released, on whichever thread that happens.
+	 *  @param MaxPooledMB	Most idle memory the pool keeps; planes returned beyond it are freed */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetPixelBufferPooling(bool bEnabled, int32 MaxPooledMB = 512);
+
+	/** Cap the CPU memory held by captures in flight: pixels waiting on readback or emit, frames
+	 *  held by listeners and the writer, and EXR encode copies. Each capture reserves its
+	 *  worst-case footprint before it is kicked, so the policy applies before the budget is
+	 *  exceeded. Offline and explicit captures are never skipped; they wait, then overrun.
+	 *  @param BudgetMB - Most memory captures may hold (0 = unlimited, accounting only)
+	 *  @param Policy - What a capture that does not fit does */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetMemoryBudget(int32 BudgetMB, ECaptureMemoryOverflowPolicy Policy = ECaptureMemoryOverflowPolicy::SkipKick);
+
+	/** Enable/disable assembly of per-frame sets across cameras (see OnFrameSetCaptured).
+	 *  @param bEnabled - Whether frame sets are assembled
+	 *  @param Policy - Whether sets missing cameras are emitted or discarded
+	 *  @param TimeoutMs - Sets not resolved this long after their first kick are finalized
+	 *  @param bBatchSerialization - Write each frame set in one serializer job instead of
+	 *         one job per camera (frames are then written when their set is finalized) */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetFrameSetAssembly(bool bEnabled, ECaptureFrameSetPolicy Policy = ECaptureFrameSetPolicy::EmitPartial, float TimeoutMs = 1000.0f, bool bBatchSerialization = false);
+
+	/** Enable/disable automatic serialization of captured data */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetSerializationEnabled(bool bEnabled);
+
+	/** Check if serialization is enabled */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	bool IsSerializationEnabled() const { return bSerializationEnabled; }
+
+	// ============================================================================
+	// Sharding (multi-process capture)
+	// ============================================================================
+
+	/** Capture only this process's share of the work. Also configured from the command
+	 *  line: -CameraCaptureShard=<Index> -CameraCaptureShardCount=<Count>
+	 *  [-CameraCaptureShardMode=Cameras|TimeRange]. Once a shard is configured, a
+	 *  shard manifest is written when capture stops (see WriteShardManifest). */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetShard(int32 InShardIndex, int32 InShardCount, ECaptureShardMode InShardMode);
+
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	int32 GetShardIndex() const { return ShardIndex; }
+
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	int32 GetShardCount() const { return ShardCount; }
+
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	ECaptureShardMode GetShardMode() const { return ShardMode; }
+
+	/** Whether a shard was configured (from the command line or SetShard) */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	bool IsShardConfigured() const { return bShardConfigured; }
+
+	/** Whether this process captures the camera (always true unless sharding by camera) */
+	bool IsCameraInShard(const UIntrinsicSceneCaptureComponent2D* Camera) const;
+
+	/** Range [OutBegin, OutEnd) of NumItems trajectory frames / poses this process
+	 *  handles (the full range unless sharding by time range) */
+	void GetShardRange(int32 NumItems, int32& OutBegin, int32& OutEnd) const;
+
+	/** Wait for every queued frame to be written, then write
+	 *  OutputDirectory/shard_<Index>_of_<Count>.json listing the frames this process wrote.
+	 *  Frames already listed in that file by earlier sessions are kept (delete the shard
+	 *  files to start a fresh sharded session in the same directory). */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	bool WriteShardManifest();
+
+	/** Merge all shard manifests in a directory into session_index.json. Fails if a
+	 *  shard is missing. The index is ordered by frame and camera, so it does not
+	 *  depend on how the session was sharded. */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	static bool MergeShardManifests(const FString& Directory);
+
+	/** Check that two merged sessions are identical: same session_index.json, and
+	 *  byte-identical metadata and EXR files for every frame it lists. Used to verify
+	 *  that an N-process run reproduces a single-process run. */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	static bool CompareSessionOutputs(const FString& DirectoryA, const FString& DirectoryB);
+
+	/** Differing files logged individually by CompareSessionOutputs before it only counts them */
+	static constexpr int32 MaxCompareMismatchesLogged = 20;
+
+	// ============================================================================
+	// Statistics
+	// ============================================================================
+
+	/** Get capture statistics */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	FCaptureStatistics GetStatistics() const;
+
+	/** Start a new statistics session: zero counters, averages and latency histograms
+	 *  (StartCapture does this too). Scheduling state is left alone. */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void ResetStatistics();
+
+	/** Print statistics: the session totals and one line per camera, or (bDetailed)
+	 *  every per-camera field. Backs the CameraCapture.Stats / CameraCapture.Dump commands. */
+	static void PrintStatistics(const FCaptureStatistics& Stats, FOutputDevice& Ar, bool bDetailed);
+
+	/** Show/hide the on-screen performance overlay (also: CameraCapture.HUD [0|1]) */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetDebugHudVisible(bool bVisible);
+
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	bool IsDebugHudVisible() const { return DebugHudHandle.IsValid(); }
+
+	/** Periodically write counters, queue depths, latency histograms and per-camera rates to a
+	 *  Prometheus text file (node-exporter textfile collector). Formatting and the write run off
+	 *  the game thread, and the file is replaced atomically. Also: -CameraCaptureMetricsFile=<Path>
+	 *  @param FilePath - Target file (empty: <Saved>/Metrics/camera_capture.prom)
+	 *  @param IntervalSeconds - Time between exports */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetMetricsExport(bool bEnabled, const FString& FilePath = TEXT(""), float IntervalSeconds = 15.0f);
+
+	/** Go back to the -CameraCaptureMetricsFile export, or stop exporting if none was given.
+	 *  Callers that turn their own export off use this so a fleet export keeps running. */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void RestoreCommandLineMetricsExport();
+
+	UFUNCTION(BlueprintPure, Category = "Camera Capture")
+	bool IsMetricsExportEnabled() const { return MetricsExporter.IsValid(); }
+
+	/** Write the metrics file now instead of waiting for the interval (no-op while export is off) */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void ExportMetrics();
+
+	/** Record a timeline of every pipeline stage per camera and frame while capturing, and write
+	 *  it as Chrome Trace Event JSON (Perfetto, chrome://tracing) when capture stops. The
+	 *  recorder is process-wide, so only one world should record at a time.
+	 *  @param FilePath - Trace file (empty: <OutputDirectory>/capture_timeline.json) */
+	UFUNCTION(BlueprintCallable, Category = "Camera Capture")
+	void SetTimelineRecording(bool bEnabled, const FString& FilePath = TEXT(""));
+
+	/** Delegate fired after a frame has been harvested (game thread). */
+	FOnFrameCaptured OnFrameCaptured;
+
+	/** Delegate fired when all cameras of a frame have been harvested (game thread).
+	 *  Only fires while frame set assembly is enabled. */
+	FOnFrameSetCaptured OnFrameSetCaptured;
+
+protected:
+	/** Camera registry entry (defined with the registry below; taken by reference before that) */
+	struct FRegisteredCamera;
+
+	/** Execute synchronized capture across all cameras */
+	void ExecuteSynchronizedCapture();
+
+	/** Phase 1: Kick all scene captures and enqueue async GPU readbacks.
+	 *  Unless bForceAll is set, only cameras whose schedule is due (and which are
+	 *  not throttled) are kicked. */
+	void KickAllCaptures(bool bForceAll = false);
+
+	/** Phase 2: Poll pending readbacks and harvest any that are ready */
+	void HarvestReadyReadbacks();
+
+	/** Publish queue depths and pool memory to STATGROUP_CameraCapture */
+	void UpdatePipelineStats();
+
+	/** Enqueue an async GPU readback for a render target */
+	void EnqueueAsyncReadback(UTextureRenderTarget2D* RenderTarget, TUniquePtr<FRHIGPUTextureReadback>& OutReadback);
+
+	/** Build FCaptureData metadata (transform, shared camera info) without pixel data */
+	FCaptureData BuildCaptureMetadata(UIntrinsicSceneCaptureComponent2D* Camera);
+
+	/** Interned static metadata of a camera, rebuilt if its projection changed */
+	TSharedRef<const FCaptureCameraInfo, ESPMode::ThreadSafe> GetCameraInfo(UIntrinsicSceneCaptureComponent2D* Camera);
+
+	/** Serialize capture data to disk (takes shared ownership, safe for async). */
+	void SerializeCaptureData(TSharedRef<const FCaptureData> Data);
+
+	/** Serialize every view of a frame set in one background job */
+	void SerializeFrameSet(TSharedRef<const FCaptureFrameSet> FrameSet);
+
+	/** Record a frame in the shard manifest (if sharding) */
+	void AddShardManifestEntry(const FCaptureData& Data);
+
+	/** Tracks the files of one frame until all are on disk. EXR files finish on an
+	 *  ImageWriteQueue thread, after WriteCaptureFiles_Static has returned. */
+	struct FCaptureWriteTracker
+	{
+		TFunction<void(bool /*bSucceeded*/, int64 /*Bytes*/)> OnWritten;
+		std::atomic<int32>									  PendingFiles { 1 }; // The writer itself holds one
+		std::atomic<int64>									  Bytes { 0 };
+		std::atomic<bool>									  bFailed { false };
+
+		void BeginFile() { PendingFiles.fetch_add(1); }
+		void EndFile(bool bSucceeded, int64 FileBytes);
+	};
+
+	/** Write one frame's EXR and metadata JSON — called from background thread.
+	 *  OnWritten (optional, any thread) runs once every file has been written. */
+	static void WriteCaptureFiles_Static(const FString& OutputDir, const FCaptureData& Data, bool bCaptureRGB, bool bCaptureDepth, bool bCaptureMotionVectors,
+		TFunction<void(bool /*bSucceeded*/, int64 /*Bytes*/)> OnWritten = nullptr);
+
+	/** Write EXR file with 6 channels (RGB + Depth + Motion) — called from background thread */
+	static bool WriteEXRFile_Static(const FString& FilePath, const FCaptureData& Data, bool bCaptureRGB, bool bCaptureDepth, bool bCaptureMotionVectors,
+		const TSharedPtr<FCaptureWriteTracker, ESPMode::ThreadSafe>& Tracker = nullptr);
+
+	/** Completion callback for Data's files that records them in the pipeline counters */
+	TFunction<void(bool, int64)> MakeWriteRecorder(const FCaptureData& Data) const;
+
+	/** Write metadata JSON file — called from background thread */
+	static bool WriteMetadataFile_Static(const FString& FilePath, const FCaptureData& Data);
+
+	/** Generate unique camera ID, handling collisions. OutDisambiguatedFrom receives
+	 *  the base actor name if the actor name had to be disambiguated. */
+	FCameraIdentifier GenerateCameraID(UIntrinsicSceneCaptureComponent2D* Camera, FString& OutDisambiguatedFrom);
+
+	/** Pick an unused suffixed form of an actor name (claims it in ActorNameSuffixes) */
+	FString DisambiguateActorName(const FString& ActorName);
 
-	/** Set of used actor names (for collision detection) */
-	TSet<FString> UsedActorNames;
+	/** Set up depth+motion capture camera for a registered RGB camera */
+	void SetupDmvCamera(UIntrinsicSceneCaptureComponent2D* RgbCamera);
+
+	/** Ensure camera has a render target assigned (no-op while pooling). A target the
+	 *  subsystem did not create is left alone and makes the camera unpoolable. */
+	void EnsureCameraRenderTarget(FRegisteredCamera& Entry, UIntrinsicSceneCaptureComponent2D* Camera);
+
+	/** Ensure a DMV camera has a render target sized to the depth intrinsics (no-op while pooling) */
+	void EnsureDmvRenderTarget(UIntrinsicSceneCaptureComponent2D* RgbCamera, USceneCaptureComponent2D* DmvCamera);
+
+	/** Render a camera and its DMV copy without reading them back */
+	void RenderWithoutReadback(const FRegisteredCamera& Entry, UIntrinsicSceneCaptureComponent2D* Camera);
+
+	// ============================================================================
+	// Deferred Resource Setup
+	// ============================================================================
+
+	/** Queue creation of a registered camera's render target and DMV camera */
+	void QueueResourceSetup(FCameraHandle Handle);
+
+	/** Create a camera's render target and DMV camera now (no-op if already done) */
+	void SetupCameraResources(FRegisteredCamera& Entry);
+
+	/** Set up queued cameras until BudgetSeconds have elapsed (at least one) */
+	void ProcessPendingResourceSetups(double BudgetSeconds);
+
+	/** Cameras waiting for resource setup, oldest first (stale handles are skipped) */
+	TArray<FCameraHandle> PendingResourceSetups;
+
+	/** Registered cameras not yet set up (PendingResourceSetups may hold stale entries) */
+	int32 PendingResourceSetupCount = 0;
+
+	/** Per-tick budget for ProcessPendingResourceSetups (milliseconds) */
+	float ResourceSetupBudgetMs = 2.0f;
+
+	// ============================================================================
+	// Render Target Pool
+	// ============================================================================
+
+	/** Borrow a pooled target of the given size and format and bind it to a capture component */
+	UTextureRenderTarget2D* BindPooledTarget(USceneCaptureComponent2D* Capture, int32 Width, int32 Height, ETextureRenderTargetFormat Format);
+
+	/** Return a capture component's target to the pool. Safe as soon as the readback copy
+	 *  is enqueued: render commands run in order, so the next capture into the target
+	 *  cannot overwrite it before the copy. */
+	void UnbindPooledTarget(USceneCaptureComponent2D* Capture);
+
+	/** Release pooled targets that have not been borrowed for more than IdleKicks kicks
+	 *  (e.g. sizes no camera uses anymore after an intrinsics change) */
+	void TrimRenderTargetPool(uint64 IdleKicks);
+
+	/** Drop every pooled target */
+	void ReleaseRenderTargetPool();
+
+	/** GPU memory of a render target of the given size and format (bytes) */
+	static int64 GetRenderTargetBytes(int32 Width, int32 Height, ETextureRenderTargetFormat Format);
+
+	/** A pooled target waiting to be borrowed */
+	struct FPooledRenderTarget
+	{
+		UTextureRenderTarget2D* Target = nullptr; // Kept alive by PooledRenderTargets
+		uint64					LastUsedKick = 0; // RenderTargetPoolKicks when it was returned
+	};
+
+	/** Free pooled targets keyed by (width, height, format) */
+	TMap<FIntVector, TArray<FPooledRenderTarget>> FreeRenderTargets;
+
+	/** GPU memory held by the pool, and the most it has held (bytes) */
+	int64 PooledRenderTargetBytes = 0;
+	int64 PeakPooledRenderTargetBytes = 0;
+
+	/** Kicks so far, the pool's clock. Counted in kicks rather than seconds so slow
+	 *  offline frames don't release targets every camera still uses. */
+	uint64 RenderTargetPoolKicks = 0;
+
+	/** Kicks a pooled target may stay free before it is released */
+	static constexpr uint64 PooledTargetIdleKicks = 300;
+
+	/** OutputDirectory resolved against the project directory */
+	FString GetAbsoluteOutputDirectory() const;
+
+	/** Seconds since capture started (time base for schedules and timestamps).
+	 *  Wall-clock time when live, simulation time in offline mode. */
+	double GetCaptureTime() const;
+
+	// ============================================================================
+	// Offline (Fixed-Step) Mode
+	// ============================================================================
+
+	/** Switch the engine to fixed-step, unpaced ticking (saves the previous settings) */
+	void ApplyOfflineTiming();
+
+	/** Restore the engine timing settings saved by ApplyOfflineTiming */
+	void RestoreEngineTiming();
+
+	/** Block until the number of frames in flight is below OfflineMaxQueuedFrames. Keeps
+	 *  waiting while the queue drains; false only once it stalled for a whole timeout. */
+	bool WaitForOfflineQueueCapacity();
+
+	// ============================================================================
+	// Pose Recording
+	// ============================================================================
+
+	/** Add the transforms of movable actors that moved, and the bone poses of skeletal
+	 *  meshes that changed, since they were last recorded to the trajectory frame being written */
+	void RecordMovingActorPoses();
+
+	/** Frame number, timestamp and camera set forced by CaptureFrameAt */
+	struct FExternalFrame
+	{
+		int64											FrameNumber = 0;
+		double											Timestamp = 0.0;
+		TSet<const UIntrinsicSceneCaptureComponent2D*>	Cameras;
+	};
+
+	/** Set only for the duration of a CaptureFrameAt kick */
+	TOptional<FExternalFrame> ExternalFrame;
+
+	// ============================================================================
+	// Scheduling State
+	// ============================================================================
+
+	/** Per-camera scheduling state */
+	struct FCameraScheduleState
+	{
+		double NextCaptureTime = 0.0; // Only used for rate-based (Hz) schedules
+		int64  FramesKicked = 0;
+		int64  FramesThrottled = 0;
+		int64  FramesOverBudget = 0;
+		int32  RateWindowKicks = 0;
+		double RateWindowStart = 0.0;
+		float  AchievedRateHz = 0.0f;
+		float  LastGpuTimeMs = 0.0f;
+		float  AverageGpuTimeMs = 0.0f;
+		int64  GpuTimersUnresolved = 0;
+		float  GovernorRateScale = 1.0f; // Applied to the configured rate by the GPU governor
+
+		// Readback accounting
+		int64 FramesHarvested = 0;
+		int64 FramesDropped = 0;
+		int64 FramesLate = 0;
+		float LastReadbackLatencyMs = 0.0f;
+		float AverageReadbackLatencyMs = 0.0f;
+		float MaxReadbackLatencyMs = 0.0f;
+		int32 MaxQueueDepth = 0;
+
+		// Change-driven capture: what the camera looked like at its last full capture
+		bool	   bHasChangeSignature = false;
+		FTransform LastCapturedTransform;
+		uint32	   LastProjectionHash = 0;
+		uint32	   LastSceneSignature = 0;
+		int64	   LastCapturedFrameNumber = -1;
+		int32	   ConsecutiveSkippedFrames = 0;
+		int64	   FramesUnchanged = 0;
+	};
+
+	/** A registry slot: the camera, its identity and its scheduling state */
+	struct FRegisteredCamera
+	{
+		TWeakObjectPtr<UIntrinsicSceneCaptureComponent2D> Camera;
+		FObjectKey										  CameraKey; // Key in CameraIndices (stays valid after the camera is destroyed)
+		FCameraIdentifier								  Identifier;
+		FName											  TraceName; // Identifier.UniqueID, interned once for trace spans
+		FString											  DisambiguatedFrom; // Base actor name if Identifier.ActorName was disambiguated
+		FCameraScheduleState							  Schedule;
+		uint32											  Serial = 0;
+		int32											  KickIndex = INDEX_NONE; // Record in KickList (valid while !bKickListDirty)
+		bool											  bResourcesReady = false; // Render target + DMV camera created
+		bool											  bPoolableRgb = false; // RGB target is the subsystem's to create (not assigned by the camera's owner)
+		TEnumAsByte<ETextureRenderTargetFormat>			  RgbFormat = RTF_RGBA8; // Format of the camera's RGB target, also used for pooled targets
+		TWeakObjectPtr<UTextureRenderTarget2D>			  OwnedRgbTarget; // Dedicated RGB target the subsystem created
+		int32											  PendingQueueIndex = INDEX_NONE; // Slot in PendingQueues, created on first kick
+
+		TSharedPtr<const FCaptureCameraInfo, ESPMode::ThreadSafe> CameraInfo; // Built on first capture
+
+		/** Stage latencies and write counters (shared with serializer threads) */
+		TSharedRef<FCapturePipelineCounters, ESPMode::ThreadSafe> Counters = MakeShared<FCapturePipelineCounters, ESPMode::ThreadSafe>();
+	};
+
+	/** Registry slot of a camera (null if not registered) */
+	FRegisteredCamera*		 FindRegisteredCamera(const UIntrinsicSceneCaptureComponent2D* Camera);
+	const FRegisteredCamera* FindRegisteredCamera(const UIntrinsicSceneCaptureComponent2D* Camera) const;
+
+	/** Registry slot for a handle (null if stale) */
+	FRegisteredCamera*		 FindRegisteredCamera(FCameraHandle Handle);
+	const FRegisteredCamera* FindRegisteredCamera(FCameraHandle Handle) const;
+
+	/** Remove a registry slot and everything keyed on it (DMV camera, name bookkeeping) */
+	void RemoveRegisteredCamera(int32 Index);
+
+	/** Whether the camera's schedule is due this tick (advances its schedule if so) */
+	bool IsCameraDue(const UIntrinsicSceneCaptureComponent2D* Camera, FCameraScheduleState& State, double Now) const;
+
+	/** Number of priority classes to throttle given current pressure (0 = none) */
+	int32 ComputeThrottledPriorityClasses() const;
+
+	// ============================================================================
+	// GPU Timing + Governor
+	// ============================================================================
+
+	/** GPU timestamp pair bracketing one camera's scene captures.
+	 *  Queries are allocated from the pool, read and returned on the render thread; the result
+	 *  is published through GpuTimeMs. The pool is declared first so it outlives the queries. */
+	struct FCaptureGpuTimer
+	{
+		FRenderQueryPoolRHIRef QueryPool;
+		FRHIPooledRenderQuery  BeginQuery;
+		FRHIPooledRenderQuery  EndQuery;
+		std::atomic<float>	   GpuTimeMs { -1.0f }; // < 0 until resolved
+		std::atomic<bool>	   bResolveQueued { false };
+	};
+
+	/** A timer waiting to be resolved, and the camera it belongs to */
+	struct FOutstandingGpuTimer
+	{
+		FCameraHandle									  Camera;
+		TSharedRef<FCaptureGpuTimer, ESPMode::ThreadSafe> Timer;
+		int32											  FramesWaiting = 0;
+	};
+
+	/** Enqueue the begin timestamp for a camera's captures (returns null if timestamps are unsupported) */
+	TSharedPtr<FCaptureGpuTimer, ESPMode::ThreadSafe> BeginGpuTimer();
+
+	/** Enqueue the end timestamp for a camera's captures */
+	void EndGpuTimer(const TSharedPtr<FCaptureGpuTimer, ESPMode::ThreadSafe>& Timer);
+
+	/** Fold resolved GPU timers into per-camera stats and request resolution of the rest */
+	void ResolveGpuTimers();
+
+	/** Return the queries of timers that will not be resolved to their pool (on the render thread) */
+	static void ReleaseGpuTimerQueries(TArray<TSharedRef<FCaptureGpuTimer, ESPMode::ThreadSafe>>&& Timers);
+
+	/** Adjust per-camera rate scales to hold the governor's target frame time */
+	void UpdateGpuGovernor();
+
+	/** Smallest rate scale the governor will apply to a camera */
+	static constexpr float MinGovernorRateScale = 0.125f;
+
+	/** Fraction of the target frame time below which the governor restores rates */
+	static constexpr float GovernorHeadroomFraction = 0.85f;
+
+	/** Seconds between governor adjustments (lets the GPU timings settle) */
+	static constexpr double GovernorIntervalSeconds = 0.5;
+
+	/** Timers older than this many ticks are discarded unresolved */
+	static constexpr int32 MaxGpuTimerWaitFrames = 30;
+
+	// ============================================================================
+	// Change-Driven Capture
+	// ============================================================================
+
+	/** Snapshot of a tracked actor used to detect scene changes in a camera's frustum */
+	struct FMovableActorSnapshot
+	{
+		FVector BoundsOrigin;
+		FVector BoundsExtent;
+		uint32	Hash = 0; // Identity + transform + bounds + materials (+ kick serial while animating)
+	};
+
+	/** What a camera saw at a kick, compared against its last full capture */
+	struct FViewSignature
+	{
+		FTransform Transform;
+		uint32	   ProjectionHash = 0;
+		uint32	   SceneSignature = 0;
+	};
+
+	/** Collect snapshots of the tracked actors (once per kick, only when a camera needs it) */
+	void GatherMovableActorSnapshots();
+
+	/** Hash of the lighting and of the tracked actors whose bounds intersect the camera's frustum */
+	uint32 ComputeSceneSignature(const UIntrinsicSceneCaptureComponent2D* Camera) const;
+
+	/** Whether the camera can be skipped because nothing it sees changed since its last
+	 *  full capture. OutSignature is what it sees now; commit it once the capture is kicked. */
+	bool ShouldSkipUnchanged(const UIntrinsicSceneCaptureComponent2D* Camera, const FCameraScheduleState& State, FViewSignature& OutSignature);
+
+	/** Make the signature of a kicked capture the reference later kicks are compared against */
+	static void CommitViewSignature(FCameraScheduleState& State, const FViewSignature& Signature);
+
+	/** Tracked actor snapshots for the current kick */
+	TArray<FMovableActorSnapshot> MovableActorSnapshots;
+
+	/** Hash of every light's state for the current kick (lights reach beyond their bounds) */
+	uint32 LightingSignature = 0;
+
+	/** Incremented per gather; folded into the hash of actors that animate without moving */
+	uint32 SceneSnapshotSerial = 0;
+
+	/** Whether MovableActorSnapshots has been gathered for the current kick */
+	bool bMovableActorSnapshotsValid = false;
+
+	/** Whether OnFrameCaptured receives metadata-only unchanged records */
+	bool bBroadcastUnchangedFrames = false;
+
+	// ============================================================================
+	// Scene Actor Tracking
+	// ============================================================================
+
+	/** Walk the world once for the actors that can change a camera's image, then keep the
+	 *  set current from the world's spawn/destroy notifications */
+	void StartTrackingSceneActors();
+
+	/** Unbind the world notifications and forget the tracked actors */
+	void StopTrackingSceneActors();
+
+	/** Whether the actor can change what a camera sees: a movable root, or a light, effect or skeletal mesh */
+	static bool IsTrackedSceneActor(const AActor* Actor);
+
+	void OnSceneActorSpawned(AActor* Actor);
+	void OnSceneActorDestroyed(AActor* Actor);
+
+	/** Actors change detection and pose recording look at (instead of iterating the world) */
+	TSet<TWeakObjectPtr<AActor>> TrackedSceneActors;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+
+	/** Whether TrackedSceneActors has been built and is being kept current */
+	bool bTrackingSceneActors = false;
+
+	/** Length of the window used to measure achieved per-camera rates (seconds) */
+	static constexpr double RateWindowSeconds = 1.0;
+
+	// ============================================================================
+	// Kick List
+	// ============================================================================
+
+	/** Everything the kick loop needs for one camera, resolved ahead of time. The objects are
+	 *  held strongly (AddReferencedObjects), so the loop uses them without resolving anything. */
+	struct FCaptureKickRecord
+	{
+		TObjectPtr<UIntrinsicSceneCaptureComponent2D> Camera;
+		int32										  RegistryIndex = INDEX_NONE;
+
+		TObjectPtr<UTextureRenderTarget2D>		RgbTarget;
+		int32									RgbWidth = 0;
+		int32									RgbHeight = 0;
+		TEnumAsByte<ETextureRenderTargetFormat> RgbFormat = RTF_RGBA8;
+		bool									bRgbIsFloat = false;
+		bool									bPooledRgb = false; // Borrow an RgbWidth x RgbHeight target of RgbFormat per capture
+
+		TObjectPtr<USceneCaptureComponent2D> DmvCamera;
+		TObjectPtr<UTextureRenderTarget2D>	 DmvTarget;
+		int32								 DmvWidth = 0;
+		int32								 DmvHeight = 0;
+	};
+
+	/** Rebuild KickList from the registry, first unregistering cameras that were destroyed */
+	void RebuildKickList();
+
+	/** A camera in a game world unregistered (destroyed, streamed out or re-registering): rebuild
+	 *  the kick list before the next kick, which drops the camera if it is gone for good */
+	void OnCameraComponentUnregistered(UIntrinsicSceneCaptureComponent2D* Camera);
+
+	FDelegateHandle CameraUnregisteredHandle;
+
+	/** Re-resolve a record's render targets, DMV camera and formats */
+	void RefreshKickRecord(FCaptureKickRecord& Record, UIntrinsicSceneCaptureComponent2D* Camera);
+
+	/** Refresh one camera's record in place, or leave it to the pending rebuild */
+	void RefreshKickRecord(UIntrinsicSceneCaptureComponent2D* Camera);
+
+	/** Registered cameras in a contiguous array, rebuilt only when registration changes */
+	TArray<FCaptureKickRecord> KickList;
+
+	/** Whether KickList must be rebuilt before the next kick */
+	bool bKickListDirty = true;
+
+	// ============================================================================
+	// Async Readback State
+	// ============================================================================
+
+	/** Pending readback for a single camera's single channel (RGB or DMV) */
+	struct FPendingReadback
+	{
+		TUniquePtr<FRHIGPUTextureReadback> Readback;
+		int32							   Width = 0;
+		int32							   Height = 0;
+		bool							   bIsFloat = false; // true for RGBA32f (DMV), false for RGBA8 (RGB)
+		const void*						   MappedData = nullptr; // Staging buffer while mapped (null if the lock failed)
+		int32							   MappedRowPitch = 0; // Row pitch of MappedData in pixels
+	};
+
+	/** The readbacks of one capture and the pixels copied out of them. Shared between the
+	 *  game thread, the render-thread watcher and the harvest task. Whichever thread first
+	 *  claims a ready completion hands it to the render thread, which maps the staging
+	 *  buffers; a worker copies the pixels and the render thread unmaps them again. */
+	struct FReadbackCompletion
+	{
+		FPendingReadback RgbReadback;
+		FPendingReadback DmvReadback;
+		bool			 bHasRgb = false;
+		bool			 bHasDmv = false;
+		bool			 bWatched = false; // Polled by the render-thread watcher
+
+		FName CameraID;		// For trace spans
+		int64 FrameNumber = 0; // For trace spans
+
+		/** Pool the pixel planes are taken from (null to allocate them directly) */
+		TSharedPtr<FCaptureBufferPool, ESPMode::ThreadSafe> BufferPool;
+
+		/** Budget share of the capture, handed on to the frame when it is emitted */
+		FCaptureMemoryTracker::FReservationPtr MemoryReservation;
+		int64								   ReadbackBytes = 0;	  // In ECaptureMemoryStage::Readback until harvested
+		int64								   AwaitingEmitBytes = 0; // In ECaptureMemoryStage::AwaitingEmit until emitted
+
+		// Filled by Harvest
+		TArray<FColor>	  ImageData;
+		TArray<float>	  DepthData;
+		TArray<FVector2D> MotionVectorData;
+		double			  ReadyTime = 0.0;	 // FPlatformTime::Seconds() when the readbacks were seen ready
+		double			  HarvestTime = 0.0; // FPlatformTime::Seconds() when the pixels were copied
+
+		std::atomic<bool> bClaimed { false };	// Harvest started (or capture dropped)
+		std::atomic<bool> bHarvested { false }; // Pixels copied; published with release semantics
+
+		/** Whether every readback has landed in its staging buffer */
+		bool IsReady() const;
+
+		/** Lock the staging buffers (render thread) */
+		void Map();
+
+		/** Copy the pixels out of the mapped staging buffers, then publish bHarvested (any thread) */
+		void Harvest();
+
+		/** Unlock the staging buffers once Harvest is done (render thread) */
+		void Unmap();
+
+		/** Takes whatever it still accounts for off the stage counters and returns planes
+		 *  that were never emitted to the pool (dropped captures) */
+		~FReadbackCompletion();
+	};
+
+	/** All pending state for a single camera in a single frame */
+	struct FPendingCameraCapture
+	{
+		FCaptureData										 Metadata; // Pre-built metadata (no pixel data yet)
+		FCameraHandle										 Camera;
+		TSharedPtr<FReadbackCompletion, ESPMode::ThreadSafe> Readback; // Null for unchanged records
+		double												 KickTime = 0.0; // FPlatformTime::Seconds() when kicked
+	};
+
+	/** Render-thread side of readback completion: polls in-flight readbacks at the end of
+	 *  every rendered frame and starts a harvest task for the ones that landed, so pixels are
+	 *  copied as soon as the GPU is done rather than at the next game tick. Also maps and
+	 *  unmaps the staging buffers of captures the game thread claims. */
+	struct FReadbackWatcher : public TSharedFromThis<FReadbackWatcher, ESPMode::ThreadSafe>
+	{
+		/** Completions not yet claimed (render thread only) */
+		TArray<TSharedRef<FReadbackCompletion, ESPMode::ThreadSafe>> InFlight;
+
+		/** Binding to FCoreDelegates::OnEndFrameRT (render thread only) */
+		FDelegateHandle EndFrameHandle;
+
+		/** Running average wall time of one harvest task (milliseconds, written by the tasks) */
+		std::atomic<float> AverageHarvestWallMs { 0.0f };
+
+		/** Claim ready completions and dispatch their harvest task (render thread) */
+		void PollReadyReadbacks();
+
+		/** Map claimed completions and start one task that copies their pixels, in parallel
+		 *  unless bParallel is false. The task unmaps them with a render command once the
+		 *  copies are done (render thread). */
+		void MapAndHarvest(TArray<TSharedRef<FReadbackCompletion, ESPMode::ThreadSafe>>&& Claimed, bool bParallel);
+	};
+
+	/** Hand a completion to the render-thread watcher (enqueued after its copies) */
+	void WatchReadback(const TSharedRef<FReadbackCompletion, ESPMode::ThreadSafe>& Completion);
+
+	/** Shared with the render thread, which may outlive the subsystem by a frame */
+	TSharedPtr<FReadbackWatcher, ESPMode::ThreadSafe> ReadbackWatcher;
+
+	/** Whether readback completion is detected on the render thread (otherwise polled each tick) */
+	bool bRenderThreadHarvest = true;
+
+	/** Set while the game thread blocks on readbacks: it polls them itself, since no
+	 *  frame ends (and the watcher does not run) until it returns */
+	bool bBlockingOnReadbacks = false;
+
+	/** Block the game thread until IsDone holds, flushing rendering and harvesting readbacks
+	 *  between checks so the pipeline keeps moving. Every blocking wait on the pipeline goes
+	 *  through here. Returns false (without logging; the caller knows what it waited for)
+	 *  if IsDone still fails after TimeoutSeconds. */
+	bool WaitForPipeline(TFunctionRef<bool()> IsDone, double TimeoutSeconds = PipelineWaitTimeoutSeconds);
+
+	/** Sleep-poll until Predicate holds or TimeoutSeconds pass. Safe on any thread. */
+	static bool WaitUntil(TFunctionRef<bool()> Predicate, double TimeoutSeconds);
+
+	/** Running average time harvested pixels waited for the game thread to emit them (milliseconds) */
+	float AverageEmitDelayMs = 0.0f;
+
+	/** Pixel planes of harvested frames. Shared with the frames, which return their planes
+	 *  on release and may outlive the subsystem. Null when pixel buffer pooling is off. */
+	TSharedPtr<FCaptureBufferPool, ESPMode::ThreadSafe> PixelBufferPool;
+
+	/** Wrap harvested data in a shared ref whose deleter returns the planes to Pool (if any)
+	 *  and takes them off the Frames stage of the data's memory reservation */
+	static TSharedRef<const FCaptureData> MakeSharedCaptureData(FCaptureData&& Data, const TSharedPtr<FCaptureBufferPool, ESPMode::ThreadSafe>& Pool);
+
+	/** Allocated size of a frame's pixel planes */
+	static int64 GetPixelPlaneBytes(const FCaptureData& Data);
+
+	/** Byte accounting of capture memory and the budget (shared with frames and writer tasks) */
+	TSharedRef<FCaptureMemoryTracker, ESPMode::ThreadSafe> MemoryTracker = MakeShared<FCaptureMemoryTracker, ESPMode::ThreadSafe>();
+	ECaptureMemoryOverflowPolicy						   MemoryOverflowPolicy = ECaptureMemoryOverflowPolicy::SkipKick;
+
+	/** Worst-case CPU memory of one capture of Record: pixel planes, plus EXR staging and
+	 *  queued copies when serialization is on (bytes)
+	 *  @param OutPlaneBytes - The pixel planes alone (what the readbacks will be copied into) */
+	int64 EstimateCaptureBytes(const FCaptureKickRecord& Record, int64& OutPlaneBytes) const;
+
+	/** Block until a capture of every camera in the kick list would fit the budget, harvesting
+	 *  readbacks and letting the writer drain (Block policy, offline and explicit captures).
+	 *  Returns false at once if the memory those stages hold could not cover the deficit (e.g.
+	 *  listeners are holding the frames), or if it still did not fit after PipelineWaitTimeoutSeconds. */
+	bool WaitForCaptureMemory();
+
+	/** Reserve a capture's memory, applying the overflow policy if it does not fit. Null if the
+	 *  capture should be skipped; bMustCapture captures always get a reservation. */
+	FCaptureMemoryTracker::FReservationPtr ReserveCaptureMemory(int64 Bytes, bool bMustCapture);
+
+	/** Drop the oldest capture still waiting on its readback (DropOldest policy) */
+	bool DropOldestPendingCapture();
+
+	/** Frame set views dropped for memory during a kick, resolved once the kick loop is done */
+	TArray<int64> FrameSetViewsDroppedOverBudget;
+
+	/** Whether captures harvested on the game thread are copied out with ParallelFor */
+	bool bParallelHarvest = true;
+
+	/** Claim every ready capture the game thread is responsible for and hand them to the
+	 *  render thread to map; their pixels are copied by one task fanned out across worker
+	 *  threads, and emitted by a later pass once bHarvested is published. */
+	void HarvestClaimableReadbacks();
+
+	/** In-flight captures of one camera, oldest first. Readbacks of one camera complete in
+	 *  kick order, so only the head is polled and frames are emitted in order. */
+	struct FPendingCaptureQueue
+	{
+		TDeque<FPendingCameraCapture> Captures;
+		bool						  bOrphaned = false; // Camera unregistered; freed once drained
+	};
+
+	/** Per-camera queues of pending captures awaiting GPU completion */
+	TSparseArray<FPendingCaptureQueue> PendingQueues;
+
+	/** Captures across all queues */
+	int32 PendingCaptureCount = 0;
+
+	/** Append a kicked capture to its camera's queue */
+	FPendingCameraCapture& EnqueuePendingCapture(FRegisteredCamera& Entry, FPendingCameraCapture&& Pending);
+
+	/** Harvest (or drop on timeout) the ready captures at the head of the queue in slot
+	 *  QueueIndex. Takes the slot rather than the queue: listeners notified in between may
+	 *  kick captures that add queues and reallocate PendingQueues. */
+	void HarvestPendingQueue(int32 QueueIndex, double Now);
+
+	/** Wall-clock time a readback may take before the capture is discarded (milliseconds) */
+	float ReadbackTimeoutMs = 500.0f;
+
+	/** Whether StopCapture drains pending readbacks */
+	bool bWaitForReadbacksOnStop = false;
+
+	/** Set while DrainPendingReadbacks runs (suppresses timeouts) */
+	bool bDrainingReadbacks = false;
+
+	/** Captures dropped on readback timeout this session */
+	int64 TotalFramesDropped = 0;
+
+	/** Running average kick-to-ready latency across all cameras (milliseconds) */
+	float AverageReadbackLatencyMs = 0.0f;
+
+	// ============================================================================
+	// Pipeline Statistics
+	// ============================================================================
+
+	/** Debug draw registration of the overlay (valid while it is shown) */
+	FDelegateHandle DebugHudHandle;
+
+	/** Statistics the overlay draws, refreshed every DebugHudRefreshSeconds rather than per frame */
+	FCaptureStatistics DebugHudStatistics;
+	double			   DebugHudRefreshTime = 0.0;
+
+	static constexpr double DebugHudRefreshSeconds = 0.25;
+
+	/** Draw the performance overlay (UDebugDrawService, "Game" show flag) */
+	void DrawDebugHud(UCanvas* Canvas, APlayerController* PlayerController);
+
+	/** Metrics file writer (valid while export is enabled). Shared with its worker task. */
+	TSharedPtr<FCaptureMetricsExporter, ESPMode::ThreadSafe> MetricsExporter;
+	float													 MetricsExportIntervalSeconds = 15.0f;
+	double													 NextMetricsExportTime = 0.0;
+
+	/** Subsystem of the world that exports -CameraCaptureMetricsFile (one per process) */
+	static TWeakObjectPtr<UCameraCaptureSubsystem> CommandLineMetricsOwner;
+
+	/** -CameraCaptureMetricsFile export (empty if not given or owned by another world), and whether it is the one running */
+	FString CommandLineMetricsFile;
+	float	CommandLineMetricsInterval = 15.0f;
+	bool	bMetricsExportFromCommandLine = false;
+
+	/** Whether capture sessions record a Chrome trace timeline */
+	bool	bTimelineRecording = false;
+	FString TimelineFilePath;
+
+	/** Trace file being written after StopCapture (waits for the writer backlog first) */
+	TFuture<void> TimelineWrite;
+
+	/** Longest the trace write waits for frames already handed to the writer (seconds) */
+	static constexpr double TimelineDrainTimeoutSeconds = 30.0;
+
+	/** Start recording the timeline, once the previous session's trace has been written */
+	void BeginTimelineRecording();
+
+	/** Stop recording and write the trace in the background */
+	void FinishTimelineRecording();
+
+	/** GetStatistics, optionally without the latency percentiles (which scan every histogram) */
+	FCaptureStatistics BuildStatistics(bool bLatencyPercentiles) const;
+
+	/** Stage latencies and write counters of all cameras (shared with serializer threads) */
+	TSharedRef<FCapturePipelineCounters, ESPMode::ThreadSafe> SessionCounters = MakeShared<FCapturePipelineCounters, ESPMode::ThreadSafe>();
+
+	/** FPlatformTime::Seconds() of the last ResetStatistics */
+	double StatisticsResetTime = 0.0;
+
+	/** High-water marks of the pipeline queues this session */
+	int32 MaxPendingCaptureCount = 0;
+	int32 PeakSerializationBacklog = 0; // Not MaxSerializationBacklog, which is the throttle limit
+
+	/** Record the stage latencies of a capture handed to listeners */
+	void RecordHarvestLatencies(const FPendingCameraCapture& Pending, double EmitTime);
+
+	static FCaptureLatencyPercentiles MakePercentiles(const FCaptureLatencyHistogram& Histogram);
+
+	// ============================================================================
+	// Frame Sets
+	// ============================================================================
+
+	/** A frame set being assembled */
+	struct FPendingFrameSet
+	{
+		TSharedRef<FCaptureFrameSet> FrameSet = MakeShared<FCaptureFrameSet>();
+		int32						 ResolvedCount = 0; // Views harvested or dropped
+		double						 FirstKickTime = 0.0;
+	};
+
+	/** Count a kicked capture towards its frame set */
+	void AddExpectedFrameSetView(const FCaptureData& Metadata);
+
+	/** Add a harvested view (null if its capture was dropped); finalizes the set once every
+	 *  view resolved. Returns false if the capture belongs to no set being assembled. */
+	bool ResolveFrameSetView(int64 FrameNumber, const TSharedPtr<const FCaptureData>& Data);
+
+	/** Emit or discard a frame set per FrameSetPolicy */
+	void FinalizeFrameSet(FPendingFrameSet& Pending);
+
+	/** Finalize sets older than FrameSetTimeoutMs (all sets if bAll) */
+	void FlushFrameSets(bool bAll);
+
+	/** Frame sets being assembled, by frame number */
+	TMap<int64, FPendingFrameSet> PendingFrameSets;
+
+	/** Frame set settings */
+	bool				   bAssembleFrameSets = false;
+	ECaptureFrameSetPolicy FrameSetPolicy = ECaptureFrameSetPolicy::EmitPartial;
+	float				   FrameSetTimeoutMs = 1000.0f;
+	bool				   bBatchFrameSetSerialization = false;
+
+	/** Frame sets finalized this session */
+	int64 FrameSetsCompleted = 0;
+	int64 FrameSetsIncomplete = 0;
+
+	/** Fold a harvested or dropped capture into its camera's readback counters */
+	void RecordReadbackOutcome(const FPendingCameraCapture& Pending, double LatencyMs, bool bDropped);
+
+	/** Extract pixel data from a mapped RGB readback (any thread) */
+	static void HarvestRgbReadback(const FPendingReadback& Readback, TArray<FColor>& OutImageData);
+
+	/** Extract depth and motion vectors from a mapped DMV readback (any thread) */
+	static void HarvestDmvReadback(const FPendingReadback& Readback, TArray<float>& OutDepthData, TArray<FVector2D>& OutMotionVectorData);
+
+private:
+	/** Registered cameras. Slots are stable (handles index them) and freed slots are reused. */
+	TSparseArray<FRegisteredCamera> CameraRegistry;
+
+	/** Registry slot of each camera (O(1) membership) */
+	TMap<FObjectKey, int32> CameraIndices;
+
+	/** Registry slot of each unique ID (O(1) collision checks and lookup by ID) */
+	TMap<FString, int32> UniqueIDIndices;
+
+	/** Number of registered cameras using each (possibly disambiguated) actor name */
+	TMap<FString, int32> ActorNameRefCounts;
+
+	/** Disambiguation state of a base actor name, kept while a camera uses one of its suffixes */
+	struct FActorNameSuffixes
+	{
+		int32 NextSuffix = 1; // Next suffix to try
+		int32 NumInUse = 0; // Registered cameras using a disambiguated form of the name
+	};
+	TMap<FString, FActorNameSuffixes> ActorNameSuffixes;
+
+	/** Serial given to the next registration (0 is never used) */
+	uint32 NextCameraSerial = 1;
 
 	/** Is capture currently active */
 	bool bIsCapturing = false;
@@ -348,6 +1804,44 @@ private:
 	/** Capture every N frames (1 = every frame) */
 	int32 CaptureEveryNFrames = 1;
 
+	/** Pending GPU readbacks allowed per registered camera before throttling */
+	int32 MaxInFlightFramesPerCamera = 3;
+
+	/** Frames allowed to wait on the serializer before throttling */
+	int32 MaxSerializationBacklog = 64;
+
+	/** Number of priority classes throttled during the last kick */
+	int32 ThrottledPriorityClasses = 0;
+
+	/** GPU timers awaiting resolution on the render thread */
+	TArray<FOutstandingGpuTimer> OutstandingGpuTimers;
+
+	/** Timestamp queries shared by all GPU timers (created with the first timer) */
+	FRenderQueryPoolRHIRef GpuTimerQueryPool;
+
+	/** Whether a discarded GPU timer has been reported this session */
+	bool bLoggedUnresolvedGpuTimer = false;
+
+	/** Whether the GPU governor is active */
+	bool bGpuGovernorEnabled = false;
+
+	/** Frame time the governor tries to hold (milliseconds) */
+	float GovernorTargetFrameTimeMs = 33.3f;
+
+	/** Frame time measured at the last governor update (milliseconds) */
+	float GovernorFrameTimeMs = 0.0f;
+
+	/** Capture time of the last governor adjustment */
+	double LastGovernorUpdateTime = 0.0;
+
+	/** Frames currently queued on (or being written by) the background serializer.
+	 *  Shared so in-flight write tasks can decrement it after the subsystem is gone. */
+	TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> SerializationBacklog = MakeShared<FThreadSafeCounter, ESPMode::ThreadSafe>();
+
+	/** Write recorders that will still add a span to the timeline. Unlike SerializationBacklog it
+	 *  only drops once a frame's last file is on disk, so the timeline waits for the spans. */
+	TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> PendingTimelineWrites = MakeShared<FThreadSafeCounter, ESPMode::ThreadSafe>();
+
 	/** Current frame counter */
 	int32 CurrentFrameCounter = 0;
 
@@ -360,6 +1854,60 @@ private:
 	/** Time when capture started */
 	double CaptureStartTime = 0.0;
 
+	/** World time when capture started (offline mode time base) */
+	double SimulationStartTime = 0.0;
+
+	/** Offline (fixed-step) mode settings */
+	bool  bOfflineMode = false;
+	float OfflineFixedDeltaSeconds = 1.0f / 30.0f;
+	int32 OfflineMaxQueuedFrames = 16;
+	int32 OfflineRandomSeed = 0;
+
+	/** Engine timing settings saved while offline timing is applied */
+	bool   bEngineTimingOverridden = false;
+	bool   bSavedUseFixedTimeStep = false;
+	double SavedFixedDeltaTime = 0.0;
+	bool   bSavedSmoothFrameRate = false;
+	bool   bSavedUseFixedFrameRate = false;
+	float  SavedMaxFPS = 0.0f;
+	int32  SavedVSync = 0;
+	uint32 SavedVSyncSetBy = 0; // ECVF_SetByMask bits of r.VSync before it was overridden
+	bool   bVSyncOverridden = false;
+
+	/** Pose-only recording settings */
+	bool	bPoseRecording = false;
+	FString TrajectoryFilePath;
+
+	/** Trajectory being written while capturing with pose recording enabled */
+	TUniquePtr<FCaptureTrajectoryWriter> TrajectoryWriter;
+
+	/** Last recorded transform of each movable actor (actor poses are written as deltas) */
+	TMap<TWeakObjectPtr<AActor>, FTransform> LastRecordedActorTransforms;
+
+	/** Last recorded component-space bone transforms of each skeletal mesh (also written as deltas) */
+	TMap<TWeakObjectPtr<USkeletalMeshComponent>, TArray<FTransform>> LastRecordedBoneTransforms;
+
+	/** Shard of the work handled by this process */
+	int32			  ShardIndex = 0;
+	int32			  ShardCount = 1;
+	ECaptureShardMode ShardMode = ECaptureShardMode::Cameras;
+
+	/** Whether a shard was configured (enables the shard manifest) */
+	bool bShardConfigured = false;
+
+	/** A frame handed to the serializer, recorded for the shard manifest */
+	struct FShardManifestEntry
+	{
+		FString CameraID;
+		FString CameraDirectory; // Relative to the output directory
+		int64	FrameNumber = 0;
+		double	Timestamp = 0.0;
+		bool	bUnchanged = false;
+	};
+
+	/** Frames serialized since the last manifest was written */
+	TArray<FShardManifestEntry> ShardManifestEntries;
+
 	/** Output directory for captured data */
 	FString OutputDirectory;
 
@@ -371,6 +1919,9 @@ private:
 	/** Whether to automatically serialize captured data to disk */
 	bool bSerializationEnabled = true;
 
+	/** Whether captures borrow pooled render targets instead of owning them */
+	bool bPoolRenderTargets = false;
+
 	/** Last capture duration (for statistics) */
 	float LastCaptureDurationMs = 0.0f;
 
@@ -381,6 +1932,10 @@ private:
 	UPROPERTY()
 	UMaterial* DmvCaptureMaterialBase = nullptr;
 
+	/** Every render target owned by the pool, borrowed or free */
+	UPROPERTY()
+	TArray<UTextureRenderTarget2D*> PooledRenderTargets;
+
 	/** Map of cameras to their depth+motion render targets */
 	TMap<TWeakObjectPtr<UIntrinsicSceneCaptureComponent2D>, TWeakObjectPtr<UTextureRenderTarget2D>> DmvRenderTargets;
 
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+struct FCaptureData;
+
+/**
+ * Thread-safe, size-classed pool of pixel planes (RGB, depth, motion vectors).
+ *
+ * Harvested frames take their planes from the pool and the last reference to the
+ * frame (often on a serializer thread) gives them back, so the multi-megabyte
+ * allocations are reused rather than going through malloc/free at frame rate.
+ * Planes are grouped by size rounded up to SizeClassBytes; idle planes above
+ * MaxPooledBytes (the high-water mark) are freed instead of kept.
+ */
+class CAMERACAPTURE_API FCaptureBufferPool
+{
+public:
+	/** Plane sizes are rounded up to a multiple of this to form size classes. Large enough
+	 *  that allocator quantization never moves a plane into the next class. */
+	static constexpr int64 SizeClassBytes = 64 * 1024;
+
+	struct FStats
+	{
+		int64 PooledBytes = 0;		 // Idle planes held by the pool
+		int64 PeakPooledBytes = 0;	 // High-water mark of PooledBytes
+		int64 OutstandingBytes = 0;	 // Planes handed out and not yet returned
+		int64 PeakOutstandingBytes = 0;
+		int64 Hits = 0;				 // Acquires served from an idle plane
+		int64 Misses = 0;			 // Acquires that had to allocate
+		int64 Discards = 0;			 // Returned planes freed because the pool was full
+	};
+
+	/** Size Out for Num elements, reusing an idle plane of the same size class if there is one */
+	void Acquire(TArray<FColor>& Out, int32 Num);
+	void Acquire(TArray<float>& Out, int32 Num);
+	void Acquire(TArray<FVector2D>& Out, int32 Num);
+
+	/** Return the pixel planes of a frame that is being destroyed */
+	void Release(FCaptureData& Data);
+
+	/** Return planes that never made it into a frame (e.g. a dropped capture's) */
+	void Release(TArray<FColor>& ImageData, TArray<float>& DepthData, TArray<FVector2D>& MotionVectorData);
+
+	/** Set the most idle memory the pool may hold (bytes); trims immediately if lower */
+	void SetMaxPooledBytes(int64 InMaxPooledBytes);
+
+	/** Free every idle plane */
+	void Empty();
+
+	FStats GetStats() const;
+
+private:
+	/** Idle planes keyed by size class in bytes */
+	template <typename ElementType>
+	using TFreeList = TMap<int64, TArray<TArray<ElementType>>>;
+
+	template <typename ElementType>
+	void AcquireImpl(TFreeList<ElementType>& FreeList, TArray<ElementType>& Out, int32 Num);
+
+	template <typename ElementType>
+	void ReleaseImpl(TFreeList<ElementType>& FreeList, TArray<ElementType>& Plane);
+
+	/** Free idle planes until PooledBytes fits MaxPooledBytes (lock held) */
+	void TrimToBudget();
+
+	template <typename ElementType>
+	static int64 GetPlaneBytes(const TArray<ElementType>& Plane) { return static_cast<int64>(Plane.Max()) * sizeof(ElementType); }
+
+	mutable FCriticalSection Mutex;
+
+	TFreeList<FColor>	  FreeImagePlanes;
+	TFreeList<float>	  FreeDepthPlanes;
+	TFreeList<FVector2D> FreeMotionPlanes;
+
+	int64  MaxPooledBytes = 512ll * 1024 * 1024;
+	FStats Stats;
+};
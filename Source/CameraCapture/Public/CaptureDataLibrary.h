@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "CameraCaptureSubsystem.h"
+#include "CaptureDataLibrary.generated.h"
+
+/**
+ * Blueprint access to the per-camera metadata of a capture. FCaptureData shares
+ * this metadata across frames (FCaptureCameraInfo), so it is read through these
+ * accessors rather than through struct properties.
+ */
+UCLASS()
+class CAMERACAPTURE_API UCaptureDataLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** Camera identifier */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture|Capture Data")
+	static FCameraIdentifier GetCameraID(const FCaptureData& Data);
+
+	/** Camera intrinsics used for the capture */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture|Capture Data")
+	static FCameraIntrinsics GetIntrinsics(const FCaptureData& Data);
+
+	/** Whether a custom projection matrix was used */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture|Capture Data")
+	static bool UsedCustomProjectionMatrix(const FCaptureData& Data);
+
+	/** Path of the camera's actor in the world */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture|Capture Data")
+	static FString GetActorPath(const FCaptureData& Data);
+
+	/** Name of the level the camera was captured in */
+	UFUNCTION(BlueprintPure, Category = "Camera Capture|Capture Data")
+	static FString GetLevelName(const FCaptureData& Data);
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Lock-free latency histogram with HDR-style log-linear buckets.
+ *
+ * Values are recorded in microseconds. The first 32 buckets are 1 us wide; above that
+ * every power of two is split into 16 buckets, so any reported value is within ~6% of
+ * the recorded one, from 1 us up to MaxValueUs (~67 s; larger values are clamped).
+ * That is 368 buckets (~3 KB), small enough to keep three per camera. Record() may be
+ * called from any thread; readers see a consistent-enough snapshot for stats.
+ */
+class CAMERACAPTURE_API FCaptureLatencyHistogram
+{
+public:
+	static constexpr int32	LinearBuckets = 32;
+	static constexpr int32	SubBuckets = 16;
+	static constexpr int32	Magnitudes = 21;
+	static constexpr int32	NumBuckets = LinearBuckets + Magnitudes * SubBuckets;
+	static constexpr uint64 MaxValueUs = (uint64(2 * SubBuckets) << Magnitudes) - 1;
+
+	FCaptureLatencyHistogram() { Reset(); }
+
+	/** Add one sample (milliseconds) */
+	void Record(double ValueMs);
+
+	/** Value at or below which Percentile (0-100) of the samples fall (milliseconds) */
+	double GetPercentileMs(double Percentile) const;
+
+	double GetMeanMs() const;
+	double GetSumMs() const { return SumUs.load(std::memory_order_relaxed) / 1000.0; }
+	double GetMaxMs() const { return MaxUs.load(std::memory_order_relaxed) / 1000.0; }
+	int64  GetCount() const { return static_cast<int64>(Count.load(std::memory_order_relaxed)); }
+
+	/**
+	 * Cumulative sample counts for exposition as a Prometheus histogram. OutCounts[i] is the
+	 * number of samples in buckets that lie entirely at or below UpperBoundsMs[i] (ascending),
+	 * so a sample within ~6% of a bound may be counted in the next one. OutTotal is the sum
+	 * over all buckets, which stays consistent with OutCounts while samples are being added.
+	 */
+	void GetCumulativeCounts(TConstArrayView<double> UpperBoundsMs, TArray<uint64>& OutCounts, uint64& OutTotal) const;
+
+	void Reset();
+
+private:
+	static int32  GetBucketIndex(uint64 ValueUs);
+	static uint64 GetBucketUpperBoundUs(int32 Index);
+
+	std::atomic<uint64> Buckets[NumBuckets];
+	std::atomic<uint64> Count;
+	std::atomic<uint64> SumUs;
+	std::atomic<uint64> MaxUs;
+};
+
+/**
+ * Lock-free counters and stage latencies for one camera (or the whole session).
+ * Shared with serializer threads, which record write completion.
+ */
+struct CAMERACAPTURE_API FCapturePipelineCounters
+{
+	/** Kick until both readbacks were seen ready */
+	FCaptureLatencyHistogram KickToReady;
+
+	/** Readback ready until the frame was handed to listeners (pixel copy + wait for the game thread) */
+	FCaptureLatencyHistogram ReadyToHarvest;
+
+	/** Frame handed to the serializer until all of its files were on disk */
+	FCaptureLatencyHistogram HarvestToWritten;
+
+	std::atomic<int64> FramesWritten { 0 };
+	std::atomic<int64> BytesWritten { 0 };
+	std::atomic<int64> WriteFailures { 0 };
+
+	/** Record the outcome of one frame's files */
+	void RecordWrite(bool bSucceeded, int64 Bytes, double LatencyMs);
+
+	void Reset();
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/** Where capture memory is held */
+enum class ECaptureMemoryStage : uint8
+{
+	Readback,		// Kicked captures: pixel planes their readbacks will need (not yet allocated)
+	AwaitingEmit,	// Pixels copied out of the readbacks, waiting for the game thread
+	Frames,			// Planes of frames held by listeners, frame sets and the writer
+	QueuedForWrite, // Of Frames: planes of frames waiting on or being written by the serializer
+	Encoding,		// EXR staging arrays and ImageWriteQueue copies
+
+	Num
+};
+
+/**
+ * Byte accounting of the CPU memory captures hold, stage by stage, plus the budget.
+ *
+ * Every capture reserves its worst-case footprint (pixel planes plus encode copies)
+ * before it is kicked and keeps the reservation until the last of its memory is
+ * released, so admission against the budget happens before memory is allocated
+ * rather than after. Stage counters report where the bytes actually are. All
+ * methods may be called from any thread.
+ */
+class CAMERACAPTURE_API FCaptureMemoryTracker : public TSharedFromThis<FCaptureMemoryTracker, ESPMode::ThreadSafe>
+{
+public:
+	/** Bytes held against the budget; released when the last reference goes away */
+	class FReservation
+	{
+	public:
+		FReservation(const TSharedRef<FCaptureMemoryTracker, ESPMode::ThreadSafe>& InTracker, int64 InBytes);
+		~FReservation();
+
+		FCaptureMemoryTracker& GetTracker() const { return *Tracker; }
+		int64				   GetBytes() const { return Bytes; }
+
+	private:
+		TSharedRef<FCaptureMemoryTracker, ESPMode::ThreadSafe> Tracker;
+		int64												   Bytes;
+	};
+
+	using FReservationPtr = TSharedPtr<FReservation, ESPMode::ThreadSafe>;
+
+	/** Most bytes reservations may hold (0 = unlimited) */
+	void  SetBudgetBytes(int64 InBudgetBytes) { BudgetBytes.store(FMath::Max<int64>(InBudgetBytes, 0), std::memory_order_relaxed); }
+	int64 GetBudgetBytes() const { return BudgetBytes.load(std::memory_order_relaxed); }
+
+	/** Reserve Bytes if that keeps the total within the budget; null otherwise */
+	FReservationPtr TryReserve(int64 Bytes);
+
+	/** Reserve Bytes regardless of the budget (captures that must not be skipped), counting any overrun */
+	FReservationPtr ForceReserve(int64 Bytes);
+
+	/** Whether Bytes would fit right now (for waiting until they do) */
+	bool WouldFit(int64 Bytes) const;
+
+	void  AddStageBytes(ECaptureMemoryStage Stage, int64 Delta) { StageBytes[static_cast<int32>(Stage)].fetch_add(Delta, std::memory_order_relaxed); }
+	int64 GetStageBytes(ECaptureMemoryStage Stage) const { return StageBytes[static_cast<int32>(Stage)].load(std::memory_order_relaxed); }
+
+	int64 GetReservedBytes() const { return ReservedBytes.load(std::memory_order_relaxed); }
+	int64 GetPeakReservedBytes() const { return PeakReservedBytes.load(std::memory_order_relaxed); }
+	int64 GetBudgetOverruns() const { return BudgetOverruns.load(std::memory_order_relaxed); }
+
+	/** Restart the peak and overrun counters (outstanding bytes are left alone) */
+	void ResetPeaks();
+
+private:
+	void Release(int64 Bytes) { ReservedBytes.fetch_sub(Bytes, std::memory_order_relaxed); }
+	void UpdatePeak(int64 Reserved);
+
+	std::atomic<int64> BudgetBytes { 0 };
+	std::atomic<int64> ReservedBytes { 0 };
+	std::atomic<int64> PeakReservedBytes { 0 };
+	std::atomic<int64> BudgetOverruns { 0 };
+	std::atomic<int64> StageBytes[static_cast<int32>(ECaptureMemoryStage::Num)] = {};
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Misc/StringBuilder.h"
+#include "CameraCaptureSubsystem.h"
+
+/**
+ * Writes capture telemetry as a Prometheus text-format file for the node-exporter
+ * textfile collector (or anything else that scrapes the same format).
+ *
+ * The game thread hands over a snapshot of the counters; formatting and the write
+ * happen on a thread-pool task into a buffer that is reused between exports. The
+ * file is written next to its final path and renamed over it, so a scrape never
+ * sees a partial file. At most one export is in flight; while one is, new snapshots
+ * are skipped rather than queued.
+ */
+class CAMERACAPTURE_API FCaptureMetricsExporter : public TSharedFromThis<FCaptureMetricsExporter, ESPMode::ThreadSafe>
+{
+public:
+	struct FSnapshot
+	{
+		/** Scalars only; latency percentiles are not filled in (the histograms are read directly) */
+		FCaptureStatistics Stats;
+
+		/** Stage latencies of the whole session */
+		TSharedPtr<FCapturePipelineCounters, ESPMode::ThreadSafe> SessionCounters;
+
+		/** Stage latencies of each camera, parallel to Stats.PerCamera (null if it went away) */
+		TArray<TSharedPtr<FCapturePipelineCounters, ESPMode::ThreadSafe>> CameraCounters;
+	};
+
+	/** Histogram bucket bounds shared by every latency metric (seconds) */
+	static const double LatencyBucketSeconds[13];
+
+	explicit FCaptureMetricsExporter(const FString& InFilePath);
+
+	const FString& GetFilePath() const { return FilePath; }
+
+	/** Format and write Snapshot on a worker thread. Returns false (and drops the
+	 *  snapshot) if the previous export has not finished. Game thread only. */
+	bool ExportAsync(FSnapshot&& Snapshot);
+
+	/** Block until the export in flight (if any) has been written. Game thread only. */
+	void Wait();
+
+	/** Append Snapshot in Prometheus text exposition format (UTF-8) */
+	static void FormatMetrics(const FSnapshot& Snapshot, FAnsiStringBuilderBase& Out);
+
+private:
+	/** Format into Buffer and replace the file (worker thread) */
+	void Export(const FSnapshot& Snapshot);
+
+	FString FilePath;
+
+	/** Reused by every export; only the single in-flight task touches it */
+	TAnsiStringBuilder<16 * 1024> Buffer;
+
+	TFuture<void> PendingExport;
+
+	/** Whether the last export failed, so a broken path is reported once rather than every interval */
+	bool bLastExportFailed = false;
+};
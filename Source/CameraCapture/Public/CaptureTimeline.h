@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/**
+ * Opt-in recorder of pipeline stage spans, written as Chrome Trace Event JSON
+ * (open in Perfetto or chrome://tracing) for offline analysis without Insights.
+ *
+ * Every CAMERA_CAPTURE_SCOPE becomes a span on the thread that ran it, tagged with
+ * the camera and frame. GPU readbacks (kick until ready) and file writes (handoff
+ * until on disk) become async spans per camera, so their overlap with the CPU
+ * stages is visible. Events go into per-thread chunked buffers: appending is one
+ * store and one release increment; only a thread's first event of a recording
+ * takes a lock (to register its buffer).
+ */
+class CAMERACAPTURE_API FCaptureTimeline
+{
+public:
+	/** Where a span is drawn */
+	enum class ETrack : uint8
+	{
+		Thread,	  // On the recording thread, nested like a call stack
+		Readback, // Async track "Readback <CameraID>"
+		Write,	  // Async track "Write <CameraID>"
+	};
+
+	/** Discard any previous recording and start a new one. Events past MaxEvents are dropped. */
+	static void Start(int64 MaxEvents = 4 * 1024 * 1024);
+
+	static bool IsRecording() { return bRecording.load(std::memory_order_relaxed); }
+
+	/** Add a finished span (FPlatformTime::Seconds() bounds). Stage must be a string literal. */
+	static void Record(const TCHAR* Stage, FName CameraID, int64 FrameNumber, double BeginSeconds, double EndSeconds, ETrack Track = ETrack::Thread);
+
+	/** Stop recording and write everything recorded as Chrome Trace Event JSON */
+	static bool StopAndWrite(const FString& FilePath);
+
+private:
+	struct FEvent
+	{
+		const TCHAR* Stage;
+		FName		 CameraID;
+		int64		 FrameNumber;
+		double		 BeginSeconds;
+		double		 EndSeconds;
+		ETrack		 Track;
+	};
+
+	/** Fixed-size block of events; only the owning thread appends, readers see the first Num */
+	struct FChunk
+	{
+		static constexpr int32 Capacity = 4096;
+
+		FEvent				 Events[Capacity];
+		std::atomic<int32>	 Num { 0 };
+		std::atomic<FChunk*> Next { nullptr };
+	};
+
+	/** One thread's events for one recording */
+	struct FThreadBuffer
+	{
+		uint32 ThreadId = 0;
+		FChunk Head;
+		FChunk* Tail = &Head; // Owning thread only
+
+		~FThreadBuffer();
+	};
+
+	/** This thread's buffer for the current recording, registering a new one if needed */
+	static FThreadBuffer* GetThreadBuffer();
+
+	static std::atomic<bool>   bRecording;
+	static std::atomic<uint32> Generation;
+	static std::atomic<int64>  NumEvents;
+	static std::atomic<int64>  NumDropped;
+	static std::atomic<int64>  MaxEvents;
+	static double			   StartSeconds; // Game thread
+
+	/** Buffers of the current recording (guarded by BuffersMutex). Threads hold their own
+	 *  reference too, so a late event never writes into a freed buffer. */
+	static TArray<TSharedPtr<FThreadBuffer, ESPMode::ThreadSafe>> Buffers;
+	static FCriticalSection										   BuffersMutex;
+};
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CameraIntrinsics.h"
+
+class FArchive;
+
+/**
+ * A single camera or actor pose within a trajectory frame
+ */
+struct CAMERACAPTURE_API FCaptureTrajectoryPose
+{
+	/** Index into FCaptureTrajectory::CameraIDs or FCaptureTrajectory::ActorPaths */
+	int32 Index = INDEX_NONE;
+
+	/** World transform */
+	FTransform Transform;
+};
+
+/**
+ * Bone pose of a skeletal mesh within a trajectory frame
+ */
+struct CAMERACAPTURE_API FCaptureTrajectorySkeletalPose
+{
+	/** Index into FCaptureTrajectory::SkeletalMeshPaths */
+	int32 Index = INDEX_NONE;
+
+	/** Component-space transform of every bone, in the mesh's bone order */
+	TArray<FTransform> BoneTransforms;
+};
+
+/**
+ * Poses recorded for one capture frame
+ */
+struct CAMERACAPTURE_API FCaptureTrajectoryFrame
+{
+	/** Frame number the live run assigned to this capture */
+	int64 FrameNumber = 0;
+
+	/** Timestamp (seconds since capture start) */
+	double Timestamp = 0.0;
+
+	/** World transform of every camera that was due this frame */
+	TArray<FCaptureTrajectoryPose> CameraPoses;
+
+	/** World transform of every movable actor that moved since the previous frame
+	 *  (the full state is obtained by replaying frames in order) */
+	TArray<FCaptureTrajectoryPose> ActorPoses;
+
+	/** Bone poses of every skeletal mesh whose pose changed since the previous frame */
+	TArray<FCaptureTrajectorySkeletalPose> SkeletalPoses;
+};
+
+/**
+ * Compact binary trajectory of camera and moving-actor poses, recorded during a
+ * live run so the captures can be re-rendered offline.
+ *
+ * File layout (little endian):
+ *   uint32 Magic ('CCTJ'), uint32 Version
+ *   then a stream of records, each starting with a uint8 record type:
+ *     CameraDef: FString UniqueID
+ *     ActorDef:  FString ActorPath (PIE prefix stripped)
+ *     SkeletalMeshDef: FString ComponentPath (PIE prefix stripped)
+ *     Frame:     int64 FrameNumber, double Timestamp,
+ *                int32 NumCameraPoses, { int32 Index, Pose }...,
+ *                int32 NumActorPoses,  { int32 Index, Pose }...,
+ *                int32 NumSkeletalPoses, { int32 Index, int32 NumBones, Pose... }... (version 2+)
+ *   Pose = double X, Y, Z, float QX, QY, QZ, QW, float SX, SY, SZ (52 bytes)
+ * Definitions always precede the first frame that references them.
+ */
+struct CAMERACAPTURE_API FCaptureTrajectory
+{
+	/** Camera unique IDs (FCameraIdentifier::UniqueID), indexed by pose Index */
+	TArray<FString> CameraIDs;
+
+	/** Actor paths without PIE prefix, indexed by pose Index */
+	TArray<FString> ActorPaths;
+
+	/** Skeletal mesh component paths without PIE prefix, indexed by skeletal pose Index */
+	TArray<FString> SkeletalMeshPaths;
+
+	/** Frames in recording order */
+	TArray<FCaptureTrajectoryFrame> Frames;
+
+	/** Load a trajectory file written by FCaptureTrajectoryWriter */
+	bool LoadFromFile(const FString& FilePath);
+
+	static constexpr uint32 Magic = 0x4A544343; // 'CCTJ'
+	static constexpr uint32 Version = 2;
+
+	/** Upper bound on bones per skeletal pose (guards against corrupt files) */
+	static constexpr int32 MaxBonesPerPose = 65536;
+
+	enum class ERecordType : uint8
+	{
+		CameraDef = 1,
+		ActorDef = 2,
+		Frame = 3,
+		SkeletalMeshDef = 4
+	};
+
+	/** Serialize a pose in the compact on-disk representation */
+	static void SerializePose(FArchive& Ar, FTransform& Transform);
+};
+
+/**
+ * Streams a trajectory to disk one frame at a time (game thread only)
+ */
+class CAMERACAPTURE_API FCaptureTrajectoryWriter
+{
+public:
+	~FCaptureTrajectoryWriter();
+
+	/** Create the file and write the header */
+	bool Open(const FString& FilePath);
+
+	/** Flush and close the file */
+	void Close();
+
+	/** Whether the writer has an open file */
+	bool IsOpen() const { return Archive.IsValid(); }
+
+	/** Start collecting poses for a frame */
+	void BeginFrame(int64 FrameNumber, double Timestamp);
+
+	/** Add a camera pose to the current frame */
+	void AddCameraPose(const FString& CameraID, const FTransform& Transform);
+
+	/** Add an actor pose to the current frame */
+	void AddActorPose(const FString& ActorPath, const FTransform& Transform);
+
+	/** Add the component-space bone transforms of a skeletal mesh to the current frame */
+	void AddSkeletalPose(const FString& ComponentPath, const TArray<FTransform>& BoneTransforms);
+
+	/** Write the current frame (no-op if it has no camera poses) */
+	void EndFrame();
+
+	/** Number of frames written so far */
+	int64 GetFramesWritten() const { return FramesWritten; }
+
+private:
+	/** Get the index of a camera/actor, writing its definition record on first use */
+	int32 FindOrAddDefinition(TMap<FString, int32>& Indices, const FString& Key, FCaptureTrajectory::ERecordType RecordType);
+
+	TUniquePtr<FArchive> Archive;
+
+	TMap<FString, int32> CameraIndices;
+	TMap<FString, int32> ActorIndices;
+	TMap<FString, int32> SkeletalMeshIndices;
+
+	FCaptureTrajectoryFrame CurrentFrame;
+	int64					FramesWritten = 0;
+};
+
+/**
+ * One entry of a pose list used for batch dataset generation
+ */
+struct CAMERACAPTURE_API FCapturePoseListEntry
+{
+	/** Camera unique ID to place; empty = teleport the rig actor and capture every registered camera */
+	FString CameraID;
+
+	/** World transform of the camera (or rig) */
+	FTransform Transform;
+
+	/** Timestamp written to the capture metadata (< 0 = derive from the pose index) */
+	double Timestamp = -1.0;
+
+	/** Intrinsics to apply before capturing (only if bHasIntrinsics) */
+	bool			  bHasIntrinsics = false;
+	FCameraIntrinsics Intrinsics;
+};
+
+/**
+ * List of poses to capture, loaded from CSV or JSON.
+ *
+ * CSV: a header row naming the columns, in any order:
+ *   camera, x, y, z, pitch, yaw, roll [, timestamp] [, fx, fy, cx, cy, width, height]
+ * JSON: { "poses": [ { "camera": "...", "location": [x, y, z], "rotation": [pitch, yaw, roll],
+ *                      "timestamp": t, "intrinsics": { "fx", "fy", "cx", "cy", "width", "height" } } ] }
+ * Locations are in cm and rotations in degrees (Unreal world space). Only the
+ * location and rotation are required.
+ */
+struct CAMERACAPTURE_API FCapturePoseList
+{
+	TArray<FCapturePoseListEntry> Poses;
+
+	/** Load a .csv or .json pose list */
+	bool LoadFromFile(const FString& FilePath);
+
+private:
+	bool LoadFromCsv(const FString& FilePath);
+	bool LoadFromJson(const FString& FilePath);
+};
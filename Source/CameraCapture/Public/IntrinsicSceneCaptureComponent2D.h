@@ -5,6 +5,31 @@
 #include "CameraIntrinsics.h"
 #include "IntrinsicSceneCaptureComponent2D.generated.h"
 
+/**
+ * Priority class used by UCameraCaptureSubsystem when it has to throttle captures.
+ * Under GPU or serialization pressure the lowest classes are skipped first.
+ */
+UENUM(BlueprintType)
+enum class ECameraCapturePriority : uint8
+{
+	/** First to be throttled (e.g., inspection or overview cameras) */
+	Low UMETA(DisplayName = "Low"),
+
+	/** Default priority */
+	Normal UMETA(DisplayName = "Normal"),
+
+	/** Only throttled under heavy pressure */
+	High UMETA(DisplayName = "High"),
+
+	/** Never throttled (e.g., navigation cameras feeding a controller) */
+	Critical UMETA(DisplayName = "Critical")
+};
+
+class UIntrinsicSceneCaptureComponent2D;
+
+/** Fired when a camera component is registered with / unregistered from a game world */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnIntrinsicCameraRegistrationChanged, UIntrinsicSceneCaptureComponent2D* /*Camera*/);
+
 /**
  * Scene capture component with support for custom camera intrinsics
  * Use this instead of base USceneCaptureComponent2D for precise camera calibration
@@ -71,6 +96,39 @@ public:
 		meta = (EditCondition = "bUseDepthSensorOffset", DisplayName = "Depth Sensor Offset"))
 	FTransform DepthSensorOffset = FTransform::Identity;
 
+	// ============================================================================
+	// Capture Scheduling (used by UCameraCaptureSubsystem)
+	// ============================================================================
+
+	/** Target capture rate for this camera in Hz. When 0, the camera is scheduled
+	 *  by CaptureEveryNFrames instead. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture Scheduling",
+		meta = (ClampMin = "0.0", Units = "Hz", DisplayName = "Capture Rate (Hz)"))
+	float CaptureRateHz = 0.0f;
+
+	/** Capture every N subsystem ticks (0 = use the subsystem's global rate).
+	 *  Only used when CaptureRateHz is 0. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture Scheduling",
+		meta = (ClampMin = "0", EditCondition = "CaptureRateHz <= 0", DisplayName = "Capture Every N Frames"))
+	int32 CaptureEveryNFrames = 0;
+
+	/** Priority class of this camera. Lower-priority cameras are throttled first
+	 *  when the subsystem is under GPU or serialization pressure. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture Scheduling", meta = (DisplayName = "Capture Priority"))
+	ECameraCapturePriority CapturePriority = ECameraCapturePriority::Normal;
+
+	/** Skip rendering and readback when nothing this camera can see has changed since
+	 *  its last capture (its transform, its intrinsics, and the movable actors inside
+	 *  its frustum). A metadata-only "unchanged" record referencing the last captured
+	 *  frame is emitted instead. Intended for statically mounted cameras. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture Scheduling", meta = (DisplayName = "Skip Unchanged Frames"))
+	bool bSkipUnchangedFrames = false;
+
+	/** Force a full capture after this many consecutive unchanged frames (0 = never force) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture Scheduling",
+		meta = (ClampMin = "0", EditCondition = "bSkipUnchangedFrames", DisplayName = "Max Consecutive Skipped Frames"))
+	int32 MaxConsecutiveSkippedFrames = 0;
+
 	// ============================================================================
 	// Intrinsics API
 	// ============================================================================
@@ -95,6 +153,24 @@ public:
 	/** Build a custom projection matrix from camera intrinsics (C++ only) */
 	static FMatrix BuildProjectionMatrixFromIntrinsics(const FCameraIntrinsics& Intrinsics);
 
+	/** Hash of everything that affects this camera's projection (active intrinsics,
+	 *  FOV and custom projection matrix). Cheap: does not copy the intrinsics. */
+	uint32 GetProjectionHash() const;
+
+	// ============================================================================
+	// Discovery
+	// ============================================================================
+
+	/** Broadcast whenever a camera in a game world registers (spawn, level streaming in, BeginPlay) */
+	static FOnIntrinsicCameraRegistrationChanged OnCameraRegistered;
+
+	/** Broadcast whenever a camera in a game world unregisters (destroy, level streaming out) */
+	static FOnIntrinsicCameraRegistrationChanged OnCameraUnregistered;
+
+	/** True for the depth/motion copies UCameraCaptureSubsystem creates internally;
+	 *  these are never registered for capture themselves */
+	bool bIsCaptureHelper = false;
+
 	/** Whether to draw the camera frustum for visualization */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug Visualization", meta = (DisplayName = "Draw Frustum In Game", ToolTip = "Enable to visualize the camera's field of view frustum in game"))
 	bool bDrawFrustumInGame = false;
@@ -131,14 +207,14 @@ protected:
 	virtual void BeginPlay() override;
 	virtual void BeginDestroy() override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
 
 	/** Draw the camera frustum for visualization */
 	void DrawCameraFrustum();
 
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
-	virtual void OnRegister() override;
-	virtual void OnUnregister() override;
 
 	/** Handle when any object property changes (used to detect asset changes) */
 	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
@@ -44,6 +44,8 @@ namespace CameraCaptureUtils
 	 * @param Width - Image width
 	 * @param Height - Image height
 	 * @param bIncludeDepth - If true, stores RGB+Depth (depth in alpha). If false, stores motion vectors (X in R, Y in G)
+	 * @param OnCompleted - Optional, called with the result once the queued write has finished, on the
+	 *                      ImageWriteQueue thread that wrote the file (not called if queuing fails)
 	 * @return true if write task was successfully queued
 	 */
 	bool WriteEXRFile(const FString& FilePath,
@@ -51,7 +53,8 @@ namespace CameraCaptureUtils
 		const TArray<FLinearColor>&	 DmvData,
 		int32						 Width,
 		int32						 Height,
-		bool						 bIncludeDepth);
+		bool						 bIncludeDepth,
+		TFunction<void(bool)>		 OnCompleted = nullptr);
 
 	/**
 	 * Write metadata JSON file with camera transform and intrinsics